@@ -38,6 +38,37 @@ LOCAL_MODULE := libuefi_cpu
 $(call common_defs)
 include $(BUILD_STATIC_LIBRARY)
 
+include $(CLEAR_VARS)
+LOCAL_EXPORT_C_INCLUDE_DIRS := $(LOCAL_PATH)/arena
+LOCAL_SRC_FILES := arena/arena.c
+LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_log libuefi_utils
+LOCAL_MODULE := libuefi_arena
+$(call common_defs)
+include $(BUILD_STATIC_LIBRARY)
+
+include $(CLEAR_VARS)
+LOCAL_EXPORT_C_INCLUDE_DIRS := $(LOCAL_PATH)/checkpoint
+LOCAL_SRC_FILES := checkpoint/checkpoint.c
+LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_cpu libuefi_time
+LOCAL_MODULE := libuefi_checkpoint
+$(call common_defs)
+include $(BUILD_STATIC_LIBRARY)
+
+include $(CLEAR_VARS)
+LOCAL_EXPORT_C_INCLUDE_DIRS := $(LOCAL_PATH)/crc32
+LOCAL_SRC_FILES := crc32/crc32.c
+LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_cpu
+LOCAL_MODULE := libuefi_crc32
+$(call common_defs)
+include $(BUILD_STATIC_LIBRARY)
+
+include $(CLEAR_VARS)
+LOCAL_EXPORT_C_INCLUDE_DIRS := $(LOCAL_PATH)/lz4
+LOCAL_SRC_FILES := lz4/lz4.c
+LOCAL_MODULE := libuefi_lz4
+$(call common_defs)
+include $(BUILD_STATIC_LIBRARY)
+
 include $(CLEAR_VARS)
 LOCAL_SRC_FILES := profiling_stub.c
 LOCAL_MODULE := libuefi_profiling_stub
@@ -55,7 +86,7 @@ LOCAL_SRC_FILES := gpt/gpt.c
 LOCAL_EXPORT_C_INCLUDE_DIRS := $(LOCAL_PATH)/gpt
 LOCAL_MODULE := libuefi_gpt
 LOCAL_CFLAGS := -finstrument-functions
-LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_log libuefi_utils
+LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_log libuefi_utils libuefi_crc32 libuefi_time
 $(call common_defs)
 include $(BUILD_STATIC_LIBRARY)
 
@@ -68,10 +99,10 @@ $(call common_defs)
 include $(BUILD_STATIC_LIBRARY)
 
 include $(CLEAR_VARS)
-LOCAL_SRC_FILES := bootimg/bootimg.c bootimg/check_signature.c
+LOCAL_SRC_FILES := bootimg/bootimg.c bootimg/check_signature.c bootimg/placement.c
 LOCAL_EXPORT_C_INCLUDE_DIRS := $(LOCAL_PATH)/bootimg
 LOCAL_MODULE := libuefi_bootimg
-LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_log libuefi_posix
+LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_log libuefi_posix libuefi_gpt libuefi_time libuefi_checkpoint libuefi_arena
 
 ifneq ($(BOARD_HAVE_LIMITED_POWERON_FEATURES),true)
 ifneq (,$(findstring isu,$(TARGET_OS_SIGNING_METHOD)))
@@ -82,14 +113,20 @@ LOCAL_CFLAGS := -DUSE_SHIM
 endif
 endif
 
+# Always exit boot services and jump to the kernel ourselves, even if
+# the kernel supports the EFI handover protocol
+ifeq ($(TARGET_UEFI_DISABLE_EFI_HANDOVER),true)
+LOCAL_CFLAGS += -DCONFIG_DISABLE_EFI_HANDOVER
+endif
+
 $(call common_defs)
 include $(BUILD_STATIC_LIBRARY)
 
 include $(CLEAR_VARS)
-LOCAL_SRC_FILES := posix/stdio.c posix/stdlib.c
+LOCAL_SRC_FILES := posix/stdio.c posix/stdlib.c posix/string.c
 LOCAL_EXPORT_C_INCLUDE_DIRS := $(LOCAL_PATH)/posix
 LOCAL_MODULE := libuefi_posix
 LOCAL_CFLAGS := -finstrument-functions
-LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_utils
+LOCAL_WHOLE_STATIC_LIBRARIES := libuefi_utils libuefi_cpu
 $(call common_defs)
 include $(BUILD_STATIC_LIBRARY)
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <efi.h>
+#include <efilib.h>
+#include <uefi_utils.h>
+#include <log.h>
+
+#include "arena.h"
+
+/* The pool only guarantees 8 bytes alignment: the payload starts at
+ * the first ARENA_ALIGN boundary after the header */
+struct arena_chunk {
+	struct arena_chunk *next;
+};
+
+#define CHUNK_OVERHEAD	(sizeof(struct arena_chunk) + ARENA_ALIGN - 1)
+
+struct arena scratch_arena;
+
+EFI_STATUS arena_init(struct arena *arena, UINTN size)
+{
+	EFI_PHYSICAL_ADDRESS base;
+	EFI_STATUS ret;
+
+	ZeroMem(arena, sizeof(*arena));
+
+	ret = allocate_pages(AllocateAnyPages, EfiLoaderData,
+			     EFI_SIZE_TO_PAGES(size), &base);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to reserve a 0x%x bytes arena: %r\n", size, ret);
+		return ret;
+	}
+
+	arena->base = (UINT8 *)(UINTN)base;
+	arena->size = EFI_SIZE_TO_PAGES(size) << EFI_PAGE_SHIFT;
+	return EFI_SUCCESS;
+}
+
+void arena_destroy(struct arena *arena)
+{
+	arena_reset(arena);
+	if (arena->base)
+		free_pages((EFI_PHYSICAL_ADDRESS)(UINTN)arena->base,
+			   EFI_SIZE_TO_PAGES(arena->size));
+	ZeroMem(arena, sizeof(*arena));
+}
+
+void *arena_alloc(struct arena *arena, UINTN size)
+{
+	struct arena_chunk *chunk;
+	UINTN used = ALIGN_UP(arena->used, ARENA_ALIGN);
+
+	if (used <= arena->size && size <= arena->size - used) {
+		arena->used = used + size;
+		return arena->base + used;
+	}
+
+	if (size > (UINTN)-1 - CHUNK_OVERHEAD)
+		return NULL;
+
+	chunk = AllocatePool(CHUNK_OVERHEAD + size);
+	if (!chunk)
+		return NULL;
+
+	debug(L"Arena exhausted, 0x%x bytes taken from the pool\n", size);
+	chunk->next = arena->chunks;
+	arena->chunks = chunk;
+	return (void *)ALIGN_UP((UINTN)(chunk + 1), ARENA_ALIGN);
+}
+
+void *arena_zalloc(struct arena *arena, UINTN size)
+{
+	void *p = arena_alloc(arena, size);
+
+	if (p)
+		ZeroMem(p, size);
+	return p;
+}
+
+void arena_restore(struct arena *arena, struct arena_mark mark)
+{
+	struct arena_chunk *chunk;
+
+	while (arena->chunks != mark.chunks) {
+		chunk = arena->chunks;
+		arena->chunks = chunk->next;
+		FreePool(chunk);
+	}
+	arena->used = mark.used;
+}
+
+CHAR8 *arena_join_strings(struct arena *arena, CHAR8 *s1, CHAR8 *s2)
+{
+	UINTN len_s1 = s1 ? strlena(s1) : 0;
+	UINTN len_s2 = s2 ? strlena(s2) : 0;
+	BOOLEAN space = s1 && s2;
+	CHAR8 *new;
+	UINTN i = 0;
+
+	if (!s1 && !s2)
+		return NULL;
+
+	new = arena_alloc(arena, len_s1 + len_s2 + 1 + space);
+	if (!new) {
+		error(L"Failed to allocate new command line\n");
+		return NULL;
+	}
+
+	if (s1) {
+		CopyMem(new, s1, len_s1);
+		i += len_s1;
+	}
+	if (space)
+		new[i++] = ' ';
+	if (s2) {
+		CopyMem(new + i, s2, len_s2);
+		i += len_s2;
+	}
+	new[i] = '\0';
+
+	return new;
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _ARENA_H_
+#define _ARENA_H_
+
+#include <efi.h>
+
+/*
+ * Bump allocator for scratch memory.
+ *
+ * An arena hands out memory from one block of pages reserved up front
+ * and takes it all back at once: arena_reset() for the lifetime of a
+ * fastboot command or a boot phase, arena_save()/arena_restore() for a
+ * nested scope.  Nothing is freed individually.
+ *
+ * When the block is exhausted, or was never reserved, allocations fall
+ * back to the pool and are released along with the arena.
+ */
+
+#define ARENA_ALIGN		16
+#define SCRATCH_ARENA_SIZE	(4 * 1024 * 1024)
+
+struct arena_chunk;
+
+struct arena {
+	UINT8 *base;
+	UINTN size;
+	UINTN used;
+	struct arena_chunk *chunks;	/* pool fallback allocations */
+};
+
+struct arena_mark {
+	UINTN used;
+	struct arena_chunk *chunks;
+};
+
+/* Scratch memory of the current fastboot command or boot phase */
+extern struct arena scratch_arena;
+
+EFI_STATUS arena_init(struct arena *arena, UINTN size);
+void arena_destroy(struct arena *arena);
+void *arena_alloc(struct arena *arena, UINTN size);
+void *arena_zalloc(struct arena *arena, UINTN size);
+void arena_restore(struct arena *arena, struct arena_mark mark);
+
+/* Concatenate @s1 and @s2 with a space in between, NULL if both are */
+CHAR8 *arena_join_strings(struct arena *arena, CHAR8 *s1, CHAR8 *s2);
+
+static inline struct arena_mark arena_save(struct arena *arena)
+{
+	return (struct arena_mark){ arena->used, arena->chunks };
+}
+
+static inline void arena_reset(struct arena *arena)
+{
+	arena_restore(arena, (struct arena_mark){ 0, NULL });
+}
+
+#endif	/* _ARENA_H_ */
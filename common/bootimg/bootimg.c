@@ -35,11 +35,16 @@
 #include <efilib.h>
 #include <uefi_utils.h>
 #include <log.h>
+#include <gpt.h>
+#include <time.h>
 #include <asm/bootparam.h>
 #include <string.h>
 
 #include "bootimg.h"
 #include "check_signature.h"
+#include <checkpoint.h>
+#include <arena.h>
+#include "placement.h"
 
 #ifdef CONFIG_X86_64
 #include "x86_64.h"
@@ -64,6 +69,28 @@ typedef struct {
 dt_addr_t gdt = { 0x800, (UINT64 *)0 };
 dt_addr_t idt = { 0, 0 };
 
+#define BOOT_PARAMS_SIZE	16384
+#define BOOT_PARAMS_MAX		0x3fffffff
+/* Documentation/x86/boot.txt: "The kernel command line can be located
+ * anywhere between the end of the setup heap and 0xA0000" */
+#define CMDLINE_MAX		0xA0000
+/* Low-memory is super-precious! */
+#define LOW_MEMORY_END		(1 << 20)
+
+enum {
+	PLACE_KERNEL,
+	PLACE_RAMDISK,
+	PLACE_BOOT_PARAMS,
+	PLACE_CMDLINE,
+	PLACE_GDT,
+	PLACE_COUNT
+};
+
+/* Addresses planned for the boot payloads from a single memory map
+ * snapshot. An allocation falls back to the former per-payload search
+ * if its planned pages were taken since. */
+static struct placement plan[PLACE_COUNT];
+
 struct boot_img_hdr {
 	unsigned char magic[BOOT_MAGIC_SIZE];
 
@@ -188,37 +215,190 @@ static EFI_STATUS verify_boot_image(UINT8 *bootimage)
 			       bootimage + sig_offset, sigsize);
 }
 
-static EFI_STATUS setup_ramdisk(CHAR8 *bootimage)
+static void plan_boot(struct boot_img_hdr *aosp_header, struct boot_params *buf,
+		      CHAR8 *append)
 {
-	struct boot_img_hdr *aosp_header;
-	struct boot_params *buf;
-	UINT32 roffset, rsize;
-	EFI_PHYSICAL_ADDRESS ramdisk_addr;
+	EFI_MEMORY_DESCRIPTOR *map_buf;
+	UINTN map_size, map_key, desc_size;
+	UINT32 desc_version;
+	struct placement_stats stats;
+	UINT64 start;
 	EFI_STATUS ret;
+	UINTN i;
 
-	aosp_header = (struct boot_img_hdr *)bootimage;
-	buf = (struct boot_params *)(bootimage + aosp_header->page_size);
+	start = get_current_time_us();
+	ZeroMem(plan, sizeof(plan));
+	ZeroMem(&stats, sizeof(stats));
+
+	plan[PLACE_KERNEL].size = buf->hdr.init_size;
+	plan[PLACE_KERNEL].align = buf->hdr.kernel_alignment;
+	plan[PLACE_KERNEL].min = LOW_MEMORY_END;
+	plan[PLACE_KERNEL].max = (UINT64)-1;
+	plan[PLACE_KERNEL].pref = buf->hdr.pref_address;
+	plan[PLACE_KERNEL].fixed = !buf->hdr.relocatable_kernel;
+
+	plan[PLACE_RAMDISK].size = aosp_header->ramdisk_size;
+	plan[PLACE_RAMDISK].min = LOW_MEMORY_END;
+	plan[PLACE_RAMDISK].max = (UINT64)buf->hdr.initrd_addr_max + 1;
+	plan[PLACE_RAMDISK].top_down = TRUE;
+
+	plan[PLACE_BOOT_PARAMS].size = BOOT_PARAMS_SIZE;
+	plan[PLACE_BOOT_PARAMS].max = (UINT64)BOOT_PARAMS_MAX + 1;
+	plan[PLACE_BOOT_PARAMS].top_down = TRUE;
+
+	plan[PLACE_CMDLINE].size = BOOT_ARGS_SIZE + BOOT_EXTRA_ARGS_SIZE
+		+ (append ? strlena(append) + 1 : 0);
+	plan[PLACE_CMDLINE].min = EFI_PAGE_SIZE;
+	plan[PLACE_CMDLINE].max = CMDLINE_MAX;
+	plan[PLACE_CMDLINE].top_down = TRUE;
+
+	plan[PLACE_GDT].size = gdt.limit;
+	plan[PLACE_GDT].min = LOW_MEMORY_END;
+	plan[PLACE_GDT].max = (UINT64)-1;
+
+	ret = memory_map(&map_buf, &map_size, &map_key, &desc_size, &desc_version);
+	if (EFI_ERROR(ret)) {
+		ZeroMem(plan, sizeof(plan));
+		return;
+	}
+
+	ret = placement_plan(&scratch_arena, map_buf, map_size, desc_size,
+			     plan, PLACE_COUNT, &stats);
+	FreePool(map_buf);
+	if (EFI_ERROR(ret))
+		warning(L"Some boot payloads could not be planned : %r\n", ret);
+
+	for (i = 0; i < PLACE_COUNT; i++)
+		debug(L"Payload %d planned at 0x%lx, %ld bytes\n", i, plan[i].addr, plan[i].size);
+	debug(L"Placement planned in %ld us, %d free ranges left, largest %ld KB, %d%% fragmented\n",
+	      get_current_time_us() - start, stats.free_ranges, stats.largest >> 10,
+	      placement_fragmentation(&stats));
+}
+
+/* Allocate the pages planned for @item, fails if it could not be
+ * planned or if the memory map changed since */
+static EFI_STATUS allocate_planned(UINTN item, UINTN size, EFI_PHYSICAL_ADDRESS *addr)
+{
+	EFI_STATUS ret;
+
+	if (!plan[item].addr || size > plan[item].size)
+		return EFI_NOT_FOUND;
+
+	*addr = plan[item].addr;
+	ret = allocate_pages(AllocateAddress, EfiLoaderData,
+			     EFI_SIZE_TO_PAGES(size), addr);
+	if (EFI_ERROR(ret))
+		warning(L"Planned address 0x%lx of payload %d is taken : %r\n", plan[item].addr, item, ret);
+	return ret;
+}
+
+static UINT32 ramdisk_offset(struct boot_img_hdr *aosp_header)
+{
+	return (1 + pages(aosp_header, aosp_header->kernel_size))
+		* aosp_header->page_size;
+}
+
+/* Size of the real-mode setup code, boot sector included, which
+ * precedes the protected-mode kernel in the bzImage */
+static UINT32 setup_size(struct boot_params *buf)
+{
+	return ((UINT32)buf->hdr.setup_sects + 1) * 512;
+}
+
+static EFI_STATUS check_kernel_header(struct boot_img_hdr *aosp_header,
+				      struct boot_params *buf)
+{
+	/* Check boot sector signature */
+	if (buf->hdr.boot_flag != 0xAA55) {
+		error(L"bzImage kernel corrupt\n");
+		return EFI_INVALID_PARAMETER;
+	}
+
+	if (buf->hdr.header != SETUP_HDR) {
+		error(L"Setup code version is invalid\n");
+		return EFI_INVALID_PARAMETER;
+	}
+
+	if (aosp_header->kernel_size <= setup_size(buf)) {
+		error(L"Kernel is smaller than its setup code\n");
+		return EFI_INVALID_PARAMETER;
+	}
+
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS allocate_ramdisk(struct boot_img_hdr *aosp_header,
+				   struct boot_params *buf)
+{
+	EFI_PHYSICAL_ADDRESS ramdisk_addr;
+	UINT32 rsize;
+	EFI_STATUS ret;
 
-	roffset = (1 + pages(aosp_header, aosp_header->kernel_size))
-		  * aosp_header->page_size;
 	rsize = aosp_header->ramdisk_size;
 	buf->hdr.ramdisk_size = rsize;
-	ret = emalloc(rsize, 0x1000, &ramdisk_addr);
+	ret = allocate_planned(PLACE_RAMDISK, rsize, &ramdisk_addr);
+	if (EFI_ERROR(ret))
+		ret = emalloc(rsize, 0x1000, &ramdisk_addr);
 	if (EFI_ERROR(ret))
 		return ret;
 
 	if ((UINTN)ramdisk_addr > buf->hdr.initrd_addr_max) {
 		error(L"Ramdisk address is too high!\n");
-		ret = EFI_OUT_OF_RESOURCES;
-		goto out_error;
+		efree(ramdisk_addr, rsize);
+		return EFI_OUT_OF_RESOURCES;
 	}
-	memcpy((VOID *)(UINTN)ramdisk_addr, bootimage + roffset, rsize);
 	buf->hdr.ramdisk_image = (UINT32)(UINTN)ramdisk_addr;
-	debug(L"Ramdisk copied into address 0x%x\n", ramdisk_addr);
 	return EFI_SUCCESS;
-out_error:
-	efree(ramdisk_addr, rsize);
-	return ret;
+}
+
+static EFI_STATUS allocate_kernel(struct boot_params *buf,
+				  EFI_PHYSICAL_ADDRESS *kernel_start)
+{
+	EFI_STATUS ret;
+
+	ret = allocate_planned(PLACE_KERNEL, buf->hdr.init_size, kernel_start);
+	if (EFI_ERROR(ret)) {
+		*kernel_start = buf->hdr.pref_address;
+		ret = allocate_pages(AllocateAddress, EfiLoaderData,
+				     EFI_SIZE_TO_PAGES(buf->hdr.init_size), kernel_start);
+	}
+	if (EFI_ERROR(ret)) {
+		/*
+		 * We failed to allocate the preferred address, so
+		 * just allocate some memory and hope for the best.
+		 */
+		ret = emalloc(buf->hdr.init_size, buf->hdr.kernel_alignment, kernel_start);
+		if (EFI_ERROR(ret))
+			return ret;
+	}
+	debug(L"kernel_start = 0x%x\n", *kernel_start);
+
+	if (!buf->hdr.relocatable_kernel && *kernel_start != buf->hdr.pref_address) {
+		error(L"Failed to store non relocatable kernel to it's preferred address\n");
+		efree(*kernel_start, buf->hdr.init_size);
+		return EFI_LOAD_ERROR;
+	}
+
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS setup_ramdisk(CHAR8 *bootimage)
+{
+	struct boot_img_hdr *aosp_header;
+	struct boot_params *buf;
+	EFI_STATUS ret;
+
+	aosp_header = (struct boot_img_hdr *)bootimage;
+	buf = (struct boot_params *)(bootimage + aosp_header->page_size);
+
+	ret = allocate_ramdisk(aosp_header, buf);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	memcpy((VOID *)(UINTN)buf->hdr.ramdisk_image,
+	       bootimage + ramdisk_offset(aosp_header), buf->hdr.ramdisk_size);
+	debug(L"Ramdisk copied into address 0x%x\n", buf->hdr.ramdisk_image);
+	return EFI_SUCCESS;
 }
 
 extern EFI_GUID GraphicsOutputProtocol;
@@ -248,16 +428,17 @@ static EFI_STATUS setup_command_line(UINT8 *bootimage,
 {
 	EFI_PHYSICAL_ADDRESS cmdline_addr;
 	CHAR8 *full_cmdline;
-	UINTN cmdlen;
+	UINTN cmdlen, append_len = append ? strlena(append) : 0;
 	EFI_STATUS ret;
 	struct boot_img_hdr *aosp_header;
 	struct boot_params *buf;
-	UINTN cmdline_pool_size = BOOT_ARGS_SIZE + BOOT_EXTRA_ARGS_SIZE;
+	struct arena_mark mark = arena_save(&scratch_arena);
 
 	aosp_header = (struct boot_img_hdr *)bootimage;
 	buf = (struct boot_params *)(bootimage + aosp_header->page_size);
 
-	full_cmdline = AllocatePool(cmdline_pool_size);
+	full_cmdline = arena_alloc(&scratch_arena, BOOT_ARGS_SIZE +
+				   BOOT_EXTRA_ARGS_SIZE + append_len + 1);
 	if (!full_cmdline) {
 		ret = EFI_OUT_OF_RESOURCES;
 		goto out;
@@ -271,29 +452,17 @@ static EFI_STATUS setup_command_line(UINT8 *bootimage,
 	cmdlen = strlena(full_cmdline);
 
 	if (append) {
-		UINTN append_len = strlena(append);
-		UINTN new_size = cmdlen + append_len + 2;
-		if (new_size >= cmdline_pool_size) {
-			full_cmdline = ReallocatePool(full_cmdline, cmdline_pool_size, new_size);
-			if (!full_cmdline) {
-				error(L"Failed to reallocate cmdline\n");
-				ret = EFI_OUT_OF_RESOURCES;
-				goto out;
-			}
-			cmdline_pool_size = new_size;
-		}
-
 		full_cmdline[cmdlen] = ' ';
 		memcpy(full_cmdline + cmdlen + 1, append, append_len + 1);
 		cmdlen = strlena(full_cmdline);
-		FreePool(append);
-	}
-	/* Documentation/x86/boot.txt: "The kernel command line can be located
-	 * anywhere between the end of the setup heap and 0xA0000" */
-	cmdline_addr = 0xA0000;
-	ret = allocate_pages(AllocateMaxAddress, EfiLoaderData,
-			     EFI_SIZE_TO_PAGES(cmdlen + 1),
-			     &cmdline_addr);
+	}
+	ret = allocate_planned(PLACE_CMDLINE, cmdlen + 1, &cmdline_addr);
+	if (EFI_ERROR(ret)) {
+		cmdline_addr = CMDLINE_MAX;
+		ret = allocate_pages(AllocateMaxAddress, EfiLoaderData,
+				     EFI_SIZE_TO_PAGES(cmdlen + 1),
+				     &cmdline_addr);
+	}
 	if (!cmdline_addr || EFI_ERROR(ret))
 		goto out;
 
@@ -303,7 +472,7 @@ static EFI_STATUS setup_command_line(UINT8 *bootimage,
 	buf->hdr.cmdline_size = cmdlen + 1;
 	ret = EFI_SUCCESS;
 out:
-	FreePool(full_cmdline);
+	arena_restore(&scratch_arena, mark);
 	return ret;
 }
 
@@ -311,7 +480,9 @@ static EFI_STATUS setup_idt_gdt(void)
 {
 	EFI_STATUS err;
 
-	err = emalloc(gdt.limit, 8, (EFI_PHYSICAL_ADDRESS *)&gdt.base);
+	err = allocate_planned(PLACE_GDT, gdt.limit, (EFI_PHYSICAL_ADDRESS *)&gdt.base);
+	if (EFI_ERROR(err))
+		err = emalloc(gdt.limit, 8, (EFI_PHYSICAL_ADDRESS *)&gdt.base);
 	if (err != EFI_SUCCESS)
 		return err;
 
@@ -435,76 +606,92 @@ out:
 	return ret;
 }
 
-static EFI_STATUS handover_kernel(CHAR8 *bootimage, BOOLEAN watchdog_en, struct bootimg_hooks *hooks)
+/* The EFI handover protocol lets the kernel EFI stub build its memory
+ * map and exit boot services itself. Boot protocol 2.11 introduced
+ * handover_offset, 2.12 the xloadflags telling which entry points
+ * the kernel actually provides. */
+static BOOLEAN use_efi_handover(struct boot_params *buf)
+{
+#ifdef CONFIG_DISABLE_EFI_HANDOVER
+	return FALSE;
+#else
+	if (buf->hdr.version < 0x20b || !buf->hdr.handover_offset)
+		return FALSE;
+	if (buf->hdr.version == 0x20b)
+		return TRUE;
+#ifdef CONFIG_X86_64
+	return (buf->hdr.xloadflags & XLF_EFI_HANDOVER_64) != 0;
+#else
+	return (buf->hdr.xloadflags & XLF_EFI_HANDOVER_32) != 0;
+#endif
+#endif
+}
+
+static EFI_STATUS handover_kernel(CHAR8 *bootimage, EFI_PHYSICAL_ADDRESS kernel_start,
+				  BOOLEAN watchdog_en, struct bootimg_hooks *hooks)
 {
-	EFI_PHYSICAL_ADDRESS kernel_start;
 	EFI_PHYSICAL_ADDRESS boot_addr;
 	struct boot_params *boot_params;
-	UINT64 init_size;
 	EFI_STATUS ret;
 	struct boot_img_hdr *aosp_header;
 	struct boot_params *buf;
-	UINT8 setup_sectors;
-	UINT32 setup_size;
-	UINT32 ksize;
-	UINT32 koffset;
+	UINT64 start;
 
+	start = get_current_time_us();
 	aosp_header = (struct boot_img_hdr *)bootimage;
 	buf = (struct boot_params *)(bootimage + aosp_header->page_size);
 
-	koffset = aosp_header->page_size;
-	setup_sectors = buf->hdr.setup_sects;
-	setup_sectors++; /* Add boot sector */
-	setup_size = (UINT32)setup_sectors * 512;
-	ksize = aosp_header->kernel_size - setup_size;
-	kernel_start = buf->hdr.pref_address;
-	init_size = buf->hdr.init_size;
 	buf->hdr.type_of_loader = 0xff;
 
 	memset((CHAR8 *)&buf->screen_info, 0x0, sizeof(buf->screen_info));
 
 	setup_screen_info_from_gop(&buf->screen_info);
 
-	ret = allocate_pages(AllocateAddress, EfiLoaderData,
-			     EFI_SIZE_TO_PAGES(init_size), &kernel_start);
+	ret = allocate_planned(PLACE_BOOT_PARAMS, BOOT_PARAMS_SIZE, &boot_addr);
 	if (EFI_ERROR(ret)) {
-		/*
-		 * We failed to allocate the preferred address, so
-		 * just allocate some memory and hope for the best.
-		 */
-		ret = emalloc(init_size, buf->hdr.kernel_alignment, &kernel_start);
-		if (EFI_ERROR(ret))
-			return ret;
-	}
-	debug(L"kernel_start = 0x%x\n", kernel_start);
-
-	if (!buf->hdr.relocatable_kernel && kernel_start != buf->hdr.pref_address) {
-		error(L"Failed to store non relocatable kernel to it's preferred address\n");
-		ret = EFI_LOAD_ERROR;
-		goto out;
+		boot_addr = BOOT_PARAMS_MAX;
+		ret = allocate_pages(AllocateMaxAddress, EfiLoaderData,
+				     EFI_SIZE_TO_PAGES(BOOT_PARAMS_SIZE), &boot_addr);
 	}
-
-	memcpy((CHAR8 *)(UINTN)kernel_start, bootimage + koffset + setup_size, ksize);
-
-	boot_addr = 0x3fffffff;
-	ret = allocate_pages(AllocateMaxAddress, EfiLoaderData,
-			     EFI_SIZE_TO_PAGES(16384), &boot_addr);
 	if (EFI_ERROR(ret))
 		goto out;
 
 	boot_params = (struct boot_params *)(UINTN)boot_addr;
-	memset((void *)boot_params, 0x0, 16384);
+	memset((void *)boot_params, 0x0, BOOT_PARAMS_SIZE);
 
 	/* Copy first two sectors to boot_params */
 	memcpy((CHAR8 *)boot_params, (CHAR8 *)buf, 2 * 512);
 	boot_params->hdr.code32_start = (UINT32)((UINT64)kernel_start);
 
+	if (use_efi_handover(buf)) {
+		debug(L"EFI handover prepared in %ld us\n", get_current_time_us() - start);
+
+		if (watchdog_en && hooks && hooks->watchdog)
+			hooks->watchdog();
+
+		if (hooks && hooks->before_exit)
+			hooks->before_exit();
+
+		if (hooks && hooks->before_jump)
+			hooks->before_jump();
+
+		checkpoint("kernel_jump");
+		handover_jump(buf->hdr.version, LibImageHandle, boot_params, kernel_start);
+		/* Shouldn't get here */
+
+		ret = EFI_LOAD_ERROR;
+		free_pages(boot_addr, EFI_SIZE_TO_PAGES(BOOT_PARAMS_SIZE));
+		goto out;
+	}
+
 	ret = EFI_LOAD_ERROR;
 
 	ret = setup_idt_gdt();
 	if (EFI_ERROR(ret))
 		goto out;
 
+	debug(L"Legacy handover prepared in %ld us\n", get_current_time_us() - start);
+
 	if (watchdog_en && hooks && hooks->watchdog)
 		hooks->watchdog();
 
@@ -524,6 +711,7 @@ static EFI_STATUS handover_kernel(CHAR8 *bootimage, BOOLEAN watchdog_en, struct
 	ret = exit_boot_services(bootimage, map_key);
 	if (EFI_ERROR(ret))
 		goto out;
+	checkpoint("exit_boot_services");
 
 	if (hooks && hooks->before_jump)
 		hooks->before_jump();
@@ -531,37 +719,238 @@ static EFI_STATUS handover_kernel(CHAR8 *bootimage, BOOLEAN watchdog_en, struct
 	asm volatile ("lidt %0" :: "m" (idt));
 	asm volatile ("lgdt %0" :: "m" (gdt));
 
+	checkpoint("kernel_jump");
 	kernel_jump(kernel_start, boot_params);
 	/* Shouldn't get here */
 
-	free_pages(boot_addr, EFI_SIZE_TO_PAGES(16384));
+	free_pages(boot_addr, EFI_SIZE_TO_PAGES(BOOT_PARAMS_SIZE));
 out:
 	debug(L"Can't boot kernel\n");
-	efree(kernel_start, ksize);
 	return ret;
 }
 
-EFI_STATUS android_image_start_partition(
-	IN const EFI_GUID *guid,
-	IN CHAR8 *cmdline,
-	IN struct bootimg_hooks *hooks)
+/* Common tail of all the boot paths: @bootimage holds at least the
+ * boot image header page and the kernel setup code, the kernel and
+ * the ramdisk are already in place. */
+static EFI_STATUS start_kernel(CHAR8 *bootimage, EFI_PHYSICAL_ADDRESS kernel_start,
+			       CHAR8 *cmdline, struct bootimg_hooks *hooks)
 {
-	EFI_BLOCK_IO *BlockIo;
-	EFI_DISK_IO *DiskIo;
-	UINT32 MediaId;
+	struct boot_img_hdr *aosp_header;
+	struct boot_params *buf;
+	BOOLEAN watchdog_en = TRUE;
+	EFI_STATUS ret;
+
+	aosp_header = (struct boot_img_hdr *)bootimage;
+	buf = (struct boot_params *)(bootimage + aosp_header->page_size);
+
+	debug(L"Creating command line\n");
+	ret = setup_command_line((UINT8 *)bootimage, cmdline);
+	if (EFI_ERROR(ret)) {
+		error(L"setup_command_line : %r\n", ret);
+		return ret;
+	}
+
+	if ((buf->hdr.cmd_line_ptr) &&
+			strstr((char *)(UINTN)buf->hdr.cmd_line_ptr, "disable_kernel_watchdog=1"))
+		watchdog_en = FALSE;
+
+	debug(L"Starting the kernel\n");
+	ret = handover_kernel(bootimage, kernel_start, watchdog_en, hooks);
+	error(L"handover_kernel : %r\n", ret);
+
+	if (buf->hdr.cmd_line_ptr)
+		free_pages(buf->hdr.cmd_line_ptr,
+			   strlena((CHAR8 *)(UINTN)buf->hdr.cmd_line_ptr) + 1);
+	return ret;
+}
+
+EFI_STATUS bootimg_load_begin(struct bootimg_loader *loader, const EFI_GUID *guid)
+{
+	struct boot_img_hdr aosp_header;
+	struct boot_params *buf;
+	UINTN size, full_size;
+	CHAR8 *header;
+	EFI_STATUS ret;
+
+	ZeroMem(loader, sizeof(*loader));
+
+	debug(L"Locating boot image\n");
+	ret = gpt_find_partition_by_guid(guid, &loader->gparti);
+	if (EFI_ERROR(ret)) {
+		error(L"Boot partition %g not found: %r\n", guid, ret);
+		return ret;
+	}
+
+	debug(L"Reading boot image header\n");
+	ret = gpt_read_partition(loader->gparti, 0, sizeof(aosp_header), &aosp_header);
+	if (EFI_ERROR(ret)) {
+		error(L"ReadDisk (header) : %r\n", ret);
+		return ret;
+	}
+	if (strncmpa((CHAR8 *)BOOT_MAGIC, aosp_header.magic, BOOT_MAGIC_SIZE)) {
+		error(L"This partition does not appear to contain an Android boot image\n");
+		return EFI_INVALID_PARAMETER;
+	}
+	if (aosp_header.page_size < sizeof(aosp_header)) {
+		error(L"Invalid boot image page size %d\n", aosp_header.page_size);
+		return EFI_INVALID_PARAMETER;
+	}
+
+	/* Header page and the first two kernel sectors, which give the
+	 * size of the setup code */
+	size = aosp_header.page_size + 2 * 512;
+	loader->header = AllocatePool(size);
+	if (!loader->header)
+		return EFI_OUT_OF_RESOURCES;
+
+	ret = gpt_read_partition(loader->gparti, 0, size, loader->header);
+	if (EFI_ERROR(ret)) {
+		error(L"ReadDisk (kernel header) : %r\n", ret);
+		goto free_header;
+	}
+
+	buf = (struct boot_params *)(loader->header + aosp_header.page_size);
+	ret = check_kernel_header(&aosp_header, buf);
+	if (EFI_ERROR(ret))
+		goto free_header;
+
+	full_size = aosp_header.page_size + setup_size(buf);
+	if (full_size > size) {
+		/* Not ReallocatePool(): gnu-efi's frees the old buffer
+		 * even when the new allocation fails */
+		header = AllocatePool(full_size);
+		if (!header) {
+			ret = EFI_OUT_OF_RESOURCES;
+			goto free_header;
+		}
+		CopyMem(header, loader->header, size);
+		FreePool(loader->header);
+		loader->header = header;
+		ret = gpt_read_partition(loader->gparti, size, full_size - size,
+					 loader->header + size);
+		if (EFI_ERROR(ret)) {
+			error(L"ReadDisk (kernel setup) : %r\n", ret);
+			goto free_header;
+		}
+		buf = (struct boot_params *)(loader->header + aosp_header.page_size);
+	}
+
+	/* The command line is not known yet, its planned page leaves
+	 * room for a short one to be appended */
+	plan_boot(&aosp_header, buf, NULL);
+
+	ret = allocate_ramdisk(&aosp_header, buf);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to allocate the ramdisk : %r\n", ret);
+		goto free_header;
+	}
+
+	ret = allocate_kernel(buf, &loader->segments[BOOTIMG_KERNEL].addr);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to allocate the kernel : %r\n", ret);
+		goto free_ramdisk;
+	}
+
+	loader->segments[BOOTIMG_KERNEL].offset = full_size;
+	loader->segments[BOOTIMG_KERNEL].size = aosp_header.kernel_size - setup_size(buf);
+	loader->segments[BOOTIMG_RAMDISK].offset = ramdisk_offset(&aosp_header);
+	loader->segments[BOOTIMG_RAMDISK].addr = buf->hdr.ramdisk_image;
+	loader->segments[BOOTIMG_RAMDISK].size = buf->hdr.ramdisk_size;
+	return EFI_SUCCESS;
+
+free_ramdisk:
+	efree(buf->hdr.ramdisk_image, buf->hdr.ramdisk_size);
+free_header:
+	FreePool(loader->header);
+	loader->header = NULL;
+	return ret;
+}
+
+EFI_STATUS bootimg_load_step(struct bootimg_loader *loader)
+{
+	struct bootimg_segment *seg;
+	UINT64 size;
+	EFI_STATUS ret;
+
+	for (; loader->current < BOOTIMG_SEGMENTS; loader->current++, loader->done = 0) {
+		seg = &loader->segments[loader->current];
+		if (loader->done == seg->size)
+			continue;
+
+		size = seg->size - loader->done;
+		if (size > BOOTIMG_CHUNK_SIZE)
+			size = BOOTIMG_CHUNK_SIZE;
+
+		ret = gpt_read_partition(loader->gparti, seg->offset + loader->done, size,
+					 (VOID *)(UINTN)(seg->addr + loader->done));
+		if (EFI_ERROR(ret))
+			return ret;
+
+		loader->done += size;
+		return EFI_SUCCESS;
+	}
+
+	return EFI_END_OF_MEDIA;
+}
+
+void bootimg_load_abort(struct bootimg_loader *loader)
+{
+	struct boot_img_hdr *aosp_header;
+	struct boot_params *buf;
+
+	if (!loader->header)
+		return;
+
+	aosp_header = (struct boot_img_hdr *)loader->header;
+	buf = (struct boot_params *)(loader->header + aosp_header->page_size);
+
+	efree(loader->segments[BOOTIMG_KERNEL].addr, buf->hdr.init_size);
+	efree(buf->hdr.ramdisk_image, buf->hdr.ramdisk_size);
+	FreePool(loader->header);
+	loader->header = NULL;
+}
+
+EFI_STATUS bootimg_load_start(struct bootimg_loader *loader, CHAR8 *cmdline,
+			      struct bootimg_hooks *hooks)
+{
+	EFI_STATUS ret;
+
+	debug(L"Loading the kernel and the ramdisk\n");
+	while (!EFI_ERROR(ret = bootimg_load_step(loader)))
+		;
+	if (ret != EFI_END_OF_MEDIA) {
+		error(L"ReadDisk : %r\n", ret);
+		goto out;
+	}
+	checkpoint("image_read");
+
+	ret = start_kernel(loader->header, loader->segments[BOOTIMG_KERNEL].addr,
+			   cmdline, hooks);
+out:
+	bootimg_load_abort(loader);
+	return ret;
+}
+
+/* The verification protocols take the whole signed image in a single
+ * buffer, it cannot be loaded in place */
+static EFI_STATUS start_partition_buffer(const EFI_GUID *guid, CHAR8 *cmdline,
+					 struct bootimg_hooks *hooks)
+{
+	struct gpt_partition_interface *gparti;
 	UINT32 img_size;
 	UINT8 *bootimage;
 	EFI_STATUS ret;
 	struct boot_img_hdr aosp_header;
 
 	debug(L"Locating boot image\n");
-	ret = open_partition(guid, &MediaId, &BlockIo, &DiskIo);
-	if (EFI_ERROR(ret))
+	ret = gpt_find_partition_by_guid(guid, &gparti);
+	if (EFI_ERROR(ret)) {
+		error(L"Boot partition %g not found: %r\n", guid, ret);
 		return ret;
+	}
 
 	debug(L"Reading boot image header\n");
-	ret = uefi_call_wrapper(DiskIo->ReadDisk, 5, DiskIo, MediaId, 0,
-				sizeof(aosp_header), &aosp_header);
+	ret = gpt_read_partition(gparti, 0, sizeof(aosp_header), &aosp_header);
 	if (EFI_ERROR(ret)) {
 		error(L"ReadDisk (header) : %r\n", ret);
 		return ret;
@@ -577,12 +966,12 @@ EFI_STATUS android_image_start_partition(
 		return EFI_OUT_OF_RESOURCES;
 
 	debug(L"Reading full boot image\n");
-	ret = uefi_call_wrapper(DiskIo->ReadDisk, 5, DiskIo, MediaId, 0,
-				img_size, bootimage);
+	ret = gpt_read_partition(gparti, 0, img_size, bootimage);
 	if (EFI_ERROR(ret)) {
 		error(L"ReadDisk : %r\n", ret);
 		goto out;
 	}
+	checkpoint("image_read");
 
 	ret = android_image_start_buffer(bootimage, cmdline, hooks);
 out:
@@ -590,6 +979,26 @@ out:
 	return ret;
 }
 
+EFI_STATUS android_image_start_partition(
+	IN const EFI_GUID *guid,
+	IN CHAR8 *cmdline,
+	IN struct bootimg_hooks *hooks)
+{
+	struct bootimg_loader loader;
+	EFI_STATUS ret;
+
+	/* Decide before reading anything whether the image has to be
+	 * verified as a whole */
+	if (check_signature_required())
+		return start_partition_buffer(guid, cmdline, hooks);
+
+	ret = bootimg_load_begin(&loader, guid);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	return bootimg_load_start(&loader, cmdline, hooks);
+}
+
 EFI_STATUS android_image_start_file(
 	IN EFI_HANDLE device,
 	IN CHAR16 *loader,
@@ -714,59 +1123,47 @@ EFI_STATUS android_image_start_buffer(
 {
 	struct boot_img_hdr *aosp_header;
 	struct boot_params *buf;
+	EFI_PHYSICAL_ADDRESS kernel_start;
 	EFI_STATUS ret;
 	aosp_header = (struct boot_img_hdr *)bootimage;
 	buf = (struct boot_params *)((CHAR8 *)bootimage + aosp_header->page_size);
-	BOOLEAN watchdog_en = TRUE;
-
-	/* Check boot sector signature */
-	if (buf->hdr.boot_flag != 0xAA55) {
-		error(L"bzImage kernel corrupt\n");
-		ret = EFI_INVALID_PARAMETER;
-		goto out_bootimage;
-	}
 
-	if (buf->hdr.header != SETUP_HDR) {
-		error(L"Setup code version is invalid\n");
-		ret = EFI_INVALID_PARAMETER;
-		goto out_bootimage;
-	}
+	ret = check_kernel_header(aosp_header, buf);
+	if (EFI_ERROR(ret))
+		goto out;
 
 	ret = verify_boot_image(bootimage);
 	if (EFI_ERROR(ret)) {
 		error(L"boot image digital signature verification failed : %r\n", ret);
-		goto out_bootimage;
+		goto out;
 	}
+	checkpoint("verify");
 
-	debug(L"Creating command line\n");
-	ret = setup_command_line(bootimage, cmdline);
-	if (EFI_ERROR(ret)) {
-		error(L"setup_command_line : %r\n", ret);
-		goto out_bootimage;
-	}
+	plan_boot(aosp_header, buf, cmdline);
 
 	debug(L"Loading the ramdisk\n");
 	ret = setup_ramdisk(bootimage);
 	if (EFI_ERROR(ret)) {
 		error(L"setup_ramdisk : %r\n", ret);
-		goto out_cmdline;
+		goto out;
 	}
 
-	if ((buf->hdr.cmd_line_ptr) &&
-			strstr((char *)(UINTN)buf->hdr.cmd_line_ptr, "disable_kernel_watchdog=1"))
-		watchdog_en = FALSE;
-
 	debug(L"Loading the kernel\n");
-	ret = handover_kernel(bootimage, watchdog_en, hooks);
-	error(L"handover_kernel : %r\n", ret);
+	ret = allocate_kernel(buf, &kernel_start);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to allocate the kernel : %r\n", ret);
+		goto out_ramdisk;
+	}
+	memcpy((CHAR8 *)(UINTN)kernel_start,
+	       (CHAR8 *)buf + setup_size(buf),
+	       aosp_header->kernel_size - setup_size(buf));
 
+	ret = start_kernel(bootimage, kernel_start, cmdline, hooks);
+
+	efree(kernel_start, buf->hdr.init_size);
+out_ramdisk:
 	efree(buf->hdr.ramdisk_image, buf->hdr.ramdisk_size);
-out_cmdline:
-	if (buf->hdr.cmd_line_ptr)
-		free_pages(buf->hdr.cmd_line_ptr,
-			   strlena((CHAR8 *)(UINTN)buf->hdr.cmd_line_ptr) + 1);
-out_bootimage:
-	FreePool(bootimage);
+out:
 	return ret;
 }
 
@@ -19,6 +19,7 @@
 
 #include <efi.h>
 #include <efilib.h>
+#include <gpt.h>
 
 #define XLF_EFI_HANDOVER_32     (1<<2)
 #define XLF_EFI_HANDOVER_64     (1<<3)
@@ -49,6 +50,43 @@ EFI_STATUS android_image_start_partition(
 	IN CHAR8 *cmdline,
 	IN struct bootimg_hooks *hooks);
 
+/* Boot image loader reading the kernel and the ramdisk from the
+ * partition straight into the memory they run from.
+ *
+ * bootimg_load_begin() reads the headers and allocates the kernel and
+ * ramdisk memory, each bootimg_load_step() call then reads at most
+ * BOOTIMG_CHUNK_SIZE bytes and returns EFI_END_OF_MEDIA once
+ * everything is loaded, so that the caller can interleave other work
+ * with the reads. bootimg_load_start() reads whatever is left and
+ * boots; bootimg_load_abort() releases the loader memory. */
+#define BOOTIMG_CHUNK_SIZE	(4 * 1024 * 1024)
+
+enum bootimg_segment_id {
+	BOOTIMG_KERNEL,
+	BOOTIMG_RAMDISK,
+	BOOTIMG_SEGMENTS
+};
+
+struct bootimg_segment {
+	UINT64 offset;			/* in the partition */
+	EFI_PHYSICAL_ADDRESS addr;
+	UINT64 size;
+};
+
+struct bootimg_loader {
+	struct gpt_partition_interface *gparti;
+	CHAR8 *header;			/* header page and kernel setup code */
+	struct bootimg_segment segments[BOOTIMG_SEGMENTS];
+	UINTN current;
+	UINT64 done;			/* bytes read in the current segment */
+};
+
+EFI_STATUS bootimg_load_begin(struct bootimg_loader *loader, const EFI_GUID *guid);
+EFI_STATUS bootimg_load_step(struct bootimg_loader *loader);
+EFI_STATUS bootimg_load_start(struct bootimg_loader *loader, CHAR8 *cmdline,
+			      struct bootimg_hooks *hooks);
+void bootimg_load_abort(struct bootimg_loader *loader);
+
 /* Load the next boot target if specified in the BCB partition,
  * which we specify by partition GUID. Place the value in var,
  * which must be freed. Capsule updates are also attempted if
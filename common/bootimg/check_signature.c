@@ -65,17 +65,39 @@ struct _OS_VERIFICATION_PROTOCOL {
 	GET_SECURITY_POLICY     GetSecurityPolicy;
 };
 
-static BOOLEAN is_secure_boot_enabled(void)
+/* The protocol and the policy do not change during a boot, look them
+ * up once */
+static OS_VERIFICATION_PROTOCOL *get_os_verification_protocol(void)
 {
-	OS_VERIFICATION_PROTOCOL *ovp;
+	static OS_VERIFICATION_PROTOCOL *ovp;
 	EFI_STATUS ret;
-	BOOLEAN unsigned_allowed;
+
+	if (ovp)
+		return ovp;
 
 	ret = LibLocateProtocol(&gOsVerificationProtocolGuid, (void **)&ovp);
 	if (EFI_ERROR(ret) || !ovp) {
 		error(L"%x failure\n", __func__);
-		goto out;
+		ovp = NULL;
 	}
+	return ovp;
+}
+
+static BOOLEAN is_secure_boot_enabled(void)
+{
+	static BOOLEAN checked;
+	static BOOLEAN enabled = TRUE;
+	OS_VERIFICATION_PROTOCOL *ovp;
+	EFI_STATUS ret;
+	BOOLEAN unsigned_allowed;
+
+	if (checked)
+		return enabled;
+	checked = TRUE;
+
+	ovp = get_os_verification_protocol();
+	if (!ovp)
+		goto out;
 
 	ret = uefi_call_wrapper(ovp->GetSecurityPolicy, 2, ovp,
 				&unsigned_allowed);
@@ -83,16 +105,20 @@ static BOOLEAN is_secure_boot_enabled(void)
 		goto out;
 
 	debug(L"unsigned_allowed = %x\n", unsigned_allowed);
-	return (unsigned_allowed == FALSE);
+	enabled = (unsigned_allowed == FALSE);
 out:
-	return TRUE;
+	return enabled;
+}
+
+BOOLEAN check_signature_required(void)
+{
+	return is_secure_boot_enabled();
 }
 
 EFI_STATUS check_signature(IN VOID *os, IN UINTN os_size,
 			   IN VOID *manifest, IN UINTN manifest_size)
 {
 	OS_VERIFICATION_PROTOCOL *ovp;
-	EFI_STATUS ret;
 
 	if (!is_secure_boot_enabled())
 		return EFI_SUCCESS;
@@ -103,18 +129,13 @@ EFI_STATUS check_signature(IN VOID *os, IN UINTN os_size,
 	}
 	debug(L"checking boot image signature\n");
 
-	ret = LibLocateProtocol(&gOsVerificationProtocolGuid, (void **)&ovp);
-	if (EFI_ERROR(ret) || !ovp) {
-		error(L"%x failure\n", __func__);
-		goto out;
-	}
+	ovp = get_os_verification_protocol();
+	if (!ovp)
+		return EFI_NOT_FOUND;
 
-	ret = uefi_call_wrapper(ovp->VerifiyOsImage, 5, ovp,
-				os, os_size,
-				manifest, manifest_size);
-
-out:
-	return ret;
+	return uefi_call_wrapper(ovp->VerifiyOsImage, 5, ovp,
+				 os, os_size,
+				 manifest, manifest_size);
 }
 
 #elif defined(USE_SHIM)
@@ -122,11 +143,16 @@ out:
 
 static BOOL is_secure_boot_enabled(void)
 {
-	UINT8 secure_boot;
+	static BOOLEAN checked;
+	static UINT8 secure_boot;
 	UINTN size;
 	EFI_STATUS status;
 	EFI_GUID global_var_guid = EFI_GLOBAL_VARIABLE;
 
+	if (checked)
+		return (secure_boot == 1);
+	checked = TRUE;
+
 	size = sizeof(secure_boot);
 	status = uefi_call_wrapper(RT->GetVariable, 5,
 				   L"SecureBoot", (EFI_GUID *)&global_var_guid, NULL, &size, (void*)&secure_boot);
@@ -138,13 +164,18 @@ static BOOL is_secure_boot_enabled(void)
 	return (secure_boot == 1);
 }
 
+BOOLEAN check_signature_required(void)
+{
+	return is_secure_boot_enabled();
+}
+
 EFI_GUID gShimLockProtocolGuid = SHIM_LOCK_GUID;
 
 EFI_STATUS check_signature(IN VOID *blob, IN UINTN blob_size,
 			   IN VOID *sig, IN UINTN sig_size)
 {
 
-	SHIM_LOCK *shim_lock;
+	static SHIM_LOCK *shim_lock;
 	EFI_STATUS ret;
 
 	if (!is_secure_boot_enabled())
@@ -157,10 +188,13 @@ EFI_STATUS check_signature(IN VOID *blob, IN UINTN blob_size,
 	}
 	debug(L"checking boot image signature\n");
 
-	ret = LibLocateProtocol(&gShimLockProtocolGuid, (VOID **)&shim_lock);
-	if (EFI_ERROR(ret)) {
-		error(L"Couldn't instantiate shim protocol", ret);
-		return ret;
+	if (!shim_lock) {
+		ret = LibLocateProtocol(&gShimLockProtocolGuid, (VOID **)&shim_lock);
+		if (EFI_ERROR(ret)) {
+			error(L"Couldn't instantiate shim protocol", ret);
+			shim_lock = NULL;
+			return ret;
+		}
 	}
 
 	ret = uefi_call_wrapper(VerifyBlob, 4, shim_lock,
@@ -37,6 +37,10 @@
 EFI_STATUS check_signature(IN VOID *os, IN UINTN os_size,
 			   IN VOID *manifest, IN UINTN manifest_size);
 
+/* TRUE if check_signature() actually verifies images. The verification
+ * protocols take the whole image in a single buffer. */
+BOOLEAN check_signature_required(void);
+
 #else
 static inline EFI_STATUS check_signature(IN VOID *os  __attribute__((__unused__)),
 		IN UINTN os_size  __attribute__((__unused__)),
@@ -45,5 +49,10 @@ static inline EFI_STATUS check_signature(IN VOID *os  __attribute__((__unused__)
 {
 	return EFI_SUCCESS;
 }
+
+static inline BOOLEAN check_signature_required(void)
+{
+	return FALSE;
+}
 #endif
 #endif
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <efi.h>
+#include <efilib.h>
+
+#include "placement.h"
+
+struct range {
+	EFI_PHYSICAL_ADDRESS start;
+	EFI_PHYSICAL_ADDRESS end;
+};
+
+/* Sorted and merged conventional memory ranges of @map. Room is left
+ * for one split per payload. */
+static struct range *free_ranges(struct arena *arena, EFI_MEMORY_DESCRIPTOR *map,
+				 UINTN map_size, UINTN desc_size, UINTN extra,
+				 UINTN *count)
+{
+	EFI_MEMORY_DESCRIPTOR *d;
+	struct range *ranges, r;
+	UINTN n = 0, i, j;
+
+	ranges = arena_alloc(arena, (map_size / desc_size + extra) * sizeof(*ranges));
+	if (!ranges)
+		return NULL;
+
+	for (i = 0; i < map_size / desc_size; i++) {
+		d = (EFI_MEMORY_DESCRIPTOR *)((UINT8 *)map + i * desc_size);
+		if (d->Type != EfiConventionalMemory || !d->NumberOfPages)
+			continue;
+
+		r.start = d->PhysicalStart;
+		r.end = r.start + (d->NumberOfPages << EFI_PAGE_SHIFT);
+
+		/* Firmware maps are almost sorted, insertion sort is
+		 * cheap on them */
+		for (j = n; j > 0 && ranges[j - 1].start > r.start; j--)
+			ranges[j] = ranges[j - 1];
+		ranges[j] = r;
+		n++;
+	}
+
+	for (i = 0, j = 0; i < n; i++) {
+		if (j && ranges[j - 1].end == ranges[i].start)
+			ranges[j - 1].end = ranges[i].end;
+		else
+			ranges[j++] = ranges[i];
+	}
+
+	*count = j;
+	return ranges;
+}
+
+/* Address where @item fits in @r, 0 if it does not */
+static EFI_PHYSICAL_ADDRESS fit(struct range *r, struct placement *item)
+{
+	EFI_PHYSICAL_ADDRESS start, end, addr;
+
+	start = r->start > item->min ? r->start : item->min;
+	end = r->end < item->max ? r->end : item->max;
+	if (start >= end || end - start < item->size)
+		return 0;
+
+	if (item->top_down) {
+		addr = (end - item->size) & ~(item->align - 1);
+		return addr >= start ? addr : 0;
+	}
+
+	addr = (start + item->align - 1) & ~(item->align - 1);
+	return addr <= end - item->size ? addr : 0;
+}
+
+/* Remove [addr, addr + size) from range @i, which contains it */
+static void carve(struct range *ranges, UINTN *count, UINTN i,
+		  EFI_PHYSICAL_ADDRESS addr, UINT64 size)
+{
+	struct range tail = { addr + size, ranges[i].end };
+	UINTN j;
+
+	ranges[i].end = addr;
+	if (tail.start == tail.end)
+		goto drop_empty;
+
+	for (j = *count; j > i + 1; j--)
+		ranges[j] = ranges[j - 1];
+	ranges[i + 1] = tail;
+	(*count)++;
+
+drop_empty:
+	if (ranges[i].start != ranges[i].end)
+		return;
+	for (j = i; j + 1 < *count; j++)
+		ranges[j] = ranges[j + 1];
+	(*count)--;
+}
+
+static BOOLEAN place(struct range *ranges, UINTN *count, struct placement *item)
+{
+	EFI_PHYSICAL_ADDRESS addr;
+	UINTN i, best = 0;
+
+	item->addr = 0;
+	if (!item->size)
+		return TRUE;
+
+	if (item->pref) {
+		for (i = 0; i < *count; i++)
+			if (ranges[i].start <= item->pref && ranges[i].end >= item->pref
+			    && ranges[i].end - item->pref >= item->size) {
+				item->addr = item->pref;
+				carve(ranges, count, i, item->addr, item->size);
+				return TRUE;
+			}
+		if (item->fixed)
+			return FALSE;
+	}
+
+	for (i = 0; i < *count; i++) {
+		addr = fit(&ranges[i], item);
+		if (!addr)
+			continue;
+		if (!item->addr || item->top_down) {
+			item->addr = addr;
+			best = i;
+		}
+		if (!item->top_down)
+			break;
+	}
+	if (!item->addr)
+		return FALSE;
+
+	carve(ranges, count, best, item->addr, item->size);
+	return TRUE;
+}
+
+EFI_STATUS placement_plan(struct arena *arena,
+			  EFI_MEMORY_DESCRIPTOR *map, UINTN map_size, UINTN desc_size,
+			  struct placement *items, UINTN count,
+			  struct placement_stats *stats)
+{
+	struct arena_mark mark = arena_save(arena);
+	struct range *ranges;
+	UINTN nranges, i;
+	EFI_STATUS ret = EFI_SUCCESS;
+
+	ranges = free_ranges(arena, map, map_size, desc_size, count, &nranges);
+	if (!ranges)
+		return EFI_OUT_OF_RESOURCES;
+
+	for (i = 0; i < count; i++) {
+		items[i].size = EFI_SIZE_TO_PAGES(items[i].size) << EFI_PAGE_SHIFT;
+		if (items[i].align < EFI_PAGE_SIZE)
+			items[i].align = EFI_PAGE_SIZE;
+		if (!place(ranges, &nranges, &items[i]))
+			ret = EFI_OUT_OF_RESOURCES;
+	}
+
+	if (stats) {
+		ZeroMem(stats, sizeof(*stats));
+		stats->free_ranges = nranges;
+		for (i = 0; i < nranges; i++) {
+			UINT64 size = ranges[i].end - ranges[i].start;
+			stats->free_size += size;
+			if (size > stats->largest)
+				stats->largest = size;
+		}
+	}
+
+	arena_restore(arena, mark);
+	return ret;
+}
+
+UINTN placement_fragmentation(struct placement_stats *stats)
+{
+	if (!stats->free_size)
+		return 0;
+	return 100 - (UINTN)(stats->largest * 100 / stats->free_size);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _PLACEMENT_H_
+#define _PLACEMENT_H_
+
+#include <efi.h>
+#include <arena.h>
+
+/* One payload to place in physical memory. The planner only reads the
+ * memory map it is given: the caller allocates the planned addresses
+ * with AllocateAddress afterwards. */
+struct placement {
+	UINT64 size;
+	UINT64 align;			/* power of two, at least a page */
+	EFI_PHYSICAL_ADDRESS min;	/* lowest allowed address */
+	EFI_PHYSICAL_ADDRESS max;	/* end of the allowed range, exclusive */
+	EFI_PHYSICAL_ADDRESS pref;	/* tried first if not 0 */
+	BOOLEAN fixed;			/* @pref or nothing */
+	BOOLEAN top_down;		/* highest fitting address instead of lowest */
+	EFI_PHYSICAL_ADDRESS addr;	/* result, 0 if it could not be placed */
+};
+
+struct placement_stats {
+	UINTN free_ranges;
+	UINT64 free_size;
+	UINT64 largest;
+};
+
+/* Place @count payloads, in order, in the conventional memory of @map.
+ * Returns EFI_OUT_OF_RESOURCES if any of them could not be placed, the
+ * others are placed anyway. @stats, if not NULL, describes the free
+ * memory left once everything is placed. The working memory is taken
+ * from @arena and given back before returning. */
+EFI_STATUS placement_plan(struct arena *arena,
+			  EFI_MEMORY_DESCRIPTOR *map, UINTN map_size, UINTN desc_size,
+			  struct placement *items, UINTN count,
+			  struct placement_stats *stats);
+
+/* Percentage of the free memory which is not in the largest range */
+UINTN placement_fragmentation(struct placement_stats *stats);
+
+#endif	/* _PLACEMENT_H_ */
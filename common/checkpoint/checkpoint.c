@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <efi.h>
+#include <efilib.h>
+#include <cpu.h>
+#include <time.h>
+#include <log.h>
+#include <uefi_utils.h>
+
+#include "checkpoint.h"
+
+static struct checkpoint_table initial_table = {
+	.magic = CHECKPOINT_MAGIC,
+	.version = CHECKPOINT_VERSION,
+	.capacity = CHECKPOINT_MAX,
+	.entry_size = sizeof(struct checkpoint_entry),
+};
+
+static struct checkpoint_table *table = &initial_table;
+
+void checkpoint(const char *name)
+{
+	struct checkpoint_entry *entry;
+	UINTN i;
+
+	if (table->count == CHECKPOINT_MAX)
+		return;
+
+	entry = &table->entries[table->count++];
+	entry->tsc = rdtsc();
+	for (i = 0; i < CHECKPOINT_NAME_LEN - 1 && name[i]; i++)
+		entry->name[i] = name[i];
+	entry->name[i] = '\0';
+}
+
+EFI_STATUS checkpoint_export(CHAR16 *varname, EFI_GUID *guid)
+{
+	EFI_PHYSICAL_ADDRESS addr;
+	EFI_STATUS ret;
+
+	if (table == &initial_table) {
+		ret = allocate_pages(AllocateAnyPages, EfiRuntimeServicesData,
+				     EFI_SIZE_TO_PAGES(sizeof(*table)), &addr);
+		if (EFI_ERROR(ret)) {
+			error(L"Failed to allocate the checkpoint table: %r\n", ret);
+			return ret;
+		}
+
+		initial_table.tsc_khz = get_tsc_khz();
+		initial_table.address = addr;
+		table = (struct checkpoint_table *)(UINTN)addr;
+		CopyMem(table, &initial_table, sizeof(*table));
+	}
+
+	checkpoint("checkpoint_export");
+
+	ret = LibSetVariable(varname, guid,
+			     offsetof(struct checkpoint_table, entries[table->count]),
+			     table);
+	if (EFI_ERROR(ret))
+		error(L"Failed to save the checkpoints: %r\n", ret);
+
+	return ret;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CHECKPOINT_H_
+#define _CHECKPOINT_H_
+
+#include <efi.h>
+
+/*
+ * Boot stage timeline.
+ *
+ * checkpoint() stamps the TSC for a named stage into a fixed table.
+ * It neither allocates nor calls the firmware, so it may be used up to
+ * the kernel jump, after ExitBootServices.
+ *
+ * checkpoint_export() moves the table to EfiRuntimeServicesData memory,
+ * which the OS never reclaims, and publishes it in a volatile runtime
+ * variable.  The variable holds the stages recorded so far and the
+ * physical address of the live table, where the stages recorded after
+ * the export (ExitBootServices, kernel jump) keep being written.
+ */
+
+#define CHECKPOINT_MAGIC	0x50434c45	/* "ELCP" */
+#define CHECKPOINT_VERSION	1
+#define CHECKPOINT_NAME_LEN	24
+#define CHECKPOINT_MAX		64
+
+struct checkpoint_entry {
+	UINT64 tsc;
+	CHAR8 name[CHECKPOINT_NAME_LEN];
+} __attribute__((packed));
+
+struct checkpoint_table {
+	UINT32 magic;
+	UINT16 version;
+	UINT16 count;
+	UINT32 capacity;
+	UINT32 entry_size;
+	UINT64 tsc_khz;
+	UINT64 address;		/* of the live table, 0 until exported */
+	struct checkpoint_entry entries[CHECKPOINT_MAX];
+} __attribute__((packed));
+
+void checkpoint(const char *name);
+EFI_STATUS checkpoint_export(CHAR16 *varname, EFI_GUID *guid);
+
+#endif	/* _CHECKPOINT_H_ */
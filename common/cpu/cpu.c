@@ -32,7 +32,7 @@
 #define STR_TO_UINTN(a, b, c, d) ((a) + ((b) << 8) + ((c) << 16) + ((d) << 24))
 #define CPUID_MASK	0xffff0
 
-static inline void cpuid(uint32_t op, uint32_t reg[4])
+static inline void cpuid_count(uint32_t op, uint32_t count, uint32_t reg[4])
 {
 #ifdef CONFIG_X86
 	asm volatile("pushl %%ebx      \n\t" /* save %ebx */
@@ -40,17 +40,22 @@ static inline void cpuid(uint32_t op, uint32_t reg[4])
 		     "movl %%ebx, %1   \n\t" /* save what cpuid just put in %ebx */
 		     "popl %%ebx       \n\t" /* restore the old %ebx */
 		     : "=a"(reg[0]), "=r"(reg[1]), "=c"(reg[2]), "=d"(reg[3])
-		     : "a"(op)
+		     : "a"(op), "c"(count)
 		     : "cc");
 #elif CONFIG_X86_64
 	asm volatile("xchg{q}\t{%%}rbx, %q1\n\t"
 		     "cpuid\n\t"
 		     "xchg{q}\t{%%}rbx, %q1\n\t"
 		     : "=a" (reg[0]), "=&r" (reg[1]), "=c" (reg[2]), "=d" (reg[3])
-		     : "a" (op));
+		     : "a" (op), "c" (count));
 #endif
 }
 
+static inline void cpuid(uint32_t op, uint32_t reg[4])
+{
+	cpuid_count(op, 0, reg);
+}
+
 enum cpu_id x86_identify_cpu()
 {
 	uint32_t reg[4];
@@ -65,3 +70,32 @@ enum cpu_id x86_identify_cpu()
 	cpuid(1, reg);
 	return reg[0] & CPUID_MASK;
 }
+
+uint32_t x86_cpuid_max_leaf(void)
+{
+	uint32_t reg[4];
+
+	if (x86_identify_cpu() == CPU_UNKNOWN)
+		return 0;
+
+	cpuid(0, reg);
+	return reg[0];
+}
+
+void x86_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t reg[4])
+{
+	cpuid_count(leaf, subleaf, reg);
+}
+
+BOOLEAN x86_cpu_has_feature(enum cpu_feature feature)
+{
+	uint32_t leaf = feature >> 16;
+	uint32_t reg[4];
+
+	cpuid(0, reg);
+	if (reg[0] < leaf)
+		return FALSE;
+
+	cpuid_count(leaf, 0, reg);
+	return (reg[(feature >> 8) & 0xff] >> (feature & 0xff)) & 1;
+}
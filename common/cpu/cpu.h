@@ -40,6 +40,27 @@ enum cpu_id {
 
 enum cpu_id x86_identify_cpu();
 
+/* CPUID feature flags, encoded as leaf, register and bit */
+#define CPUID_EBX 1
+#define CPUID_ECX 2
+#define CPUID_EDX 3
+#define CPU_FEATURE(leaf, reg, bit) (((leaf) << 16) | ((reg) << 8) | (bit))
+
+enum cpu_feature {
+	CPU_FEATURE_SSE2      = CPU_FEATURE(1, CPUID_EDX, 26),
+	CPU_FEATURE_PCLMULQDQ = CPU_FEATURE(1, CPUID_ECX, 1),
+	CPU_FEATURE_SSSE3     = CPU_FEATURE(1, CPUID_ECX, 9),
+	CPU_FEATURE_SSE4_1    = CPU_FEATURE(1, CPUID_ECX, 19),
+	CPU_FEATURE_SSE4_2    = CPU_FEATURE(1, CPUID_ECX, 20),
+	CPU_FEATURE_ERMS      = CPU_FEATURE(7, CPUID_EBX, 9),
+};
+
+BOOLEAN x86_cpu_has_feature(enum cpu_feature feature);
+
+/* Highest basic CPUID leaf, 0 on non Intel CPUs */
+uint32_t x86_cpuid_max_leaf(void);
+void x86_cpuid(uint32_t leaf, uint32_t subleaf, uint32_t reg[4]);
+
 #if !defined(CONFIG_X86) && !defined(CONFIG_X86_64)
 #error "Only architecure x86 and x86_64 are supported"
 #endif
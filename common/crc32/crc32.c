@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <efi.h>
+#include <efilib.h>
+#include <cpu.h>
+#include "crc32.h"
+
+#define CRC32_POLY 0xedb88320
+
+static UINT32 crc32_table[8][256];
+static UINT32 x2n_table[32];
+
+static UINT32 crc32_init(UINT32 crc, const UINT8 *buf, UINTN len);
+static UINT32 (*crc32_kernel)(UINT32 crc, const UINT8 *buf, UINTN len) = crc32_init;
+
+/* Slice-by-8: eight bytes per iteration, using one table per byte
+ * position. @crc is the inverted running value.
+ */
+static UINT32 crc32_slice8(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	UINT32 lo, hi;
+
+	while (len && ((UINTN)buf & 7)) {
+		crc = crc32_table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+		len--;
+	}
+
+	while (len >= 8) {
+		lo = *(const UINT32 *)buf ^ crc;
+		hi = *(const UINT32 *)(buf + 4);
+		crc = crc32_table[7][lo & 0xff] ^
+			crc32_table[6][(lo >> 8) & 0xff] ^
+			crc32_table[5][(lo >> 16) & 0xff] ^
+			crc32_table[4][lo >> 24] ^
+			crc32_table[3][hi & 0xff] ^
+			crc32_table[2][(hi >> 8) & 0xff] ^
+			crc32_table[1][(hi >> 16) & 0xff] ^
+			crc32_table[0][hi >> 24];
+		buf += 8;
+		len -= 8;
+	}
+
+	while (len--)
+		crc = crc32_table[0][(crc ^ *buf++) & 0xff] ^ (crc >> 8);
+
+	return crc;
+}
+
+#ifdef CONFIG_X86_64
+/* Folding with carry-less multiplications, 64 bytes per iteration.
+ * Constants and reduction steps are the ones of the Linux kernel
+ * crc32-pclmul implementation (Intel white paper "Fast CRC Computation
+ * for Generic Polynomials Using PCLMULQDQ Instruction"), for the
+ * bit-reflected polynomial.
+ */
+typedef long long v2di __attribute__((vector_size(16)));
+typedef long long v2di_u __attribute__((vector_size(16), aligned(1)));
+typedef int v4si __attribute__((vector_size(16)));
+
+#define PCLMUL_TARGET __attribute__((target("sse2,sse4.1,pclmul")))
+
+#define CONSTANT_R1 0x154442bd4LL
+#define CONSTANT_R2 0x1c6e41596LL
+#define CONSTANT_R3 0x1751997d0LL
+#define CONSTANT_R4 0x0ccaa009eLL
+#define CONSTANT_R5 0x163cd6124LL
+#define CONSTANT_POLY 0x1db710641LL
+#define CONSTANT_U 0x1f7011641LL
+
+static inline PCLMUL_TARGET v2di fold128(v2di x, v2di k, v2di next)
+{
+	return __builtin_ia32_pclmulqdq128(x, k, 0x00) ^
+		__builtin_ia32_pclmulqdq128(x, k, 0x11) ^ next;
+}
+
+/* @len must be a multiple of 16, and at least 64 */
+static PCLMUL_TARGET UINT32 crc32_pclmul(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	const v2di_u *p = (const v2di_u *)buf;
+	v2di x1, x2, x3, x4, k, t;
+	v2di mask32 = { 0xffffffffLL, 0 };
+
+	x1 = p[0];
+	x2 = p[1];
+	x3 = p[2];
+	x4 = p[3];
+	x1 ^= (v2di){ crc, 0 };
+	p += 4;
+	len -= 64;
+
+	k = (v2di){ CONSTANT_R1, CONSTANT_R2 };
+	while (len >= 64) {
+		x1 = fold128(x1, k, p[0]);
+		x2 = fold128(x2, k, p[1]);
+		x3 = fold128(x3, k, p[2]);
+		x4 = fold128(x4, k, p[3]);
+		p += 4;
+		len -= 64;
+	}
+
+	/* fold the four lanes into one */
+	k = (v2di){ CONSTANT_R3, CONSTANT_R4 };
+	x1 = fold128(x1, k, x2);
+	x1 = fold128(x1, k, x3);
+	x1 = fold128(x1, k, x4);
+	while (len >= 16) {
+		x1 = fold128(x1, k, p[0]);
+		p++;
+		len -= 16;
+	}
+
+	/* 128 to 64 bits, appending 32 zero bits */
+	t = __builtin_ia32_pclmulqdq128(x1, k, 0x10);
+	x1 = (v2di)__builtin_ia32_psrldqi128(x1, 64) ^ t;
+
+	/* 64 to 32 bits */
+	k = (v2di){ CONSTANT_R5, 0 };
+	t = __builtin_ia32_pclmulqdq128(x1 & mask32, k, 0x00);
+	x1 = (v2di)__builtin_ia32_psrldqi128(x1, 32) ^ t;
+
+	/* Barrett reduction */
+	k = (v2di){ CONSTANT_POLY, CONSTANT_U };
+	t = __builtin_ia32_pclmulqdq128(x1 & mask32, k, 0x10);
+	t = __builtin_ia32_pclmulqdq128(t & mask32, k, 0x00);
+	x1 ^= t;
+
+	return ((v4si)x1)[1];
+}
+
+static UINT32 crc32_clmul(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	UINTN n;
+
+	if (len >= 64) {
+		n = len & ~15UL;
+		crc = crc32_pclmul(crc, buf, n);
+		buf += n;
+		len -= n;
+	}
+	return crc32_slice8(crc, buf, len);
+}
+#endif
+
+static UINT32 multmodp(UINT32 a, UINT32 b)
+{
+	UINT32 m = (UINT32)1 << 31;
+	UINT32 p = 0;
+
+	for (;;) {
+		if (a & m) {
+			p ^= b;
+			if ((a & (m - 1)) == 0)
+				break;
+		}
+		m >>= 1;
+		b = b & 1 ? (b >> 1) ^ CRC32_POLY : b >> 1;
+	}
+	return p;
+}
+
+/* x^(n * 2^k) modulo the polynomial */
+static UINT32 x2nmodp(UINT64 n, unsigned k)
+{
+	UINT32 p = (UINT32)1 << 31;
+
+	while (n) {
+		if (n & 1)
+			p = multmodp(x2n_table[k & 31], p);
+		n >>= 1;
+		k++;
+	}
+	return p;
+}
+
+static void crc32_tables(void)
+{
+	UINT32 c, p;
+	unsigned i, j;
+
+	for (i = 0; i < 256; i++) {
+		c = i;
+		for (j = 0; j < 8; j++)
+			c = c & 1 ? (c >> 1) ^ CRC32_POLY : c >> 1;
+		crc32_table[0][i] = c;
+	}
+	for (i = 0; i < 256; i++)
+		for (j = 1; j < 8; j++)
+			crc32_table[j][i] = (crc32_table[j - 1][i] >> 8) ^
+				crc32_table[0][crc32_table[j - 1][i] & 0xff];
+
+	p = (UINT32)1 << 30;
+	x2n_table[0] = p;
+	for (i = 1; i < 32; i++)
+		x2n_table[i] = p = multmodp(p, p);
+}
+
+static UINT32 crc32_init(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	crc32_tables();
+
+	crc32_kernel = crc32_slice8;
+#ifdef CONFIG_X86_64
+	if (x86_cpu_has_feature(CPU_FEATURE_PCLMULQDQ) &&
+	    x86_cpu_has_feature(CPU_FEATURE_SSE4_1))
+		crc32_kernel = crc32_clmul;
+#endif
+
+	return crc32_kernel(crc, buf, len);
+}
+
+UINT32 crc32(UINT32 crc, const VOID *buf, UINTN len)
+{
+	return ~crc32_kernel(~crc, buf, len);
+}
+
+UINT32 crc32_combine(UINT32 crc1, UINT32 crc2, UINT64 len2)
+{
+	if (crc32_kernel == crc32_init)
+		crc32_init(0, NULL, 0);
+
+	return multmodp(x2nmodp(len2, 3), crc1) ^ crc2;
+}
+
+UINT32 crc32_zeros(UINT32 crc, UINT64 len)
+{
+	if (crc32_kernel == crc32_init)
+		crc32_init(0, NULL, 0);
+
+	/* appending zeros multiplies the running value by x^(8 * len) */
+	return ~multmodp(x2nmodp(len, 3), ~crc);
+}
+
+UINT32 crc32_fill(UINT32 crc, UINT32 pattern, UINT64 len)
+{
+	UINT64 count = len / sizeof(pattern);
+	UINT64 blk_len = sizeof(pattern);
+	UINT32 blk;
+
+	/* double a block of patterns, appending it for each bit of count */
+	blk = crc32(0, &pattern, sizeof(pattern));
+	while (count) {
+		if (count & 1)
+			crc = crc32_combine(crc, blk, blk_len);
+		count >>= 1;
+		if (count)
+			blk = crc32_combine(blk, blk, blk_len);
+		blk_len <<= 1;
+	}
+
+	return crc32(crc, &pattern, len % sizeof(pattern));
+}
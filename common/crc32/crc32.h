@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _CRC32_H_
+#define _CRC32_H_
+
+#include <efi.h>
+
+/*
+ * Standard CRC-32 (IEEE 802.3, reflected 0xEDB88320), compatible with
+ * zlib's crc32(): start with 0 and feed the returned value back to
+ * continue a computation.
+ */
+UINT32 crc32(UINT32 crc, const VOID *buf, UINTN len);
+
+/* Continue @crc over @len zero bytes, in O(log(len)) */
+UINT32 crc32_zeros(UINT32 crc, UINT64 len);
+
+/* Continue @crc over @len bytes made of the repeated 32 bits @pattern */
+UINT32 crc32_fill(UINT32 crc, UINT32 pattern, UINT64 len);
+
+/* CRC of A followed by B, from crc(A), crc(B) and the length of B */
+UINT32 crc32_combine(UINT32 crc1, UINT32 crc2, UINT64 len2);
+
+#endif	/* _CRC32_H_ */
@@ -31,10 +31,14 @@
 #include <efilib.h>
 #include <uefi_utils.h>
 #include <log.h>
+#include <time.h>
+#include <crc32.h>
 #include "gpt.h"
 
 #define PROTECTIVE_MBR 0xEE
 #define GPT_SIGNATURE "EFI PART"
+#define GPT_MAX_ENTRIES 1024
+#define GPT_MAX_ENTRIES_SIZE (1024 * 1024)
 
 struct gpt_header {
 	char signature[8];
@@ -81,36 +85,96 @@ struct gpt_disk {
 	EFI_DISK_IO *dio;
 	struct gpt_header gpt_hd;
 	struct gpt_partition *partitions;
+	struct gpt_partition_interface *entries;
+	UINTN nentries;
+	BOOLEAN backup;		/* primary table corrupted */
+};
+
+/* Open addressing hash table of pointers to the partition entries,
+ * the size is a power of two at least twice the number of entries. */
+struct gpt_index {
+	struct gpt_partition_interface **slots;
+	UINTN size;
 };
 
 static struct gpt_disk *disks;
 static UINTN ndisk;
 static UINTN npart;
+static UINTN ncorrupted;
 
-static EFI_STATUS read_gpt_header(struct gpt_disk *disk)
-{
-	EFI_STATUS ret;
+/* Block devices found when the scan starts, parsed one at a time, on
+ * demand or from a timer event */
+static EFI_HANDLE *handles;
+static UINTN nhandles;
+static UINTN scanned;
+static EFI_EVENT scan_event;
 
-	ret = uefi_call_wrapper(disk->dio->ReadDisk, 5, disk->dio, disk->bio->Media->MediaId, disk->bio->Media->BlockSize, sizeof(disk->gpt_hd), (VOID *)&disk->gpt_hd);
-	if (EFI_ERROR(ret))
-		error(L"Failed to read disk for GPT header: %r\n", ret);
+#define GPT_SCAN_PERIOD 100000	/* 10ms, in 100ns units */
 
-	return ret;
-}
+static struct gpt_index by_label;
+static struct gpt_index by_guid;
+static struct gpt_index by_type;
 
 static BOOLEAN is_gpt_device(struct gpt_header *gpt)
 {
 	return CompareMem(gpt->signature, GPT_SIGNATURE, sizeof(gpt->signature)) == 0;
 }
 
+/* Read the GPT header at @lba and check its CRC */
+static EFI_STATUS read_gpt_header(struct gpt_disk *disk, EFI_LBA lba)
+{
+	UINT32 block_size = disk->bio->Media->BlockSize;
+	struct gpt_header *hd;
+	UINT32 crc;
+	EFI_STATUS ret;
+
+	hd = AllocatePool(block_size);
+	if (!hd)
+		return EFI_OUT_OF_RESOURCES;
+
+	ret = uefi_call_wrapper(disk->dio->ReadDisk, 5, disk->dio, disk->bio->Media->MediaId, lba * block_size, block_size, (VOID *)hd);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to read disk for GPT header: %r\n", ret);
+		goto out;
+	}
+	CopyMem(&disk->gpt_hd, hd, sizeof(disk->gpt_hd));
+
+	if (!is_gpt_device(hd)) {
+		ret = EFI_NOT_FOUND;
+		goto out;
+	}
+	if (hd->size < sizeof(*hd) || hd->size > block_size || hd->my_lba != lba) {
+		ret = EFI_VOLUME_CORRUPTED;
+		goto out;
+	}
+
+	crc = hd->header_crc32;
+	hd->header_crc32 = 0;
+	if (crc32(0, hd, hd->size) != crc)
+		ret = EFI_CRC_ERROR;
+out:
+	FreePool(hd);
+	return ret;
+}
+
 static EFI_STATUS read_gpt_partitions(struct gpt_disk *disk)
 {
+	struct gpt_header *hd = &disk->gpt_hd;
 	EFI_STATUS ret;
-	UINTN offset;
+	UINT64 offset;
 	UINTN size;
 
-	offset = disk->bio->Media->BlockSize * disk->gpt_hd.entries_lba;
-	size = disk->gpt_hd.number_of_entries * disk->gpt_hd.size_of_entry;
+	/* Both come from the disk: bound them before multiplying */
+	if (!hd->number_of_entries || hd->number_of_entries > GPT_MAX_ENTRIES ||
+	    hd->size_of_entry < sizeof(struct gpt_partition) ||
+	    hd->size_of_entry > GPT_MAX_ENTRIES_SIZE / hd->number_of_entries) {
+		error(L"Invalid GPT entry array: %d entries of %d bytes\n",
+		      hd->number_of_entries, hd->size_of_entry);
+		return EFI_VOLUME_CORRUPTED;
+	}
+
+	offset = (UINT64)disk->bio->Media->BlockSize * hd->entries_lba;
+	size = (UINTN)hd->number_of_entries * hd->size_of_entry;
 
 	disk->partitions = AllocatePool(size);
 	if (!disk->partitions) {
@@ -123,17 +187,69 @@ static EFI_STATUS read_gpt_partitions(struct gpt_disk *disk)
 		error(L"Failed to read GPT partitions: %r\n", ret);
 		goto free_partitions;
 	}
+	if (crc32(0, disk->partitions, size) != hd->entries_crc32) {
+		ret = EFI_CRC_ERROR;
+		goto free_partitions;
+	}
 	return ret;
 
 free_partitions:
 	FreePool(disk->partitions);
+	disk->partitions = NULL;
 	return ret;
 }
 
-static EFI_STATUS gpt_list_partition_on_disk(EFI_HANDLE handle, struct gpt_disk *disk)
+/* Keep a copy of the used entries, along with the disk they are on */
+static EFI_STATUS gpt_disk_entries(struct gpt_disk *disk)
+{
+	struct gpt_partition *part;
+	struct gpt_partition_interface *entry;
+	UINTN p;
+
+	disk->entries = AllocatePool(disk->gpt_hd.number_of_entries * sizeof(*disk->entries));
+	if (!disk->entries) {
+		FreePool(disk->partitions);
+		disk->partitions = NULL;
+		return EFI_OUT_OF_RESOURCES;
+	}
+
+	disk->nentries = 0;
+	for (p = 0; p < disk->gpt_hd.number_of_entries; p++) {
+		part = (struct gpt_partition *)((UINT8 *)disk->partitions +
+						p * disk->gpt_hd.size_of_entry);
+		if (!CompareGuid(&part->type, &NullGuid))
+			continue;
+
+		entry = &disk->entries[disk->nentries++];
+		CopyMem(&entry->part, part, sizeof(*part));
+		entry->bio = disk->bio;
+		entry->dio = disk->dio;
+		entry->media_id = disk->bio->Media->MediaId;
+	}
+
+	FreePool(disk->partitions);
+	disk->partitions = NULL;
+	return EFI_SUCCESS;
+}
+
+/* Read and validate the header at @lba and its entry array */
+static EFI_STATUS read_gpt_table(struct gpt_disk *disk, EFI_LBA lba)
 {
 	EFI_STATUS ret;
 
+	ret = read_gpt_header(disk, lba);
+	if (EFI_ERROR(ret))
+		return ret;
+	return read_gpt_partitions(disk);
+}
+
+static EFI_STATUS gpt_list_partition_on_disk(EFI_HANDLE handle, struct gpt_disk *disk)
+{
+	EFI_STATUS ret, primary_ret;
+	UINT64 start;
+
+	ZeroMem(disk, sizeof(*disk));
+
 	ret = uefi_call_wrapper(BS->HandleProtocol, 3, handle, &BlockIoProtocol, (VOID *)&disk->bio);
 	if (EFI_ERROR(ret)) {
 		error(L"Failed to get block io protocol: %r\n", ret);
@@ -144,33 +260,122 @@ static EFI_STATUS gpt_list_partition_on_disk(EFI_HANDLE handle, struct gpt_disk
 		return EFI_NOT_FOUND;
 
 	ret = uefi_call_wrapper(BS->HandleProtocol, 3, handle, &DiskIoProtocol, (VOID *)&disk->dio);
+	if (EFI_ERROR(ret)) {
+		/* In fast boot mode, only the ESP device is connected */
+		uefi_call_wrapper(BS->ConnectController, 4, handle, NULL, NULL, FALSE);
+		ret = uefi_call_wrapper(BS->HandleProtocol, 3, handle, &DiskIoProtocol, (VOID *)&disk->dio);
+	}
 	if (EFI_ERROR(ret)) {
 		error(L"Failed to get disk io protocol: %r\n", ret);
 		return ret;
 	}
 
-	ret = read_gpt_header(disk);
+	start = get_current_time_us();
+	ret = read_gpt_table(disk, 1);
 	if (EFI_ERROR(ret)) {
-		error(L"Failed to read GPT header: %r\n", ret);
-		return ret;
+		/* The backup table lives at the end of the disk, its
+		 * location in a corrupted primary header can't be
+		 * trusted. */
+		primary_ret = ret;
+		ret = read_gpt_table(disk, disk->bio->Media->LastBlock);
+		if (EFI_ERROR(ret)) {
+			if (primary_ret != EFI_NOT_FOUND || ret != EFI_NOT_FOUND) {
+				error(L"No valid GPT on disk: primary %r, backup %r\n", primary_ret, ret);
+				ncorrupted++;
+			}
+			return ret;
+		}
+		warning(L"Primary GPT invalid (%r), using the backup GPT\n", primary_ret);
+		disk->backup = TRUE;
 	}
-	if (!is_gpt_device(&disk->gpt_hd))
-		return EFI_NOT_FOUND;
-	ret = read_gpt_partitions(disk);
-	if (EFI_ERROR(ret)) {
-		error(L"Failed to read GPT partitions: %r\n", ret);
-		return ret;
+	debug(L"GPT with %d entries validated in %ld us\n",
+	      disk->gpt_hd.number_of_entries, get_current_time_us() - start);
+
+	return gpt_disk_entries(disk);
+}
+
+static UINT32 hash_bytes(const VOID *data, UINTN len)
+{
+	const UINT8 *p = data;
+	UINT32 h = 2166136261U;
+
+	while (len--)
+		h = (h ^ *p++) * 16777619U;
+	return h;
+}
+
+static UINT32 hash_label(const CHAR16 *label)
+{
+	return hash_bytes(label, StrLen(label) * sizeof(*label));
+}
+
+static UINT32 hash_guid(const EFI_GUID *guid)
+{
+	return hash_bytes(guid, sizeof(*guid));
+}
+
+static void index_free(struct gpt_index *index)
+{
+	if (index->slots)
+		FreePool(index->slots);
+	index->slots = NULL;
+	index->size = 0;
+}
+
+/* Entries inserted first are found first, so the first of several
+ * partitions sharing a key wins, as with a linear scan. */
+static void index_insert(struct gpt_index *index, UINT32 hash,
+			 struct gpt_partition_interface *entry)
+{
+	UINTN i = hash & (index->size - 1);
+
+	while (index->slots[i])
+		i = (i + 1) & (index->size - 1);
+	index->slots[i] = entry;
+}
+
+static EFI_STATUS gpt_build_index(void)
+{
+	struct gpt_partition_interface *entry;
+	UINTN size = 16;
+	UINTN i, p;
+
+	index_free(&by_label);
+	index_free(&by_guid);
+	index_free(&by_type);
+
+	while (size < 2 * npart)
+		size <<= 1;
+
+	by_label.slots = AllocateZeroPool(size * sizeof(*by_label.slots));
+	by_guid.slots = AllocateZeroPool(size * sizeof(*by_guid.slots));
+	by_type.slots = AllocateZeroPool(size * sizeof(*by_type.slots));
+	if (!by_label.slots || !by_guid.slots || !by_type.slots) {
+		index_free(&by_label);
+		index_free(&by_guid);
+		index_free(&by_type);
+		return EFI_OUT_OF_RESOURCES;
 	}
+	by_label.size = by_guid.size = by_type.size = size;
+
+	for (i = 0; i < ndisk; i++)
+		for (p = 0; p < disks[i].nentries; p++) {
+			entry = &disks[i].entries[p];
+			if (entry->part.name[0])
+				index_insert(&by_label, hash_label(entry->part.name), entry);
+			index_insert(&by_guid, hash_guid(&entry->part.unique), entry);
+			index_insert(&by_type, hash_guid(&entry->part.type), entry);
+		}
 	return EFI_SUCCESS;
 }
 
-static EFI_STATUS gpt_cache_partition(void)
+static EFI_STATUS gpt_scan_start(void)
 {
 	EFI_STATUS ret;
-	EFI_HANDLE *handles;
 	UINTN buf_size = 0;
-	UINTN nb_io;
-	UINTN i;
+
+	if (disks)
+		return EFI_SUCCESS;
 
 	ret = uefi_call_wrapper(BS->LocateHandle, 5, ByProtocol, &BlockIoProtocol, NULL, &buf_size, NULL);
 	if (ret != EFI_BUFFER_TOO_SMALL) {
@@ -191,79 +396,285 @@ static EFI_STATUS gpt_cache_partition(void)
 		goto free_handles;
 	}
 
-	nb_io = buf_size / sizeof(*handles);
-	if (!nb_io) {
+	nhandles = buf_size / sizeof(*handles);
+	if (!nhandles) {
 		ret = EFI_NOT_FOUND;
 		error(L"No block io protocol found\n");
 		goto free_handles;
 	}
-	debug(L"Found %d block io protocols\n", nb_io);
+	debug(L"Found %d block io protocols\n", nhandles);
 
-	disks = AllocatePool(nb_io * sizeof(*disks));
+	disks = AllocateZeroPool(nhandles * sizeof(*disks));
 	if (!disks) {
 		ret = EFI_OUT_OF_RESOURCES;
 		error(L"Failed to allocate handles: %r\n", ret);
 		goto free_handles;
 	}
 
-	for (i = 0; i < nb_io; i++) {
-		ret = gpt_list_partition_on_disk(handles[i], &disks[ndisk]);
-		if (EFI_ERROR(ret))
-			continue;
-		debug(L"Disk %d, adding %d gpt partitions\n", ndisk, disks[ndisk].gpt_hd.number_of_entries);
-		npart += disks[ndisk].gpt_hd.number_of_entries;
-		ndisk++;
+	scanned = 0;
+	ret = gpt_build_index();
+	if (EFI_ERROR(ret)) {
+		FreePool(disks);
+		disks = NULL;
+		goto free_handles;
 	}
-	ret = EFI_SUCCESS;
-	debug(L"Found %d disk with %d partitions\n", ndisk, npart);
+	return EFI_SUCCESS;
 
 free_handles:
 	FreePool(handles);
+	handles = NULL;
+	nhandles = 0;
+	return ret;
+}
+
+/* Parse the next block device, returns FALSE once all of them have
+ * been. Must be called at TPL_CALLBACK. */
+static BOOLEAN gpt_scan_next(void)
+{
+	EFI_STATUS ret;
+
+	if (scanned == nhandles)
+		return FALSE;
+
+	ret = gpt_list_partition_on_disk(handles[scanned++], &disks[ndisk]);
+	if (!EFI_ERROR(ret)) {
+		debug(L"Disk %d, adding %d gpt partitions\n", ndisk, disks[ndisk].nentries);
+		npart += disks[ndisk].nentries;
+		ndisk++;
+		ret = gpt_build_index();
+		if (EFI_ERROR(ret))
+			error(L"Failed to build partition index: %r\n", ret);
+	}
+
+	if (scanned == nhandles)
+		debug(L"Found %d disk with %d partitions\n", ndisk, npart);
+	return TRUE;
+}
+
+static EFIAPI VOID gpt_scan_notify(EFI_EVENT event, VOID *context)
+{
+	if (gpt_scan_next())
+		return;
+
+	uefi_call_wrapper(BS->SetTimer, 3, event, TimerCancel, 0);
+	uefi_call_wrapper(BS->CloseEvent, 1, event);
+	scan_event = NULL;
+}
+
+EFI_STATUS gpt_scan_background(void)
+{
+	EFI_STATUS ret;
+	EFI_TPL tpl;
+
+	tpl = uefi_call_wrapper(BS->RaiseTPL, 1, TPL_CALLBACK);
+	ret = gpt_scan_start();
+	uefi_call_wrapper(BS->RestoreTPL, 1, tpl);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	if (scan_event || scanned == nhandles)
+		return EFI_SUCCESS;
+
+	ret = uefi_call_wrapper(BS->CreateEvent, 5, EVT_TIMER | EVT_NOTIFY_SIGNAL, TPL_CALLBACK,
+				gpt_scan_notify, NULL, &scan_event);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to create GPT scan event: %r\n", ret);
+		scan_event = NULL;
+		return ret;
+	}
+
+	ret = uefi_call_wrapper(BS->SetTimer, 3, scan_event, TimerPeriodic, GPT_SCAN_PERIOD);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to start GPT scan timer: %r\n", ret);
+		uefi_call_wrapper(BS->CloseEvent, 1, scan_event);
+		scan_event = NULL;
+	}
+	return ret;
+}
+
+static EFI_STATUS gpt_scan_all(void)
+{
+	EFI_STATUS ret;
+	EFI_TPL tpl;
+
+	tpl = uefi_call_wrapper(BS->RaiseTPL, 1, TPL_CALLBACK);
+	ret = gpt_scan_start();
+	if (!EFI_ERROR(ret))
+		while (gpt_scan_next())
+			;
+	uefi_call_wrapper(BS->RestoreTPL, 1, tpl);
 	return ret;
 }
 
 void gpt_free_cache(void)
 {
 	UINTN i;
+	EFI_TPL tpl;
+
 	if (!disks)
 		return;
 
+	tpl = uefi_call_wrapper(BS->RaiseTPL, 1, TPL_CALLBACK);
+	if (scan_event) {
+		uefi_call_wrapper(BS->SetTimer, 3, scan_event, TimerCancel, 0);
+		uefi_call_wrapper(BS->CloseEvent, 1, scan_event);
+		scan_event = NULL;
+	}
+
+	index_free(&by_label);
+	index_free(&by_guid);
+	index_free(&by_type);
 	for (i = 0; i < ndisk; i++)
-		FreePool(disks[i].partitions);
+		FreePool(disks[i].entries);
 	FreePool(disks);
+	FreePool(handles);
 	disks = NULL;
+	handles = NULL;
+	nhandles = 0;
+	scanned = 0;
 	ndisk = 0;
 	npart = 0;
+	ncorrupted = 0;
+	uefi_call_wrapper(BS->RestoreTPL, 1, tpl);
 }
 
-EFI_STATUS gpt_get_partition_by_label(CHAR16 *label, struct gpt_partition_interface *gpart)
+EFI_STATUS gpt_check_partition_tables(void)
 {
 	EFI_STATUS ret;
 	UINTN i;
 
-	if (!disks) {
-		ret = gpt_cache_partition();
-		if (EFI_ERROR(ret))
-			return ret;
-	}
+	ret = gpt_scan_all();
+	if (EFI_ERROR(ret))
+		return ret;
 
-	for (i = 0; i < ndisk; i++) {
-		UINTN p;
-		for (p = 0; p < disks[i].gpt_hd.number_of_entries; p++) {
-			struct gpt_partition *part;
+	for (i = 0; i < ndisk; i++)
+		if (disks[i].backup)
+			warning(L"Disk %d is running on its backup GPT\n", i);
 
-			part = &disks[i].partitions[p];
-			if (!CompareGuid(&part->type, &NullGuid) || StrCmp(label, part->name))
-				continue;
+	if (!ndisk)
+		return ncorrupted ? EFI_VOLUME_CORRUPTED : EFI_NOT_FOUND;
+	return EFI_SUCCESS;
+}
 
-			debug(L"Found label %s in partition %d\n", label, i + 1);
-			CopyMem(&gpart->part, part, sizeof(*part));
-			gpart->bio = disks[i].bio;
-			gpart->dio = disks[i].dio;
-			return EFI_SUCCESS;
-		}
+static struct gpt_partition_interface *index_find_label(const VOID *label)
+{
+	struct gpt_partition_interface *entry;
+	UINTN i;
+
+	if (!by_label.size)
+		return NULL;
+
+	for (i = hash_label(label) & (by_label.size - 1); (entry = by_label.slots[i]);
+	     i = (i + 1) & (by_label.size - 1))
+		if (!StrCmp(label, entry->part.name))
+			return entry;
+	return NULL;
+}
+
+static struct gpt_partition_interface *index_find_guid(struct gpt_index *index, const EFI_GUID *guid,
+						       BOOLEAN type)
+{
+	struct gpt_partition_interface *entry;
+	UINTN i;
+
+	if (!index->size)
+		return NULL;
+
+	for (i = hash_guid(guid) & (index->size - 1); (entry = index->slots[i]);
+	     i = (i + 1) & (index->size - 1))
+		if (!CompareGuid((EFI_GUID *)guid, type ? &entry->part.type : &entry->part.unique))
+			return entry;
+	return NULL;
+}
+
+static struct gpt_partition_interface *index_find_unique(const VOID *guid)
+{
+	struct gpt_partition_interface *entry;
+	EFI_GUID swapped;
+
+	entry = index_find_guid(&by_guid, guid, FALSE);
+	if (entry)
+		return entry;
+
+	/* Workaround for old installers which incorrectly wrote GUIDs
+	 * strings as little-endian */
+	copy_and_swap_guid(&swapped, guid);
+	return index_find_guid(&by_guid, &swapped, FALSE);
+}
+
+static struct gpt_partition_interface *index_find_type(const VOID *guid)
+{
+	return index_find_guid(&by_type, guid, TRUE);
+}
+
+/* Look @key up, parsing more disks until it is found */
+static EFI_STATUS gpt_lookup(struct gpt_partition_interface *(*find)(const VOID *key),
+			     const VOID *key, struct gpt_partition_interface **gpart)
+{
+	EFI_STATUS ret;
+	EFI_TPL tpl;
+
+	/* keep the background scan out */
+	tpl = uefi_call_wrapper(BS->RaiseTPL, 1, TPL_CALLBACK);
+	ret = gpt_scan_start();
+	if (!EFI_ERROR(ret)) {
+		do
+			*gpart = find(key);
+		while (!*gpart && gpt_scan_next());
+		ret = *gpart ? EFI_SUCCESS : EFI_NOT_FOUND;
 	}
-	return EFI_NOT_FOUND;
+	uefi_call_wrapper(BS->RestoreTPL, 1, tpl);
+	return ret;
+}
+
+EFI_STATUS gpt_find_partition_by_label(const CHAR16 *label, struct gpt_partition_interface **gpart)
+{
+	EFI_STATUS ret;
+
+	ret = gpt_lookup(index_find_label, label, gpart);
+	if (!EFI_ERROR(ret))
+		debug(L"Found label %s\n", label);
+	return ret;
+}
+
+EFI_STATUS gpt_find_partition_by_guid(const EFI_GUID *guid, struct gpt_partition_interface **gpart)
+{
+	return gpt_lookup(index_find_unique, guid, gpart);
+}
+
+EFI_STATUS gpt_find_partition_by_type(const EFI_GUID *type, struct gpt_partition_interface **gpart)
+{
+	return gpt_lookup(index_find_type, type, gpart);
+}
+
+EFI_STATUS gpt_get_partition_by_label(CHAR16 *label, struct gpt_partition_interface *gpart)
+{
+	struct gpt_partition_interface *entry;
+	EFI_STATUS ret;
+
+	ret = gpt_find_partition_by_label(label, &entry);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	CopyMem(gpart, entry, sizeof(*gpart));
+	return EFI_SUCCESS;
+}
+
+EFI_STATUS gpt_read_partition(struct gpt_partition_interface *gpart, UINT64 offset,
+			      UINTN size, VOID *buf)
+{
+	UINT64 block_size = gpart->bio->Media->BlockSize;
+	UINT64 part_size = (gpart->part.ending_lba + 1 - gpart->part.starting_lba) * block_size;
+	EFI_STATUS ret;
+
+	if (offset > part_size || size > part_size - offset)
+		return EFI_INVALID_PARAMETER;
+
+	ret = uefi_call_wrapper(gpart->dio->ReadDisk, 5, gpart->dio, gpart->media_id,
+				gpart->part.starting_lba * block_size + offset, size, buf);
+	if (EFI_ERROR(ret))
+		error(L"Failed to read partition %s: %r\n", gpart->part.name, ret);
+	return ret;
 }
 
 EFI_STATUS gpt_list_partition(struct gpt_partition_interface **gpartlist, UINTN *part_count)
@@ -271,11 +682,9 @@ EFI_STATUS gpt_list_partition(struct gpt_partition_interface **gpartlist, UINTN
 	EFI_STATUS ret;
 	UINTN i;
 
-	if (!disks) {
-		ret = gpt_cache_partition();
-		if (EFI_ERROR(ret))
-			return ret;
-	}
+	ret = gpt_scan_all();
+	if (EFI_ERROR(ret))
+		return ret;
 
 	*part_count = 0;
 	*gpartlist = AllocatePool(npart * sizeof(struct gpt_partition_interface));
@@ -284,18 +693,11 @@ EFI_STATUS gpt_list_partition(struct gpt_partition_interface **gpartlist, UINTN
 
 	for (i = 0; i < ndisk; i++) {
 		UINTN p;
-		for (p = 0; p < disks[i].gpt_hd.number_of_entries; p++) {
-			struct gpt_partition *part;
-			struct gpt_partition_interface *parti;
-
-			part = &disks[i].partitions[p];
-			if (!CompareGuid(&part->type, &NullGuid) || !part->name[0])
+		for (p = 0; p < disks[i].nentries; p++) {
+			if (!disks[i].entries[p].part.name[0])
 				continue;
-
-			parti = &(*gpartlist)[(*part_count)];
-			parti->bio = disks[i].bio;
-			parti->dio = disks[i].dio;
-			CopyMem(&parti->part, part, sizeof(*part));
+			CopyMem(&(*gpartlist)[(*part_count)], &disks[i].entries[p],
+				sizeof(struct gpt_partition_interface));
 			(*part_count)++;
 		}
 	}
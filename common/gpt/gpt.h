@@ -50,11 +50,28 @@ struct gpt_partition {
 
 struct gpt_partition_interface {
 	struct gpt_partition part;
-	EFI_BLOCK_IO *bio;
+	EFI_BLOCK_IO *bio;		/* of the whole disk */
 	EFI_DISK_IO *dio;
+	UINT32 media_id;
 };
 
+/* Disks are parsed on demand: the gpt_find_* functions parse disks
+ * until the partition is found and return a pointer to the cached
+ * entry, valid until gpt_free_cache() is called. */
+EFI_STATUS gpt_find_partition_by_label(const CHAR16 *label, struct gpt_partition_interface **gpart);
+EFI_STATUS gpt_find_partition_by_guid(const EFI_GUID *guid, struct gpt_partition_interface **gpart);
+EFI_STATUS gpt_find_partition_by_type(const EFI_GUID *type, struct gpt_partition_interface **gpart);
 EFI_STATUS gpt_get_partition_by_label(CHAR16 *label, struct gpt_partition_interface *gpart);
+EFI_STATUS gpt_read_partition(struct gpt_partition_interface *gpart, UINT64 offset,
+			      UINTN size, VOID *buf);
 EFI_STATUS gpt_list_partition(struct gpt_partition_interface **gpartlist, UINTN *part_count);
+void gpt_free_cache(void);
+
+/* Parse the remaining disks from a timer event */
+EFI_STATUS gpt_scan_background(void);
+
+/* Succeeds if at least one disk has a valid GPT, either the primary
+ * or the backup one */
+EFI_STATUS gpt_check_partition_tables(void);
 
 #endif	/* _GPT_H_ */
@@ -38,15 +38,69 @@
 
 #define LOG_TAG_LEN 20
 #define LOG_BUF_SIZE ((10 * 1024))
+#define LOG_RING_SIZE ((16 * 1024))
+#define LOG_LINE_MAX 512
+#define LOG_CONSOLE_MAX 4096
+#define LOG_MAX_WORDS 16
+#define LOG_PAYLOAD_SIZE 512
+#define LOG_STR_MAX 128
+
+/*
+ * Messages are not formatted when they are logged.  A record keeps
+ * the prefix and format pointers, which are string literals, and the
+ * raw argument words as they were pushed by the caller.  The text is
+ * only produced when the log is saved.
+ *
+ * String, GUID and time arguments may not outlive the call so they
+ * are copied in the record payload.  The corresponding words hold an
+ * offset from the record start, flagged in @relocs, so that records
+ * can be moved around.
+ *
+ * Records are bounded: at most LOG_MAX_WORDS argument words, strings
+ * cut to LOG_STR_MAX - 1 characters, LOG_PAYLOAD_SIZE bytes of copied
+ * arguments and LOG_LINE_MAX characters once formatted.  These limits
+ * only apply to the saved log: printed messages are formatted straight
+ * from the caller arguments, up to LOG_CONSOLE_MAX characters.
+ */
+#define LOG_RECORD_TIME 1
+
+struct log_record {
+	UINT16 size;		/* 0 marks the end of the ring */
+	UINT16 relocs;
+	UINT8 level;
+	UINT8 nwords;
+	UINT8 flags;
+	UINT8 pad;
+	UINT32 line;
+	UINT64 time;
+	const CHAR16 *prefix;
+	const void *func;
+	const CHAR16 *fmt;
+	UINTN words[];
+};
 
 static CHAR16 log_tag[LOG_TAG_LEN];
-static UINTN log_line_len = 200;
 static BOOLEAN log_flush_to_variable = FALSE;
 static BOOLEAN log_timestamp = TRUE;
 enum loglevel log_level = LEVEL_DEBUG;
+enum loglevel log_threshold = LEVEL_DEBUG;
 
-static CHAR16 buffer[LOG_BUF_SIZE / sizeof(CHAR16)];
-static CHAR16 *cur = buffer;
+static UINT8 ring[LOG_RING_SIZE] __attribute__((aligned(8)));
+static UINTN ring_head, ring_tail, ring_count;
+
+static struct {
+	struct log_record record;
+	UINTN words[LOG_MAX_WORDS];
+	UINT8 payload[LOG_PAYLOAD_SIZE];
+} scratch __attribute__((aligned(8)));
+
+static CHAR16 line_buffer[LOG_LINE_MAX];
+static CHAR16 console_line[LOG_CONSOLE_MAX];
+
+static void update_threshold(void)
+{
+	log_threshold = log_flush_to_variable ? LEVEL_PROFILE : log_level;
+}
 
 EFI_STATUS log_set_logtag(const CHAR16 *tag)
 {
@@ -56,19 +110,21 @@ EFI_STATUS log_set_logtag(const CHAR16 *tag)
 	return EFI_SUCCESS;
 }
 
-VOID log_set_line_len(UINTN len)
+VOID log_set_line_len(UINTN len __attribute__((__unused__)))
 {
-	log_line_len = len;
+	/* Lines are only formatted on output, nothing to reserve */
 }
 
 VOID log_set_flush_to_var(BOOLEAN b)
 {
 	log_flush_to_variable = b;
+	update_threshold();
 }
 
 VOID log_set_loglevel(enum loglevel level)
 {
 	log_level = level;
+	update_threshold();
 }
 
 VOID log_set_logtimestamp(BOOLEAN b)
@@ -76,42 +132,320 @@ VOID log_set_logtimestamp(BOOLEAN b)
 	log_timestamp = b;
 }
 
-void log(enum loglevel level, const CHAR16 *prefix, const void *func, const INTN line,
-	 const CHAR16* fmt, ...)
+static inline struct log_record *ring_record(UINTN offset)
 {
-	CHAR16 *start = cur;
-	va_list args;
+	return (struct log_record *)&ring[offset];
+}
+
+/* Step over the end of ring marker or the unused tail of the ring */
+static UINTN ring_wrap(UINTN offset)
+{
+	if (offset + sizeof(struct log_record) > LOG_RING_SIZE
+	    || ring_record(offset)->size == 0)
+		return 0;
+	return offset;
+}
+
+static void ring_evict(void)
+{
+	ring_head += ring_record(ring_head)->size;
+	if (--ring_count)
+		ring_head = ring_wrap(ring_head);
+}
+
+static struct log_record *ring_reserve(UINTN size)
+{
+	struct log_record *r;
+
+	if (ring_tail + size > LOG_RING_SIZE) {
+		while (ring_count && ring_head >= ring_tail)
+			ring_evict();
+		if (ring_tail + sizeof(struct log_record) <= LOG_RING_SIZE)
+			ring_record(ring_tail)->size = 0;
+		ring_tail = 0;
+	}
+
+	while (ring_count && ring_head >= ring_tail
+	       && ring_head < ring_tail + size)
+		ring_evict();
+	if (!ring_count)
+		ring_head = ring_tail;
+
+	r = ring_record(ring_tail);
+	ring_tail += size;
+	ring_count++;
+	return r;
+}
+
+static void *payload_alloc(UINTN *used, UINTN size)
+{
+	void *p;
+
+	if (*used + size > LOG_PAYLOAD_SIZE)
+		return NULL;
+	p = &scratch.payload[*used];
+	*used += ALIGN_UP(size, sizeof(UINTN));
+	return p;
+}
+
+static BOOLEAN push_word(UINTN word, BOOLEAN reloc)
+{
+	struct log_record *r = &scratch.record;
+
+	if (r->nwords == LOG_MAX_WORDS)
+		return FALSE;
+	if (reloc)
+		r->relocs |= 1 << r->nwords;
+	scratch.words[r->nwords++] = word;
+	return TRUE;
+}
+
+static BOOLEAN push_word64(UINT64 value)
+{
+	if (sizeof(UINTN) == sizeof(UINT64))
+		return push_word((UINTN)value, FALSE);
+	return push_word((UINTN)value, FALSE)
+		&& push_word((UINTN)(value >> 32), FALSE);
+}
+
+/* Keep a copy of @size bytes at @src, the record offset is fixed up later */
+static BOOLEAN push_copy(UINTN *used, const void *src, UINTN size)
+{
+	void *dst;
+
+	if (!src)
+		return push_word(0, FALSE);
+
+	dst = payload_alloc(used, size);
+	if (!dst)
+		return push_word(0, FALSE);
+
+	CopyMem(dst, (void *)src, size);
+	return push_word((UINT8 *)dst - scratch.payload, TRUE);
+}
+
+/* Same as push_copy() for a CHAR8 or CHAR16 string of at most LOG_STR_MAX characters */
+static BOOLEAN push_string(UINTN *used, const void *str, UINTN char_size)
+{
+	UINT8 *dst;
+	UINTN len;
 
-	va_start(args, fmt);
+	if (!str)
+		return push_word(0, FALSE);
 
-	if (log_timestamp) {
-		UINT64 time = get_current_time_us();
+	for (len = 0; len < LOG_STR_MAX - 1; len++)
+		if (char_size == 1 ? !((CHAR8 *)str)[len] : !((CHAR16 *)str)[len])
+			break;
+
+	dst = payload_alloc(used, (len + 1) * char_size);
+	if (!dst)
+		return push_word(char_size == 1 ? (UINTN)"(truncated)" :
+				 (UINTN)L"(truncated)", FALSE);
+
+	CopyMem(dst, (void *)str, len * char_size);
+	ZeroMem(dst + len * char_size, char_size);
+	return push_word(dst - scratch.payload, TRUE);
+}
+
+/*
+ * Walk @fmt with the same rules as the gnu-efi _Print() and save the
+ * arguments it consumes.  Returns the payload size.
+ */
+static UINTN capture_args(const CHAR16 *fmt, va_list args)
+{
+	BOOLEAN is_long, more = TRUE;
+	UINTN used = 0;
+
+	for (; more && *fmt; fmt++) {
+		if (*fmt != '%')
+			continue;
+
+		is_long = FALSE;
+		for (fmt++; *fmt; fmt++) {
+			if (*fmt == '*')
+				more = push_word(va_arg(args, UINTN), FALSE);
+			else if (*fmt == 'l')
+				is_long = TRUE;
+			else if (*fmt != '-' && *fmt != ',' && *fmt != '.'
+				 && (*fmt < '0' || *fmt > '9'))
+				break;
+		}
+
+		switch (*fmt) {
+		case '\0':
+			return used;
+		case 'd':
+		case 'u':
+		case 'x':
+		case 'X':
+			if (is_long)
+				more = push_word64(va_arg(args, UINT64));
+			else
+				more = push_word(va_arg(args, UINT32), FALSE);
+			break;
+		case 'c':
+		case 'p':
+		case 'r':
+		case 'D':
+			more = push_word(va_arg(args, UINTN), FALSE);
+			break;
+		case 's':
+			more = push_string(&used, va_arg(args, CHAR16 *), sizeof(CHAR16));
+			break;
+		case 'a':
+			more = push_string(&used, va_arg(args, CHAR8 *), sizeof(CHAR8));
+			break;
+		case 'g':
+			more = push_copy(&used, va_arg(args, EFI_GUID *), sizeof(EFI_GUID));
+			break;
+		case 't':
+			more = push_copy(&used, va_arg(args, EFI_TIME *), sizeof(EFI_TIME));
+			break;
+		default:
+			/* '%' and the attribute changes take no argument */
+			break;
+		}
+	}
+
+	return used;
+}
+
+/*
+ * Build the record in the scratch area, with the payload moved right
+ * after the used words and the payload offsets turned into record
+ * offsets.
+ */
+static struct log_record *capture(enum loglevel level, const CHAR16 *prefix,
+				  const void *func, const INTN line, UINT64 time,
+				  const CHAR16 *fmt, va_list args)
+{
+	struct log_record *r = &scratch.record;
+	UINTN payload_size, offset, i;
+
+	r->relocs = 0;
+	r->level = level;
+	r->nwords = 0;
+	r->flags = 0;
+	r->line = line;
+	r->prefix = prefix;
+	r->func = func;
+	r->fmt = fmt;
+	r->time = time;
+	if (log_timestamp)
+		r->flags |= LOG_RECORD_TIME;
+
+	payload_size = capture_args(fmt, args);
+
+	offset = sizeof(*r) + r->nwords * sizeof(UINTN);
+	for (i = 0; i < r->nwords; i++)
+		if (r->relocs & (1 << i))
+			scratch.words[i] += offset;
+	if (payload_size)
+		CopyMem((UINT8 *)r + offset, scratch.payload, payload_size);
+
+	r->size = ALIGN_UP(offset + payload_size, 8);
+	return r;
+}
+
+/* Timestamp and prefix of a message, @size is in bytes */
+static UINTN format_header(CHAR16 *buf, UINTN size, BOOLEAN stamp, UINT64 time,
+			   const CHAR16 *prefix, const void *func, const INTN line)
+{
+	UINTN len = 0;
+
+	if (stamp) {
 		UINT64 sec = time / 1000000;
 		UINT64 usec = time - (sec * 1000000);
 
-		cur += SPrint(cur, sizeof(buffer) - sizeof(CHAR16) * (cur - buffer), L"[%5ld.%06ld] ",
-			      sec, usec);
+		len += SPrint(buf, size, L"[%5ld.%06ld] ", sec, usec);
 	}
-	cur += SPrint(cur, sizeof(buffer) - sizeof(CHAR16) * (cur - buffer), (CHAR16 *)prefix,
+	len += SPrint(buf + len, size - len * sizeof(CHAR16), (CHAR16 *)prefix,
 		      func, line);
-	cur += VSPrint(cur, sizeof(buffer) - sizeof(CHAR16) * (cur - buffer), (CHAR16 *)fmt,
-		       args);
-	if (((cur - buffer) + log_line_len) * sizeof(CHAR16) >= LOG_BUF_SIZE)
-		cur = buffer;
+	return len;
+}
 
+static UINTN format_record(CHAR16 *buf, UINTN size, struct log_record *r)
+{
+	UINTN w[LOG_MAX_WORDS];
+	UINTN i, len;
 
-	if (log_level >= level)
-		Print(L"%s %s", log_tag, start);
+	for (i = 0; i < LOG_MAX_WORDS; i++) {
+		w[i] = i < r->nwords ? r->words[i] : 0;
+		if (r->relocs & (1 << i))
+			w[i] += (UINTN)r;
+	}
 
-	va_end (args);
+	len = format_header(buf, size, r->flags & LOG_RECORD_TIME, r->time,
+			    r->prefix, r->func, r->line);
+	len += SPrint(buf + len, size - len * sizeof(CHAR16), (CHAR16 *)r->fmt,
+		      w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7],
+		      w[8], w[9], w[10], w[11], w[12], w[13], w[14], w[15]);
+	return len;
 }
 
+void log(enum loglevel level, const CHAR16 *prefix, const void *func, const INTN line,
+	 const CHAR16* fmt, ...)
+{
+	struct log_record *r;
+	UINT64 time = log_timestamp ? get_current_time_us() : 0;
+	UINTN len;
+	va_list args;
+
+	if (log_flush_to_variable) {
+		va_start(args, fmt);
+		r = capture(level, prefix, func, line, time, fmt, args);
+		va_end(args);
+		CopyMem(ring_reserve(r->size), r, r->size);
+	}
+
+	if (log_level >= level) {
+		len = format_header(console_line, sizeof(console_line), log_timestamp,
+				    time, prefix, func, line);
+		va_start(args, fmt);
+		VSPrint(console_line + len, sizeof(console_line) - len * sizeof(CHAR16),
+			(CHAR16 *)fmt, args);
+		va_end(args);
+		Print(L"%s %s", log_tag, console_line);
+	}
+}
+
+/*
+ * Format the recorded messages and save the most recent LOG_BUF_SIZE
+ * bytes of text, starting on a line boundary.
+ */
 void log_save_to_variable(CHAR16 *varname, EFI_GUID *guid)
 {
 	EFI_STATUS ret;
-	if (log_flush_to_variable && varname && guid) {
-		ret = LibSetVariable(varname, guid, (cur - buffer) * sizeof(CHAR16), buffer);
-		if (EFI_ERROR(ret))
-			warning(L"Save log into EFI variable failed\n");
+	CHAR16 *text, *start;
+	UINTN size, len = 0, offset, i;
+
+	if (!log_flush_to_variable || !varname || !guid || !ring_count)
+		return;
+
+	size = ring_count * sizeof(line_buffer);
+	text = AllocatePool(size);
+	if (!text) {
+		warning(L"Save log into EFI variable failed\n");
+		return;
 	}
+
+	for (i = 0, offset = ring_head; i < ring_count; i++) {
+		offset = ring_wrap(offset);
+		len += format_record(text + len, sizeof(line_buffer), ring_record(offset));
+		offset += ring_record(offset)->size;
+	}
+
+	start = text;
+	if (len * sizeof(CHAR16) > LOG_BUF_SIZE) {
+		start = text + len - LOG_BUF_SIZE / sizeof(CHAR16);
+		for (i = 0; start + i < text + len && start[i] != '\n'; i++)
+			;
+		if (start + i < text + len)
+			start += i + 1;
+	}
+
+	ret = LibSetVariable(varname, guid, (text + len - start) * sizeof(CHAR16), start);
+	if (EFI_ERROR(ret))
+		warning(L"Save log into EFI variable failed\n");
+	FreePool(text);
 }
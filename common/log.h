@@ -41,38 +41,46 @@ enum loglevel {
 	LEVEL_PROFILE,
 };
 
-#define LOGLEVEL(level)	(log_level >= LEVEL_##level)
+/*
+ * Messages above CONFIG_LOG_COMPILE_LEVEL are compiled out.  Below it,
+ * a message that is neither printed nor kept for
+ * log_save_to_variable() only costs a comparison: log() is not called
+ * and its arguments are not evaluated.
+ */
+#ifndef CONFIG_LOG_COMPILE_LEVEL
+#define CONFIG_LOG_COMPILE_LEVEL LEVEL_PROFILE
+#endif
+
+#define LOGLEVEL(level)	(LEVEL_##level <= CONFIG_LOG_COMPILE_LEVEL && \
+			 log_level >= LEVEL_##level)
 extern enum loglevel log_level;
 
+/* Highest level either printed or recorded */
+#define log_enabled(level) ((level) <= CONFIG_LOG_COMPILE_LEVEL && \
+			    (level) <= log_threshold)
+extern enum loglevel log_threshold;
+
+/*
+ * @prefix and @fmt must be string literals, or at least outlive the
+ * log, as they are only formatted when the message is printed or
+ * saved.
+ */
 void log(enum loglevel level, const CHAR16 *prefix, const void *func, const INTN line,
 	 const CHAR16* fmt, ...);
 
 void log_save_to_variable(CHAR16 *varname, EFI_GUID *guid);
 
-#define profile(...) do { \
-		log(LEVEL_PROFILE, L"PROFILE [%a:%d] ", \
-		    __func__, __LINE__, __VA_ARGS__); \
+#define LOG(level, tag, ...) do { \
+		if (log_enabled(LEVEL_##level)) \
+			log(LEVEL_##level, tag L" [%a:%d] ", \
+			    __func__, __LINE__, __VA_ARGS__); \
 	} while (0)
 
-#define debug(...) do { \
-		log(LEVEL_DEBUG, L"DEBUG [%a:%d] ", \
-		    __func__, __LINE__, __VA_ARGS__); \
-	} while (0)
-
-#define info(...) do { \
-		log(LEVEL_INFO, L"INFO [%a:%d] ", \
-		    __func__, __LINE__, __VA_ARGS__); \
-	} while (0)
-
-#define warning(...) do { \
-		log(LEVEL_WARNING, L"WARNING [%a:%d] ", \
-		    __func__, __LINE__, __VA_ARGS__); \
-	} while (0)
-
-#define error(...) do { \
-		log(LEVEL_ERROR, L"ERROR [%a:%d] ", \
-		    __func__, __LINE__, __VA_ARGS__); \
-	} while (0)
+#define profile(...) LOG(PROFILE, L"PROFILE", __VA_ARGS__)
+#define debug(...) LOG(DEBUG, L"DEBUG", __VA_ARGS__)
+#define info(...) LOG(INFO, L"INFO", __VA_ARGS__)
+#define warning(...) LOG(WARNING, L"WARNING", __VA_ARGS__)
+#define error(...) LOG(ERROR, L"ERROR", __VA_ARGS__)
 
 /*
  * Returns EFI_INVALID_PARAMETER if tag is too long
@@ -0,0 +1,523 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <efi.h>
+#include <efilib.h>
+#include "lz4.h"
+
+#define FLG_VERSION_MASK	0xC0
+#define FLG_VERSION		0x40
+#define FLG_BLOCK_INDEP		(1 << 5)
+#define FLG_BLOCK_CHECKSUM	(1 << 4)
+#define FLG_CONTENT_SIZE	(1 << 3)
+#define FLG_CONTENT_CHECKSUM	(1 << 2)
+#define FLG_RESERVED		(1 << 1)
+#define FLG_DICT_ID		(1 << 0)
+#define BD_RESERVED		0x8F
+#define BLOCK_UNCOMPRESSED	0x80000000
+
+#define XXH_PRIME1	2654435761U
+#define XXH_PRIME2	2246822519U
+#define XXH_PRIME3	3266489917U
+#define XXH_PRIME4	668265263U
+#define XXH_PRIME5	374761393U
+
+static inline UINT32 read_le32(const UINT8 *p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((UINT32)p[3] << 24);
+}
+
+static inline UINT32 rotl32(UINT32 x, int r)
+{
+	return (x << r) | (x >> (32 - r));
+}
+
+static inline UINT32 xxh32_round(UINT32 acc, const UINT8 *p)
+{
+	acc += read_le32(p) * XXH_PRIME2;
+	return rotl32(acc, 13) * XXH_PRIME1;
+}
+
+void xxh32_init(struct xxh32_state *state, UINT32 seed)
+{
+	state->v[0] = seed + XXH_PRIME1 + XXH_PRIME2;
+	state->v[1] = seed + XXH_PRIME2;
+	state->v[2] = seed;
+	state->v[3] = seed - XXH_PRIME1;
+	state->total = 0;
+	state->memsize = 0;
+}
+
+void xxh32_update(struct xxh32_state *state, const VOID *buf, UINTN len)
+{
+	const UINT8 *p = buf;
+	UINTN n;
+
+	state->total += len;
+
+	if (state->memsize) {
+		n = sizeof(state->mem) - state->memsize;
+		if (n > len)
+			n = len;
+		CopyMem(state->mem + state->memsize, p, n);
+		state->memsize += n;
+		p += n;
+		len -= n;
+		if (state->memsize < sizeof(state->mem))
+			return;
+		state->v[0] = xxh32_round(state->v[0], state->mem);
+		state->v[1] = xxh32_round(state->v[1], state->mem + 4);
+		state->v[2] = xxh32_round(state->v[2], state->mem + 8);
+		state->v[3] = xxh32_round(state->v[3], state->mem + 12);
+		state->memsize = 0;
+	}
+
+	for (; len >= 16; p += 16, len -= 16) {
+		state->v[0] = xxh32_round(state->v[0], p);
+		state->v[1] = xxh32_round(state->v[1], p + 4);
+		state->v[2] = xxh32_round(state->v[2], p + 8);
+		state->v[3] = xxh32_round(state->v[3], p + 12);
+	}
+
+	CopyMem(state->mem, p, len);
+	state->memsize = len;
+}
+
+UINT32 xxh32_digest(struct xxh32_state *state)
+{
+	const UINT8 *p = state->mem;
+	UINTN len = state->memsize;
+	UINT32 h;
+
+	if (state->total >= 16)
+		h = rotl32(state->v[0], 1) + rotl32(state->v[1], 7) +
+			rotl32(state->v[2], 12) + rotl32(state->v[3], 18);
+	else
+		h = state->v[2] + XXH_PRIME5;
+	h += (UINT32)state->total;
+
+	for (; len >= 4; p += 4, len -= 4)
+		h = rotl32(h + read_le32(p) * XXH_PRIME3, 17) * XXH_PRIME4;
+	for (; len; p++, len--)
+		h = rotl32(h + *p * XXH_PRIME5, 11) * XXH_PRIME1;
+
+	h ^= h >> 15;
+	h *= XXH_PRIME2;
+	h ^= h >> 13;
+	h *= XXH_PRIME3;
+	h ^= h >> 16;
+	return h;
+}
+
+UINT32 xxh32(const VOID *buf, UINTN len, UINT32 seed)
+{
+	struct xxh32_state state;
+
+	xxh32_init(&state, seed);
+	xxh32_update(&state, buf, len);
+	return xxh32_digest(&state);
+}
+
+/* Copy @len bytes by 8 bytes words, up to 7 bytes past @dst + @len
+ * are written */
+static inline void wild_copy(UINT8 *dst, const UINT8 *src, UINTN len)
+{
+	UINT8 *end = dst + len;
+
+	do {
+		__builtin_memcpy(dst, src, 8);
+		dst += 8;
+		src += 8;
+	} while (dst < end);
+}
+
+static inline EFI_STATUS read_length(const UINT8 **ip, const UINT8 *iend, UINTN *len)
+{
+	UINT8 b;
+
+	do {
+		if (*ip >= iend)
+			return EFI_INVALID_PARAMETER;
+		b = *(*ip)++;
+		*len += b;
+	} while (b == 255);
+	return EFI_SUCCESS;
+}
+
+EFI_STATUS lz4_decompress_block(const VOID *src, UINTN src_len,
+				VOID *dst, UINTN *pos, UINTN cap)
+{
+	const UINT8 *ip = src, *iend = ip + src_len;
+	UINT8 *base = dst, *op = base + *pos, *oend = base + cap;
+	UINT8 *match;
+	UINTN lit, ml, offset, dist, i;
+	UINT8 token;
+
+	for (;;) {
+		if (ip >= iend)
+			return EFI_INVALID_PARAMETER;
+		token = *ip++;
+
+		lit = token >> 4;
+		if (lit == 15 && EFI_ERROR(read_length(&ip, iend, &lit)))
+			return EFI_INVALID_PARAMETER;
+		if (lit > (UINTN)(iend - ip) || lit > (UINTN)(oend - op))
+			return EFI_INVALID_PARAMETER;
+		if (lit && (UINTN)(iend - ip) >= lit + 8)
+			wild_copy(op, ip, lit);
+		else
+			CopyMem(op, ip, lit);
+		op += lit;
+		ip += lit;
+
+		/* The last sequence is made of literals only */
+		if (ip == iend)
+			break;
+
+		if (iend - ip < 2)
+			return EFI_INVALID_PARAMETER;
+		offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (!offset || offset > (UINTN)(op - base))
+			return EFI_INVALID_PARAMETER;
+
+		ml = token & 15;
+		if (ml == 15 && EFI_ERROR(read_length(&ip, iend, &ml)))
+			return EFI_INVALID_PARAMETER;
+		ml += 4;
+		if (ml > (UINTN)(oend - op))
+			return EFI_INVALID_PARAMETER;
+
+		match = op - offset;
+		if (offset >= 8) {
+			wild_copy(op, match, ml);
+		} else {
+			/* Overlapping match: repeat the @offset bytes
+			 * pattern byte per byte until it is at least 8
+			 * bytes back, then copy by words. */
+			dist = offset * ((8 + offset - 1) / offset);
+			for (i = 0; i < ml && i < dist; i++)
+				op[i] = match[i];
+			if (ml > dist)
+				wild_copy(op + dist, op, ml - dist);
+		}
+		op += ml;
+	}
+
+	*pos = op - base;
+	return EFI_SUCCESS;
+}
+
+BOOLEAN is_lz4_frame(const VOID *data, UINTN size)
+{
+	return size >= sizeof(UINT32) && read_le32(data) == LZ4_FRAME_MAGIC;
+}
+
+void lz4_stream_init(struct lz4_stream *ls, lz4_output_t output, VOID *ctx)
+{
+	ZeroMem(ls, sizeof(*ls));
+	ls->output = output;
+	ls->ctx = ctx;
+	ls->state = LZ4_STREAM_MAGIC;
+	ls->need = sizeof(UINT32);
+}
+
+void lz4_stream_free(struct lz4_stream *ls)
+{
+	if (ls->in)
+		FreePool(ls->in);
+	if (ls->window)
+		FreePool(ls->window);
+	ls->in = NULL;
+	ls->window = NULL;
+	ls->window_size = 0;
+}
+
+static EFI_STATUS lz4_stream_buffers(struct lz4_stream *ls)
+{
+	UINTN window_size = LZ4_HISTORY_SIZE + ls->block_max;
+
+	if (ls->window_size == window_size)
+		return EFI_SUCCESS;
+
+	lz4_stream_free(ls);
+	ls->in = AllocatePool(ls->block_max);
+	ls->window = AllocatePool(window_size + LZ4_WILDCOPY);
+	if (!ls->in || !ls->window) {
+		lz4_stream_free(ls);
+		return EFI_OUT_OF_RESOURCES;
+	}
+	ls->window_size = window_size;
+	return EFI_SUCCESS;
+}
+
+static void lz4_stream_expect(struct lz4_stream *ls, enum lz4_stream_state state, UINTN need)
+{
+	ls->state = state;
+	ls->need = need;
+	ls->have = 0;
+}
+
+static EFI_STATUS lz4_stream_frame_end(struct lz4_stream *ls)
+{
+	if ((ls->flg & FLG_CONTENT_SIZE) && ls->produced != ls->content_size)
+		return EFI_INVALID_PARAMETER;
+	ls->frames++;
+	lz4_stream_expect(ls, LZ4_STREAM_MAGIC, sizeof(UINT32));
+	return EFI_SUCCESS;
+}
+
+/* The frame descriptor is gathered in two steps: FLG and BD first,
+ * which tell the size of the optional fields, then the rest of it. */
+static EFI_STATUS lz4_stream_descriptor(struct lz4_stream *ls)
+{
+	UINT8 bd;
+	UINTN i;
+
+	if (ls->need == 2) {
+		ls->flg = ls->hdr[0];
+		if ((ls->flg & FLG_VERSION_MASK) != FLG_VERSION ||
+		    (ls->flg & FLG_RESERVED))
+			return EFI_INVALID_PARAMETER;
+		if (ls->flg & FLG_DICT_ID)
+			return EFI_UNSUPPORTED;
+		ls->need += ls->flg & FLG_CONTENT_SIZE ? sizeof(UINT64) : 0;
+		ls->need += 1;	/* header checksum */
+		return EFI_SUCCESS;
+	}
+
+	bd = ls->hdr[1];
+	if ((bd & BD_RESERVED) || ((bd >> 4) & 7) < 4)
+		return EFI_INVALID_PARAMETER;
+	if (((xxh32(ls->hdr, ls->need - 1, 0) >> 8) & 0xFF) != ls->hdr[ls->need - 1])
+		return EFI_CRC_ERROR;
+
+	ls->block_max = 1 << (8 + 2 * ((bd >> 4) & 7));
+	ls->content_size = 0;
+	if (ls->flg & FLG_CONTENT_SIZE)
+		for (i = 0; i < sizeof(UINT64); i++)
+			ls->content_size |= (UINT64)ls->hdr[2 + i] << (8 * i);
+
+	ls->window_len = 0;
+	ls->produced = 0;
+	xxh32_init(&ls->content_xxh, 0);
+	lz4_stream_expect(ls, LZ4_STREAM_BLOCK_SIZE, sizeof(UINT32));
+	return lz4_stream_buffers(ls);
+}
+
+static EFI_STATUS lz4_stream_field(struct lz4_stream *ls)
+{
+	UINT32 value = read_le32(ls->hdr);
+
+	switch (ls->state) {
+	case LZ4_STREAM_MAGIC:
+		if (value == LZ4_FRAME_MAGIC)
+			lz4_stream_expect(ls, LZ4_STREAM_DESCRIPTOR, 2);
+		else if ((value & LZ4_SKIPPABLE_MASK) == LZ4_SKIPPABLE_MAGIC)
+			lz4_stream_expect(ls, LZ4_STREAM_SKIP_SIZE, sizeof(UINT32));
+		else
+			return EFI_INVALID_PARAMETER;
+		return EFI_SUCCESS;
+	case LZ4_STREAM_DESCRIPTOR:
+		return lz4_stream_descriptor(ls);
+	case LZ4_STREAM_BLOCK_SIZE:
+		if (!value) {
+			if (ls->flg & FLG_CONTENT_CHECKSUM) {
+				lz4_stream_expect(ls, LZ4_STREAM_CONTENT_CHECKSUM, sizeof(UINT32));
+				return EFI_SUCCESS;
+			}
+			return lz4_stream_frame_end(ls);
+		}
+		ls->block_raw = !!(value & BLOCK_UNCOMPRESSED);
+		ls->block_size = value & ~BLOCK_UNCOMPRESSED;
+		if (!ls->block_size || ls->block_size > ls->block_max)
+			return EFI_INVALID_PARAMETER;
+		ls->state = LZ4_STREAM_BLOCK;
+		ls->in_len = 0;
+		return EFI_SUCCESS;
+	case LZ4_STREAM_BLOCK_CHECKSUM:
+		if (value != ls->block_xxh)
+			return EFI_CRC_ERROR;
+		lz4_stream_expect(ls, LZ4_STREAM_BLOCK_SIZE, sizeof(UINT32));
+		return EFI_SUCCESS;
+	case LZ4_STREAM_CONTENT_CHECKSUM:
+		if (value != xxh32_digest(&ls->content_xxh))
+			return EFI_CRC_ERROR;
+		return lz4_stream_frame_end(ls);
+	case LZ4_STREAM_SKIP_SIZE:
+		ls->skip = value;
+		lz4_stream_expect(ls, LZ4_STREAM_MAGIC, sizeof(UINT32));
+		return EFI_SUCCESS;
+	default:
+		return EFI_INVALID_PARAMETER;
+	}
+}
+
+/* Decode the block at @src into the window, hand it over and keep
+ * the last LZ4_HISTORY_SIZE bytes for the next linked block. */
+static EFI_STATUS lz4_stream_block(struct lz4_stream *ls, const UINT8 *src)
+{
+	UINTN pos = ls->window_len;
+	UINT8 *out = ls->window + ls->window_len;
+	EFI_STATUS ret;
+
+	if (ls->flg & FLG_BLOCK_CHECKSUM)
+		ls->block_xxh = xxh32(src, ls->block_size, 0);
+
+	if (ls->block_raw) {
+		CopyMem(out, src, ls->block_size);
+		pos += ls->block_size;
+	} else {
+		ret = lz4_decompress_block(src, ls->block_size, ls->window, &pos,
+					   ls->window_len + ls->block_max);
+		if (EFI_ERROR(ret))
+			return ret;
+	}
+
+	if (ls->flg & FLG_CONTENT_CHECKSUM)
+		xxh32_update(&ls->content_xxh, out, pos - ls->window_len);
+	ls->produced += pos - ls->window_len;
+
+	ret = ls->output(ls->ctx, out, pos - ls->window_len);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	if (ls->flg & FLG_BLOCK_INDEP)
+		ls->window_len = 0;
+	else if (pos > LZ4_HISTORY_SIZE) {
+		CopyMem(ls->window, ls->window + pos - LZ4_HISTORY_SIZE, LZ4_HISTORY_SIZE);
+		ls->window_len = LZ4_HISTORY_SIZE;
+	} else
+		ls->window_len = pos;
+
+	if (ls->flg & FLG_BLOCK_CHECKSUM)
+		lz4_stream_expect(ls, LZ4_STREAM_BLOCK_CHECKSUM, sizeof(UINT32));
+	else
+		lz4_stream_expect(ls, LZ4_STREAM_BLOCK_SIZE, sizeof(UINT32));
+	return EFI_SUCCESS;
+}
+
+EFI_STATUS lz4_stream_write(struct lz4_stream *ls, const VOID *data, UINTN size)
+{
+	const UINT8 *s = data;
+	UINTN len;
+	EFI_STATUS ret;
+
+	while (size) {
+		if (ls->skip) {
+			len = ls->skip < size ? ls->skip : size;
+			ls->skip -= len;
+			s += len;
+			size -= len;
+			continue;
+		}
+
+		if (ls->state != LZ4_STREAM_BLOCK) {
+			len = ls->need - ls->have;
+			if (len > size)
+				len = size;
+			CopyMem(ls->hdr + ls->have, s, len);
+			ls->have += len;
+			s += len;
+			size -= len;
+			if (ls->have < ls->need)
+				continue;
+			ret = lz4_stream_field(ls);
+			if (EFI_ERROR(ret))
+				return ret;
+			continue;
+		}
+
+		/* Blocks received in one piece are decoded in place */
+		if (!ls->in_len && size >= ls->block_size) {
+			ret = lz4_stream_block(ls, s);
+			if (EFI_ERROR(ret))
+				return ret;
+			s += ls->block_size;
+			size -= ls->block_size;
+			continue;
+		}
+
+		len = ls->block_size - ls->in_len;
+		if (len > size)
+			len = size;
+		CopyMem(ls->in + ls->in_len, s, len);
+		ls->in_len += len;
+		s += len;
+		size -= len;
+		if (ls->in_len < ls->block_size)
+			continue;
+		ls->in_len = 0;
+		ret = lz4_stream_block(ls, ls->in);
+		if (EFI_ERROR(ret))
+			return ret;
+	}
+	return EFI_SUCCESS;
+}
+
+EFI_STATUS lz4_stream_end(struct lz4_stream *ls)
+{
+	if (!ls->frames || ls->state != LZ4_STREAM_MAGIC || ls->have || ls->skip)
+		return EFI_INVALID_PARAMETER;
+	return EFI_SUCCESS;
+}
+
+struct lz4_buffer {
+	UINT8 *dst;
+	UINTN size;
+	UINTN len;
+};
+
+static EFI_STATUS lz4_buffer_output(VOID *ctx, VOID *data, UINTN size)
+{
+	struct lz4_buffer *buf = ctx;
+
+	if (size > buf->size - buf->len)
+		return EFI_BUFFER_TOO_SMALL;
+	CopyMem(buf->dst + buf->len, data, size);
+	buf->len += size;
+	return EFI_SUCCESS;
+}
+
+EFI_STATUS lz4_decompress(const VOID *src, UINTN src_len,
+			  VOID *dst, UINTN dst_size, UINTN *out_len)
+{
+	struct lz4_buffer buf = { dst, dst_size, 0 };
+	struct lz4_stream ls;
+	EFI_STATUS ret;
+
+	lz4_stream_init(&ls, lz4_buffer_output, &buf);
+	ret = lz4_stream_write(&ls, src, src_len);
+	if (!EFI_ERROR(ret))
+		ret = lz4_stream_end(&ls);
+	lz4_stream_free(&ls);
+
+	*out_len = buf.len;
+	return ret;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _LZ4_H_
+#define _LZ4_H_
+
+#include <efi.h>
+
+#define LZ4_FRAME_MAGIC		0x184D2204
+#define LZ4_SKIPPABLE_MAGIC	0x184D2A50	/* low nibble is free */
+#define LZ4_SKIPPABLE_MASK	0xFFFFFFF0
+
+/* Matches can reach 64KB back, into the previous blocks of a frame */
+#define LZ4_HISTORY_SIZE	(64 * 1024)
+/* The block decoder copies by 8 bytes words and can write up to this
+ * many bytes past the end of the decoded data */
+#define LZ4_WILDCOPY		16
+
+struct xxh32_state {
+	UINT32 v[4];
+	UINT64 total;
+	UINT8 mem[16];
+	UINTN memsize;
+};
+
+void xxh32_init(struct xxh32_state *state, UINT32 seed);
+void xxh32_update(struct xxh32_state *state, const VOID *buf, UINTN len);
+UINT32 xxh32_digest(struct xxh32_state *state);
+UINT32 xxh32(const VOID *buf, UINTN len, UINT32 seed);
+
+/*
+ * Decode the LZ4 block @src of @src_len bytes at offset *@pos of
+ * @dst. The bytes before *@pos are the history matches can refer to.
+ * @cap is the size of @dst, which must be followed by LZ4_WILDCOPY
+ * bytes of slack. On success, *@pos is advanced past the decoded data.
+ */
+EFI_STATUS lz4_decompress_block(const VOID *src, UINTN src_len,
+				VOID *dst, UINTN *pos, UINTN cap);
+
+typedef EFI_STATUS (*lz4_output_t)(VOID *ctx, VOID *data, UINTN size);
+
+enum lz4_stream_state {
+	LZ4_STREAM_MAGIC,
+	LZ4_STREAM_DESCRIPTOR,
+	LZ4_STREAM_BLOCK_SIZE,
+	LZ4_STREAM_BLOCK,
+	LZ4_STREAM_BLOCK_CHECKSUM,
+	LZ4_STREAM_CONTENT_CHECKSUM,
+	LZ4_STREAM_SKIP_SIZE,
+};
+
+/* Streaming decoder of LZ4 frames, as produced by the lz4 command
+ * line tool. Input is accepted in slices of any size and the
+ * decompressed data is handed to @output one block at a time.
+ */
+struct lz4_stream {
+	lz4_output_t output;
+	VOID *ctx;
+	enum lz4_stream_state state;
+	UINT8 hdr[15];		/* frame descriptor and small fields */
+	UINTN need;		/* bytes to gather in hdr */
+	UINTN have;		/* bytes already in hdr */
+	UINT8 flg;
+	UINTN block_max;
+	UINT32 block_size;
+	BOOLEAN block_raw;
+	UINT32 block_xxh;
+	UINT8 *in;		/* compressed block split across slices */
+	UINTN in_len;
+	UINT8 *window;		/* history followed by the current block */
+	UINTN window_len;
+	UINTN window_size;
+	UINT64 skip;
+	UINT64 content_size;
+	UINT64 produced;
+	struct xxh32_state content_xxh;
+	UINTN frames;
+};
+
+BOOLEAN is_lz4_frame(const VOID *data, UINTN size);
+void lz4_stream_init(struct lz4_stream *ls, lz4_output_t output, VOID *ctx);
+EFI_STATUS lz4_stream_write(struct lz4_stream *ls, const VOID *data, UINTN size);
+EFI_STATUS lz4_stream_end(struct lz4_stream *ls);
+void lz4_stream_free(struct lz4_stream *ls);
+
+/* Decompress the LZ4 frames of @src into @dst */
+EFI_STATUS lz4_decompress(const VOID *src, UINTN src_len,
+			  VOID *dst, UINTN dst_size, UINTN *out_len);
+
+#endif	/* _LZ4_H_ */
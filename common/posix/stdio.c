@@ -32,34 +32,259 @@
 #include <uefi_utils.h>
 #include <log.h>
 
-int sprintf(char *str, const char *format, ...)
+/*
+ * Native CHAR8 implementation of the gnu-efi _Print() format: %a is a
+ * CHAR8 string, %s a CHAR16 string, %x/%X print upper case digits, %X
+ * is zero padded to 8 digits (16 with 'l'), %r, %g and %t print an
+ * EFI_STATUS, a GUID and a time.  It writes straight into the caller
+ * buffer: no pool allocation and no CHAR16 round trip.
+ */
+
+#define SCRATCH_LEN 64
+
+struct output {
+	char *str;
+	size_t size;
+	size_t len;
+	BOOLEAN error;
+};
+
+struct item {
+	BOOLEAN is_long;
+	BOOLEAN comma;
+	BOOLEAN pad_after;
+	char pad;
+	UINTN width;
+	UINTN max_width;
+};
+
+static const char hex_digits[] = "0123456789ABCDEF";
+
+static inline void put_char(struct output *out, char c)
+{
+	if (out->len + 1 < out->size)
+		out->str[out->len] = c;
+	out->len++;
+}
+
+static void put_padding(struct output *out, struct item *item, UINTN len)
+{
+	for (; len < item->width; len++)
+		put_char(out, item->pad);
+}
+
+static void put_ascii(struct output *out, struct item *item, const CHAR8 *s)
 {
-	va_list args;
 	UINTN len;
-	int ret = -1;
-	CHAR16 *str16;
-	CHAR16 *format16 = stra_to_str((CHAR8 *)format);
 
-	if (!format16)
-		return -1;
+	if (!s)
+		s = (CHAR8 *)"(null)";
+	for (len = 0; len < item->max_width && s[len]; len++)
+		;
 
-	va_start(args, format);
-	str16 = VPoolPrint(format16, args);
-	va_end(args);
+	if (!item->pad_after)
+		put_padding(out, item, len);
+	for (UINTN i = 0; i < len; i++)
+		put_char(out, s[i]);
+	if (item->pad_after)
+		put_padding(out, item, len);
+}
 
-	if (!str16)
-		goto free_format16;
+static void put_wide(struct output *out, struct item *item, const CHAR16 *s)
+{
+	UINTN len;
 
-	len = StrLen(str16);
-	if (str_to_stra((CHAR8 *)str, str16, len) == EFI_SUCCESS) {
-		ret = 0;
-		str[len] = '\0';
+	if (!s) {
+		put_ascii(out, item, NULL);
+		return;
 	}
+	for (len = 0; len < item->max_width && s[len]; len++)
+		;
 
-	FreePool(str16);
-free_format16:
-	FreePool(format16);
-	return ret;
+	if (!item->pad_after)
+		put_padding(out, item, len);
+	for (UINTN i = 0; i < len; i++) {
+		if (s[i] > 0x7F)
+			out->error = TRUE;
+		put_char(out, (char)s[i]);
+	}
+	if (item->pad_after)
+		put_padding(out, item, len);
+}
+
+static void put_hex(struct output *out, struct item *item, UINT64 value)
+{
+	char scratch[SCRATCH_LEN];
+	char *p = scratch + sizeof(scratch);
+
+	*--p = '\0';
+	do {
+		*--p = hex_digits[value & 0xF];
+		value >>= 4;
+	} while (value);
+
+	put_ascii(out, item, (CHAR8 *)p);
+}
+
+static void put_decimal(struct output *out, struct item *item, INT64 value,
+			BOOLEAN is_signed)
+{
+	char scratch[SCRATCH_LEN];
+	char *p = scratch + sizeof(scratch);
+	BOOLEAN negative = is_signed && value < 0;
+	UINT64 v = negative ? -(UINT64)value : (UINT64)value;
+	UINTN digits = 0;
+
+	*--p = '\0';
+	do {
+		if (item->comma && digits && digits % 3 == 0)
+			*--p = ',';
+		*--p = '0' + v % 10;
+		v /= 10;
+		digits++;
+	} while (v);
+	if (negative)
+		*--p = '-';
+
+	put_ascii(out, item, (CHAR8 *)p);
+}
+
+/* %g, %r and %t reuse the gnu-efi CHAR16 helpers on a stack buffer */
+static void put_scratch16(struct output *out, struct item *item, char conv,
+			  va_list *ap)
+{
+	CHAR16 scratch[SCRATCH_LEN];
+
+	switch (conv) {
+	case 'g':
+		GuidToString(scratch, va_arg(*ap, EFI_GUID *));
+		break;
+	case 'r':
+		StatusToString(scratch, va_arg(*ap, EFI_STATUS));
+		break;
+	case 't':
+		TimeToString(scratch, va_arg(*ap, EFI_TIME *));
+		break;
+	}
+	put_wide(out, item, scratch);
+}
+
+static void format(struct output *out, const char *fmt, va_list ap)
+{
+	struct item item;
+	UINTN *width;
+	va_list args;
+
+	va_copy(args, ap);
+	for (; *fmt; fmt++) {
+		if (*fmt != '%') {
+			put_char(out, *fmt);
+			continue;
+		}
+
+		item.is_long = FALSE;
+		item.comma = FALSE;
+		item.pad_after = FALSE;
+		item.pad = ' ';
+		item.width = 0;
+		item.max_width = (UINTN)-1;
+		width = &item.width;
+
+		for (fmt++; *fmt; fmt++) {
+			if (*fmt == '-')
+				item.pad_after = TRUE;
+			else if (*fmt == ',')
+				item.comma = TRUE;
+			else if (*fmt == '.') {
+				item.max_width = 0;
+				width = &item.max_width;
+			} else if (*fmt == '*')
+				*width = va_arg(args, UINTN);
+			else if (*fmt == '0' && width == &item.width && !item.width)
+				item.pad = '0';
+			else if (*fmt >= '0' && *fmt <= '9')
+				*width = *width * 10 + *fmt - '0';
+			else if (*fmt == 'l')
+				item.is_long = TRUE;
+			else
+				break;
+		}
+
+		switch (*fmt) {
+		case '\0':
+			goto out;
+		case 'a':
+			put_ascii(out, &item, va_arg(args, CHAR8 *));
+			break;
+		case 's':
+			put_wide(out, &item, va_arg(args, CHAR16 *));
+			break;
+		case 'c':
+			put_char(out, (char)va_arg(args, UINTN));
+			break;
+		case 'X':
+			item.width = item.is_long ? 16 : 8;
+			item.pad = '0';
+			/* fall through */
+		case 'x':
+			put_hex(out, &item, item.is_long ? va_arg(args, UINT64) :
+				va_arg(args, UINT32));
+			break;
+		case 'p':
+			put_char(out, '0');
+			put_char(out, 'x');
+			put_hex(out, &item, (UINTN)va_arg(args, void *));
+			break;
+		case 'd':
+			put_decimal(out, &item, item.is_long ? va_arg(args, INT64) :
+				    va_arg(args, INT32), TRUE);
+			break;
+		case 'u':
+			put_decimal(out, &item, item.is_long ? va_arg(args, UINT64) :
+				    va_arg(args, UINT32), FALSE);
+			break;
+		case 'g':
+		case 'r':
+		case 't':
+			put_scratch16(out, &item, *fmt, &args);
+			break;
+		case '%':
+			put_char(out, '%');
+			break;
+		case 'n':
+		case 'N':
+		case 'h':
+		case 'H':
+		case 'e':
+		case 'E':
+		case 'b':
+		case 'B':
+		case 'v':
+		case 'V':
+			/* Console attributes, meaningless in a string */
+			break;
+		default:
+			put_char(out, '?');
+			break;
+		}
+	}
+out:
+	va_end(args);
+}
+
+int vsnprintf(char *str, size_t size, const char *format_str, va_list ap)
+{
+	struct output out = { .str = str, .size = size };
+
+	if (!str || !size || !format_str)
+		return -1;
+
+	format(&out, format_str, ap);
+	str[out.len < size ? out.len : size - 1] = '\0';
+	if (out.error)
+		return -1;
+
+	return out.len < size ? out.len : size - 1;
 }
 
 int snprintf(char *str, size_t size, const char *format, ...)
@@ -73,27 +298,13 @@ int snprintf(char *str, size_t size, const char *format, ...)
 	return ret;
 }
 
-int vsnprintf(char *str, size_t size, const char *format, va_list ap)
+int sprintf(char *str, const char *format, ...)
 {
-	UINTN len;
-	int ret = -1;
-	CHAR16 *format16 = stra_to_str((CHAR8 *)format);
-	if (!format16)
-		return -1;
-
-	CHAR16 *str16 = AllocatePool(size * sizeof(CHAR16));
-	if (!str16)
-		goto free_format16;
-
-	len = VSPrint(str16, size * sizeof(CHAR16), format16, ap);
-
-	if (str_to_stra((CHAR8 *)str, str16, len) == EFI_SUCCESS) {
-		ret = 0;
-		str[len] = '\0';
-	}
+	va_list args;
+	int ret;
 
-	FreePool(str16);
-free_format16:
-	FreePool(format16);
+	va_start(args, format);
+	ret = vsnprintf(str, (size_t)-1 >> 1, format, args);
+	va_end(args);
 	return ret;
 }
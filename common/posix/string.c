@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <efi.h>
+#include <efilib.h>
+#include <cpu.h>
+#include "string.h"
+
+/*
+ * memcpy(), memset(), memcmp(), memchr() and strlen() with runtime
+ * selected implementations: "rep movsb/stosb" when the CPU advertises
+ * Enhanced REP MOVSB/STOSB (ERMS), 16 bytes SSE2 loops otherwise, and
+ * plain C word loops on IA-32 CPUs without SSE2.  The first call of
+ * each primitive probes the CPU and replaces its function pointer.
+ */
+
+/* Below this size the start-up cost of "rep movsb/stosb" is not
+ * amortized and the SSE2 loops are faster. */
+#define ERMS_THRESHOLD 512
+
+#define SSE2_TARGET __attribute__((target("sse2")))
+
+typedef char v16qi __attribute__((vector_size(16)));
+typedef char v16qi_u __attribute__((vector_size(16), aligned(1)));
+typedef long long v2di __attribute__((vector_size(16)));
+
+/* x86 handles unaligned accesses */
+typedef UINT16 __attribute__((aligned(1), may_alias)) unaligned_u16;
+typedef UINT32 __attribute__((aligned(1), may_alias)) unaligned_u32;
+typedef UINT64 __attribute__((aligned(1), may_alias)) unaligned_u64;
+typedef UINTN __attribute__((aligned(1), may_alias)) unaligned_uintn;
+
+#define ONES ((UINTN)-1 / 0xff)
+
+/* Copy up to 15 bytes with possibly overlapping head and tail moves */
+static inline void copy_small(UINT8 *d, const UINT8 *s, UINTN n)
+{
+	if (n >= 8) {
+		UINT64 head = *(unaligned_u64 *)s;
+		UINT64 tail = *(unaligned_u64 *)(s + n - 8);
+		*(unaligned_u64 *)d = head;
+		*(unaligned_u64 *)(d + n - 8) = tail;
+	} else if (n >= 4) {
+		UINT32 head = *(unaligned_u32 *)s;
+		UINT32 tail = *(unaligned_u32 *)(s + n - 4);
+		*(unaligned_u32 *)d = head;
+		*(unaligned_u32 *)(d + n - 4) = tail;
+	} else if (n) {
+		UINT8 head = s[0], mid = s[n / 2], tail = s[n - 1];
+		d[0] = head;
+		d[n / 2] = mid;
+		d[n - 1] = tail;
+	}
+}
+
+static void *memcpy_generic(void *dst, const void *src, UINTN n)
+{
+	UINT8 *d = dst;
+	const UINT8 *s = src;
+
+	for (; n >= sizeof(UINTN); n -= sizeof(UINTN)) {
+		*(unaligned_uintn *)d = *(unaligned_uintn *)s;
+		d += sizeof(UINTN);
+		s += sizeof(UINTN);
+	}
+	while (n--)
+		*d++ = *s++;
+
+	return dst;
+}
+
+static SSE2_TARGET void *memcpy_sse2(void *dst, const void *src, UINTN n)
+{
+	UINT8 *d = dst, *end = d + n;
+	const UINT8 *s = src;
+	v16qi head, tail, a, b, c, e;
+	UINTN skip;
+
+	if (n < 16) {
+		copy_small(d, s, n);
+		return dst;
+	}
+
+	head = *(v16qi_u *)s;
+	tail = *(v16qi_u *)(s + n - 16);
+	if (n <= 32) {
+		*(v16qi_u *)d = head;
+		*(v16qi_u *)(end - 16) = tail;
+		return dst;
+	}
+
+	/* Unaligned head, aligned stores, then an unaligned tail */
+	*(v16qi_u *)d = head;
+	skip = 16 - ((UINTN)d & 15);
+	d += skip;
+	s += skip;
+	while (end - d > 64) {
+		a = *(v16qi_u *)s;
+		b = *(v16qi_u *)(s + 16);
+		c = *(v16qi_u *)(s + 32);
+		e = *(v16qi_u *)(s + 48);
+		*(v16qi *)d = a;
+		*(v16qi *)(d + 16) = b;
+		*(v16qi *)(d + 32) = c;
+		*(v16qi *)(d + 48) = e;
+		d += 64;
+		s += 64;
+	}
+	while (end - d > 16) {
+		*(v16qi *)d = *(v16qi_u *)s;
+		d += 16;
+		s += 16;
+	}
+	*(v16qi_u *)(end - 16) = tail;
+
+	return dst;
+}
+
+static void *memcpy_erms(void *dst, const void *src, UINTN n)
+{
+	void *d = dst;
+
+	if (n < ERMS_THRESHOLD)
+		return memcpy_sse2(dst, src, n);
+
+	asm volatile("rep movsb"
+		     : "+D" (d), "+S" (src), "+c" (n)
+		     : : "memory");
+	return dst;
+}
+
+static void *memset_generic(void *dst, int c, UINTN n)
+{
+	UINT8 *d = dst;
+	UINTN v = ONES * (UINT8)c;
+
+	for (; n >= sizeof(UINTN); n -= sizeof(UINTN)) {
+		*(unaligned_uintn *)d = v;
+		d += sizeof(UINTN);
+	}
+	while (n--)
+		*d++ = c;
+
+	return dst;
+}
+
+static SSE2_TARGET void *memset_sse2(void *dst, int c, UINTN n)
+{
+	UINT8 *d = dst, *end = d + n;
+	UINT64 p = 0x0101010101010101ULL * (UINT8)c;
+	v16qi v = (v16qi)(v2di){ p, p };
+
+	if (n < 16) {
+		if (n >= 8) {
+			*(unaligned_u64 *)d = p;
+			*(unaligned_u64 *)(end - 8) = p;
+		} else if (n >= 4) {
+			*(unaligned_u32 *)d = p;
+			*(unaligned_u32 *)(end - 4) = p;
+		} else if (n) {
+			d[0] = c;
+			d[n / 2] = c;
+			end[-1] = c;
+		}
+		return dst;
+	}
+
+	*(v16qi_u *)d = v;
+	*(v16qi_u *)(end - 16) = v;
+	d += 16 - ((UINTN)d & 15);
+	while (end - d > 64) {
+		*(v16qi *)d = v;
+		*(v16qi *)(d + 16) = v;
+		*(v16qi *)(d + 32) = v;
+		*(v16qi *)(d + 48) = v;
+		d += 64;
+	}
+	while (end - d > 16) {
+		*(v16qi *)d = v;
+		d += 16;
+	}
+
+	return dst;
+}
+
+static void *memset_erms(void *dst, int c, UINTN n)
+{
+	void *d = dst;
+
+	if (n < ERMS_THRESHOLD)
+		return memset_sse2(dst, c, n);
+
+	asm volatile("rep stosb"
+		     : "+D" (d), "+c" (n)
+		     : "a" (c)
+		     : "memory");
+	return dst;
+}
+
+static int memcmp_generic(const void *s1, const void *s2, UINTN n)
+{
+	const UINT8 *p = s1, *q = s2;
+
+	for (; n >= sizeof(UINTN); n -= sizeof(UINTN)) {
+		if (*(unaligned_uintn *)p != *(unaligned_uintn *)q)
+			break;
+		p += sizeof(UINTN);
+		q += sizeof(UINTN);
+	}
+	for (; n; n--, p++, q++)
+		if (*p != *q)
+			return *p - *q;
+
+	return 0;
+}
+
+static SSE2_TARGET int memcmp_sse2(const void *s1, const void *s2, UINTN n)
+{
+	const UINT8 *p = s1, *q = s2;
+	unsigned int mask;
+
+	for (; n >= 16; n -= 16, p += 16, q += 16) {
+		mask = __builtin_ia32_pmovmskb128(*(v16qi_u *)p == *(v16qi_u *)q);
+		if (mask != 0xffff) {
+			mask = __builtin_ctz(~mask);
+			return p[mask] - q[mask];
+		}
+	}
+
+	return memcmp_generic(p, q, n);
+}
+
+static void *memchr_generic(const void *s, int c, UINTN n)
+{
+	const UINT8 *p = s;
+
+	for (; n; n--, p++)
+		if (*p == (UINT8)c)
+			return (void *)p;
+
+	return NULL;
+}
+
+/*
+ * Aligned 16 bytes loads never cross a page boundary, so the SSE2
+ * memchr() and strlen() may read past the end of the buffer within
+ * the last block; matches found there are discarded.
+ */
+static SSE2_TARGET void *memchr_sse2(const void *s, int c, UINTN n)
+{
+	const UINT8 *p = s, *end = p + n, *base;
+	UINT64 b = 0x0101010101010101ULL * (UINT8)c;
+	v16qi v = (v16qi)(v2di){ b, b };
+	unsigned int mask;
+
+	if (!n)
+		return NULL;
+
+	base = (const UINT8 *)((UINTN)p & ~(UINTN)15);
+	mask = __builtin_ia32_pmovmskb128(*(v16qi *)base == v);
+	mask &= 0xffff << (p - base);
+	for (;;) {
+		if (mask) {
+			p = base + __builtin_ctz(mask);
+			return p < end ? (void *)p : NULL;
+		}
+		base += 16;
+		if (base >= end)
+			return NULL;
+		mask = __builtin_ia32_pmovmskb128(*(v16qi *)base == v);
+	}
+}
+
+static UINTN strlen_generic(const char *s)
+{
+	const char *p = s;
+
+	while (*p)
+		p++;
+
+	return p - s;
+}
+
+static SSE2_TARGET UINTN strlen_sse2(const char *s)
+{
+	const char *base = (const char *)((UINTN)s & ~(UINTN)15);
+	v16qi zero = { 0 };
+	unsigned int mask;
+
+	mask = __builtin_ia32_pmovmskb128(*(v16qi *)base == zero);
+	mask &= 0xffff << (s - base);
+	while (!mask) {
+		base += 16;
+		mask = __builtin_ia32_pmovmskb128(*(v16qi *)base == zero);
+	}
+
+	return base + __builtin_ctz(mask) - s;
+}
+
+static void *memcpy_init(void *dst, const void *src, UINTN n);
+static void *memset_init(void *dst, int c, UINTN n);
+static int memcmp_init(const void *s1, const void *s2, UINTN n);
+static void *memchr_init(const void *s, int c, UINTN n);
+static UINTN strlen_init(const char *s);
+
+static void *(*memcpy_func)(void *, const void *, UINTN) = memcpy_init;
+static void *(*memset_func)(void *, int, UINTN) = memset_init;
+static int (*memcmp_func)(const void *, const void *, UINTN) = memcmp_init;
+static void *(*memchr_func)(const void *, int, UINTN) = memchr_init;
+static UINTN (*strlen_func)(const char *) = strlen_init;
+
+static void string_init(void)
+{
+	BOOLEAN sse2, erms;
+
+#ifdef CONFIG_X86_64
+	sse2 = TRUE;
+#else
+	sse2 = x86_cpu_has_feature(CPU_FEATURE_SSE2);
+#endif
+	erms = sse2 && x86_cpu_has_feature(CPU_FEATURE_ERMS);
+
+	memcpy_func = erms ? memcpy_erms : sse2 ? memcpy_sse2 : memcpy_generic;
+	memset_func = erms ? memset_erms : sse2 ? memset_sse2 : memset_generic;
+	memcmp_func = sse2 ? memcmp_sse2 : memcmp_generic;
+	memchr_func = sse2 ? memchr_sse2 : memchr_generic;
+	strlen_func = sse2 ? strlen_sse2 : strlen_generic;
+}
+
+static void *memcpy_init(void *dst, const void *src, UINTN n)
+{
+	string_init();
+	return memcpy_func(dst, src, n);
+}
+
+static void *memset_init(void *dst, int c, UINTN n)
+{
+	string_init();
+	return memset_func(dst, c, n);
+}
+
+static int memcmp_init(const void *s1, const void *s2, UINTN n)
+{
+	string_init();
+	return memcmp_func(s1, s2, n);
+}
+
+static void *memchr_init(const void *s, int c, UINTN n)
+{
+	string_init();
+	return memchr_func(s, c, n);
+}
+
+static UINTN strlen_init(const char *s)
+{
+	string_init();
+	return strlen_func(s);
+}
+
+void *posix_memcpy(void *dst, const void *src, UINTN n)
+{
+	return memcpy_func(dst, src, n);
+}
+
+void *posix_memset(void *dst, int c, UINTN n)
+{
+	return memset_func(dst, c, n);
+}
+
+int posix_memcmp(const void *s1, const void *s2, UINTN n)
+{
+	return memcmp_func(s1, s2, n);
+}
+
+void *posix_memchr(const void *s, int c, UINTN n)
+{
+	return memchr_func(s, c, n);
+}
+
+UINTN posix_strlen(const char *s)
+{
+	return strlen_func(s);
+}
+
+char *posix_strstr(const char *haystack, const char *needle)
+{
+	UINTN len = posix_strlen(needle), hlen;
+	const char *p, *end;
+
+	if (!len)
+		return NULL;
+
+	hlen = posix_strlen(haystack);
+	if (hlen < len)
+		return NULL;
+
+	/* Jump from one occurence of the first character to the next */
+	end = haystack + hlen - len + 1;
+	for (p = haystack; (p = posix_memchr(p, *needle, end - p)); p++)
+		if (!posix_memcmp(p + 1, needle + 1, len - 1))
+			return (char *)p;
+
+	return NULL;
+}
@@ -33,31 +33,20 @@
 #include <efi.h>
 #include <efilib.h>
 
-#define memcpy(dst, src, size) CopyMem(dst, src, size)
-#define memset(dst, c, size) ZeroMem(dst, size)
-#define memcmp(s1, s2, size) CompareMem(s1, s2, size)
-#define strlen(s) strlena((CHAR8 *)s)
+void *posix_memcpy(void *dst, const void *src, UINTN n);
+void *posix_memset(void *dst, int c, UINTN n);
+int posix_memcmp(const void *s1, const void *s2, UINTN n);
+void *posix_memchr(const void *s, int c, UINTN n);
+UINTN posix_strlen(const char *s);
+char *posix_strstr(const char *haystack, const char *needle);
+
+/* memcpy() does not handle overlapping buffers, use CopyMem() there */
+#define memcpy(dst, src, size) posix_memcpy(dst, src, size)
+#define memset(dst, c, size) posix_memset(dst, c, size)
+#define memcmp(s1, s2, size) posix_memcmp(s1, s2, size)
+#define memchr(s, c, size) posix_memchr(s, c, size)
+#define strlen(s) posix_strlen((const char *)s)
 #define strcmp(s1,s2) strcmpa((CHAR8 *)s1, (CHAR8 *)s2)
-
-static inline char *strstr(char *haystack, char *needle)
-{
-	char *p;
-	char *word = NULL;
-	int len = strlen(needle);
-
-	if (!len)
-		return NULL;
-
-	p = haystack;
-	while (*p) {
-		word = p;
-		if (!strncmpa((CHAR8 *)p, (CHAR8 *)needle, len))
-			break;
-		p++;
-		word = NULL;
-	}
-
-	return word;
-}
+#define strstr(haystack, needle) posix_strstr(haystack, needle)
 
 #endif	/* __STRING_H__ */
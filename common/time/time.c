@@ -28,34 +28,122 @@
  */
 
 #include <efi.h>
+#include <efilib.h>
 #include <cpu.h>
 #include "time.h"
 #include "time_silvermont.h"
 
-static UINT64 init_time(void);
+#define CALIBRATION_US	1000
+#define TSC_SHIFT_MIN	32
+#define TSC_SHIFT_MAX	53	/* 1000 << shift fits on 64 bits */
 
-static UINT64 (*get_time_func)(void) = init_time;
+static BOOLEAN initialized;
+static UINT64 tsc_khz;
+static UINT32 tsc_mult;
+static UINT32 tsc_shift;
+static UINT64 start;
 
-static UINT64 time_stub(void)
+UINT64 cpuid_tsc_khz(UINT32 max_leaf, const UINT32 leaf_15[4],
+		     const UINT32 leaf_16[4])
 {
+	/* Leaf 0x15: TSC/crystal ratio in EBX/EAX, crystal Hz in ECX */
+	if (max_leaf >= 0x15 && leaf_15[0] && leaf_15[1] && leaf_15[2])
+		return (UINT64)leaf_15[2] * leaf_15[1] / leaf_15[0] / 1000;
+
+	/* Leaf 0x16: nominal base frequency in MHz, which the TSC runs
+	 * at when the crystal frequency is not enumerated */
+	if (max_leaf >= 0x16 && leaf_16[0])
+		return (UINT64)leaf_16[0] * 1000;
+
 	return 0;
 }
 
-static UINT64 init_time(void)
+static UINT64 calibrate_tsc_khz(void)
 {
+	UINT64 begin = rdtsc();
+
+	uefi_call_wrapper(BS->Stall, 1, CALIBRATION_US);
+	return (rdtsc() - begin) * 1000 / CALIBRATION_US;
+}
+
+static UINT64 detect_tsc_khz(void)
+{
+	UINT32 leaf_15[4] = { 0 }, leaf_16[4] = { 0 };
+	UINT32 max_leaf;
+	UINT64 khz;
+
+	max_leaf = x86_cpuid_max_leaf();
+	if (max_leaf >= 0x15)
+		x86_cpuid(0x15, 0, leaf_15);
+	if (max_leaf >= 0x16)
+		x86_cpuid(0x16, 0, leaf_16);
+
+	khz = cpuid_tsc_khz(max_leaf, leaf_15, leaf_16);
+	if (khz)
+		return khz;
+
 	switch (x86_identify_cpu()) {
 	case CPU_SILVERMONT:
 	case CPU_AIRMONT:
-		get_time_func = silvermont_get_current_time_us;
-		break;
+		return silvermont_get_tsc_khz();
 	default:
-		get_time_func = time_stub;
+		return calibrate_tsc_khz();
 	}
+}
+
+UINT32 tsc_mult_us(UINT64 khz, UINT32 *shift)
+{
+	UINT32 s;
+
+	/* The multiplier must fit on 32 bits: khz > 1000 */
+	*shift = TSC_SHIFT_MIN;
+	if (khz <= 1000)
+		return 0;
+
+	/* Largest shift keeping the multiplier on 32 bits, so that it
+	 * carries 32 significant bits whatever the frequency */
+	for (s = TSC_SHIFT_MIN; s < TSC_SHIFT_MAX; s++)
+		if (((1000ULL << (s + 1)) + khz / 2) / khz > 0xFFFFFFFFULL)
+			break;
 
-	return get_time_func();
+	*shift = s;
+	return ((1000ULL << s) + khz / 2) / khz;
+}
+
+/* (@a * @mult) >> @shift without 128 bits arithmetic, @shift >= 32 */
+static inline UINT64 mul_shift(UINT64 a, UINT32 mult, UINT32 shift)
+{
+	UINT64 low = (UINT64)(UINT32)a * mult;
+	UINT64 high = (a >> 32) * mult;
+
+	return (high + (low >> 32)) >> (shift - 32);
+}
+
+static void init_time(void)
+{
+	tsc_khz = detect_tsc_khz();
+	tsc_mult = tsc_mult_us(tsc_khz, &tsc_shift);
+	start = rdtsc();
+	initialized = TRUE;
+}
+
+UINT64 get_tsc_khz(void)
+{
+	if (!initialized)
+		init_time();
+	return tsc_khz;
+}
+
+UINT64 tsc_to_us(UINT64 ticks)
+{
+	if (!initialized)
+		init_time();
+	return mul_shift(ticks, tsc_mult, tsc_shift);
 }
 
 UINT64 get_current_time_us(void)
 {
-	return get_time_func();
+	if (!initialized)
+		init_time();
+	return mul_shift(rdtsc() - start, tsc_mult, tsc_shift);
 }
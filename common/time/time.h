@@ -30,6 +30,16 @@
 #ifndef _TIME_H_
 #define _TIME_H_
 
+/* Microseconds since the first use of the time functions */
 UINT64 get_current_time_us(void);
 
+UINT64 get_tsc_khz(void);
+UINT64 tsc_to_us(UINT64 ticks);
+
+/* Frequency and conversion helpers, taking the raw CPUID values so
+ * that they can be checked against known CPUs */
+UINT64 cpuid_tsc_khz(UINT32 max_leaf, const UINT32 leaf_15[4],
+		     const UINT32 leaf_16[4]);
+UINT32 tsc_mult_us(UINT64 khz, UINT32 *shift);
+
 #endif	/* _TIME_H_ */
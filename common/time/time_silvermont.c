@@ -34,33 +34,20 @@
 #define MSR_PLATFORM_INFO	0x000000CE
 #define MSR_FSB_FREQ		0xCD
 
-static UINT64 get_tsc_freq(void)
+UINT64 silvermont_tsc_khz(UINT64 platform_info, UINT64 fsb_freq)
 {
-	UINT64 platform_info;
-	UINT64 clk_info;
 	UINT64 bclk_khz;
 
-	platform_info = rdmsr(MSR_PLATFORM_INFO);
-	clk_info = rdmsr(MSR_FSB_FREQ);
-	switch (clk_info  & 0x3) {
+	switch (fsb_freq & 0x3) {
 	case 0: bclk_khz =  83333; break;
 	case 1: bclk_khz = 100000; break;
 	case 2: bclk_khz = 133333; break;
-	case 3: bclk_khz = 116666; break;
+	default: bclk_khz = 116666; break;
 	}
-	return (bclk_khz * ((platform_info >> 8) & 0xff)) / 1000;
+	return bclk_khz * ((platform_info >> 8) & 0xff);
 }
 
-UINT64 silvermont_get_current_time_us()
+UINT64 silvermont_get_tsc_khz(void)
 {
-	static UINT64 tsc_freq, start;
-	UINT64 cur = rdtsc();
-
-	if (tsc_freq == 0)
-		tsc_freq = get_tsc_freq();
-
-	if (start == 0)
-		start = cur;
-
-	return (cur - start) / tsc_freq;
+	return silvermont_tsc_khz(rdmsr(MSR_PLATFORM_INFO), rdmsr(MSR_FSB_FREQ));
 }
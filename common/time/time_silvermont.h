@@ -30,7 +30,9 @@
 #ifndef _TIME_SILVERMONT_H_
 #define _TIME_SILVERMONT_H_
 
-UINT64 silvermont_get_current_time_us();
+/* TSC frequency from the MSR_PLATFORM_INFO and MSR_FSB_FREQ values */
+UINT64 silvermont_tsc_khz(UINT64 platform_info, UINT64 fsb_freq);
+UINT64 silvermont_get_tsc_khz(void);
 
 #endif	/* _TIME_SILVERMONT_H_ */
 
@@ -33,6 +33,8 @@
 #include "protocol.h"
 #include "uefi_utils.h"
 
+#define VAR_NAME_MAX 128
+
 extern EFI_GUID GraphicsOutputProtocol;
 
 typedef struct {
@@ -568,14 +570,17 @@ EFI_STATUS uefi_set_simple_var(char *name, EFI_GUID *guid, int size, void *data,
 			       BOOLEAN persistent)
 {
 	EFI_STATUS ret;
-	CHAR16 *name16 = stra_to_str((CHAR8 *)name);
+	CHAR16 name16[VAR_NAME_MAX];
+
+	ret = stra_to_str_buf(name16, ARRAY_SIZE(name16), (CHAR8 *)name);
+	if (EFI_ERROR(ret))
+		return ret;
 
 	if (persistent)
 		ret = LibSetNVVariable(name16, guid, size, data);
 	else
 		ret = LibSetVariable(name16, guid, size, data);
 
-	FreePool(name16);
 	return ret;
 }
 
@@ -584,7 +589,11 @@ INT8 uefi_get_simple_var(char *name, EFI_GUID *guid)
 	void *buffer;
 	UINT64 ret;
 	UINTN size;
-	CHAR16 *name16 = stra_to_str((CHAR8 *)name);
+	CHAR16 name16[VAR_NAME_MAX];
+
+	if (EFI_ERROR(stra_to_str_buf(name16, ARRAY_SIZE(name16), (CHAR8 *)name)))
+		return -1;
+
 	buffer = LibGetVariableAndSize(name16, guid, &size);
 
 	if (buffer == NULL) {
@@ -602,7 +611,6 @@ INT8 uefi_get_simple_var(char *name, EFI_GUID *guid)
 
 	ret = *(INT8 *)buffer;
 out:
-	FreePool(name16);
 	if (buffer)
 		FreePool(buffer);
 	return ret;
@@ -618,61 +626,133 @@ EFI_STATUS uefi_msleep(UINTN mseconds)
 	return uefi_usleep(mseconds * 1000);
 }
 
+/* x86 handles unaligned accesses */
+typedef UINT32 __attribute__((aligned(1), may_alias)) unaligned_u32;
+typedef UINT64 __attribute__((aligned(1), may_alias)) unaligned_u64;
+
+#define HAS_ZERO_BYTE(x) (((x) - 0x01010101U) & ~(x) & 0x80808080U)
+#define HAS_ZERO_WORD(x) (((x) - 0x0001000100010001ULL) & ~(x) & 0x8000800080008000ULL)
+
+/* Wide loads may read past the NUL, but never into the next page */
+static inline BOOLEAN crosses_page(const void *p, UINTN size)
+{
+	return (((UINTN)p & (EFI_PAGE_SIZE - 1)) + size) > EFI_PAGE_SIZE;
+}
+
+/*
+ * ASCII <-> UCS-2 copy of at most @max characters, up to and including
+ * the NUL, 4 characters at a time: the 4 bytes of a 32 bits load are
+ * spread over the 4 words of a 64 bits store, and the other way
+ * around.  A chunk holding the NUL or a non ASCII character is handled
+ * one character at a time.  Return the string length, @max if there
+ * is no NUL in the first @max characters or -1 if a character is not
+ * ASCII.
+ *
+ * This is NOT how to do UTF16 to UTF8 conversion. For now we're just
+ * going to hope that nobody's putting non-ASCII characters in the
+ * strings! We'll at least abort with an error if we see any funny
+ * stuff.
+ */
+static INTN widen_ascii(CHAR16 *dst, const CHAR8 *src, UINTN max)
+{
+	UINT64 x;
+	UINTN i, j;
+
+	for (i = 0; i < max; i += 4) {
+		if (i + 4 <= max && !crosses_page(src + i, 4)) {
+			x = *(unaligned_u32 *)(src + i);
+			if (!((x & 0x80808080) | HAS_ZERO_BYTE((UINT32)x))) {
+				x = (x | x << 16) & 0x0000FFFF0000FFFFULL;
+				x = (x | x << 8) & 0x00FF00FF00FF00FFULL;
+				*(unaligned_u64 *)(dst + i) = x;
+				continue;
+			}
+		}
+
+		for (j = i; j < i + 4 && j < max; j++) {
+			if (src[j] > 0x7F)
+				return -1;
+			dst[j] = src[j];
+			if (!src[j])
+				return j;
+		}
+	}
+	return max;
+}
+
+static INTN narrow_ascii(CHAR8 *dst, const CHAR16 *src, UINTN max)
+{
+	UINT64 x;
+	UINTN i, j;
+
+	for (i = 0; i < max; i += 4) {
+		if (i + 4 <= max && !crosses_page(src + i, 8)) {
+			x = *(unaligned_u64 *)(src + i);
+			if (!((x & 0xFF80FF80FF80FF80ULL) | HAS_ZERO_WORD(x))) {
+				x = (x | x >> 8) & 0x0000FFFF0000FFFFULL;
+				x = x | x >> 16;
+				*(unaligned_u32 *)(dst + i) = (UINT32)x;
+				continue;
+			}
+		}
+
+		for (j = i; j < i + 4 && j < max; j++) {
+			if (src[j] > 0x7F)
+				return -1;
+			dst[j] = (CHAR8)src[j];
+			if (!src[j])
+				return j;
+		}
+	}
+	return max;
+}
+
 EFI_STATUS str_to_stra(CHAR8 *dst, CHAR16 *src, UINTN len)
 {
-        UINTN i;
+	if (!src || !dst)
+		return EFI_INVALID_PARAMETER;
+
+	if (narrow_ascii(dst, src, len) < 0)
+		return EFI_INVALID_PARAMETER;
+
+	return EFI_SUCCESS;
+}
+
+EFI_STATUS stra_to_str_buf(CHAR16 *dst, UINTN size, CHAR8 *src)
+{
+	INTN len;
 
 	if (!src || !dst)
 		return EFI_INVALID_PARAMETER;
 
-        /* This is NOT how to do UTF16 to UTF8 conversion. For now we're just
-         * going to hope that nobody's putting non-ASCII characters in
-         * the source string! We'll at least abort with an error
-         * if we see any funny stuff */
-        for (i = 0; i < len; i++) {
-                if (src[i] > 0x7F)
-                        return EFI_INVALID_PARAMETER;
-
-                dst[i] = (CHAR8)src[i];
-                if (!src[i])
-                        break;
-        }
-        return EFI_SUCCESS;
+	len = widen_ascii(dst, src, size);
+	if (len < 0)
+		return EFI_INVALID_PARAMETER;
+	if ((UINTN)len == size)
+		return EFI_BUFFER_TOO_SMALL;
+
+	return EFI_SUCCESS;
 }
 
 CHAR16 *stra_to_str(CHAR8 *src)
 {
-        UINTN i;
 	UINTN len;
 	CHAR16 *dst;
 
 	if (!src)
 		return NULL;
 
-        /* This is NOT how to do UTF16 to UTF8 conversion. For now we're just
-         * going to hope that nobody's putting non-ASCII characters in
-         * the source string! We'll at least abort with an error
-         * if we see any funny stuff */
-
 	len = strlena(src);
-
-	dst = AllocatePool((len+1) * sizeof(CHAR16));
+	dst = AllocatePool((len + 1) * sizeof(CHAR16));
 	if (!dst)
 		return NULL;
 
-        for (i = 0; i <= len; i++) {
-                if (src[i] > 0x7F)
-			goto free;
-
-                dst[i] = (CHAR16)src[i];
-                if (!src[i])
-                        break;
-        }
+	if (EFI_ERROR(stra_to_str_buf(dst, len + 1, src))) {
+		FreePool(dst);
+		return NULL;
+	}
 
-        return dst;
-free:
-	FreePool(dst);
-        return NULL;
+	return dst;
 }
 
 VOID StrNCpy(OUT CHAR16 *dest, IN const CHAR16 *src, UINT32 n)
@@ -755,81 +835,6 @@ void copy_and_swap_guid(EFI_GUID *dst, const EFI_GUID *src)
         dst->Data3 = swap_bytes16(src->Data3);
 }
 
-EFI_STATUS open_partition(
-                IN const EFI_GUID *guid,
-                OUT UINT32 *MediaIdPtr,
-                OUT EFI_BLOCK_IO **BlockIoPtr,
-                OUT EFI_DISK_IO **DiskIoPtr)
-{
-        EFI_STATUS ret;
-        EFI_BLOCK_IO *BlockIo;
-        EFI_DISK_IO *DiskIo;
-        UINT32 MediaId;
-        UINTN NoHandles = 0;
-        EFI_HANDLE *HandleBuffer = NULL;
-
-	if (!guid || !MediaIdPtr || !BlockIoPtr || !DiskIoPtr)
-		return EFI_INVALID_PARAMETER;
-
-        /* Get a handle on the partition containing the boot image */
-        ret = LibLocateHandleByDiskSignature(
-                        MBR_TYPE_EFI_PARTITION_TABLE_HEADER,
-                        SIGNATURE_TYPE_GUID,
-                        (void *)guid,
-                        &NoHandles,
-                        &HandleBuffer);
-        if (EFI_ERROR(ret) || NoHandles == 0) {
-                /* Workaround for old installers which incorrectly wrote
-                 * GUIDs strings as little-endian */
-                EFI_GUID g;
-                copy_and_swap_guid(&g, guid);
-                ret = LibLocateHandleByDiskSignature(
-                                MBR_TYPE_EFI_PARTITION_TABLE_HEADER,
-                                SIGNATURE_TYPE_GUID,
-                                (void *)&g,
-                                &NoHandles,
-                                &HandleBuffer);
-                if (EFI_ERROR(ret)) {
-                        error(L"LibLocateHandle", ret);
-                        return ret;
-                }
-        }
-        if (NoHandles != 1) {
-                error(L"%d handles found for GUID, expecting 1: %g\n",
-                      NoHandles, guid);
-                ret = EFI_VOLUME_CORRUPTED;
-                goto out;
-        }
-
-	/* In Fast boot mode, only ESP device is connected to protocols.
-	 * We need to specificallty connect the device in order to use it's DiskIoProtocol
-	 */
-	uefi_call_wrapper(BS->ConnectController, 4, HandleBuffer[0], NULL, NULL, TRUE);
-
-        /* Instantiate BlockIO and DiskIO protocols so we can read various data */
-        ret = uefi_call_wrapper(BS->HandleProtocol, 3, HandleBuffer[0],
-                        &BlockIoProtocol,
-                        (void **)&BlockIo);
-        if (EFI_ERROR(ret)) {
-                error(L"HandleProtocol (BlockIoProtocol)\n", ret);
-                goto out;;
-        }
-        ret = uefi_call_wrapper(BS->HandleProtocol, 3, HandleBuffer[0],
-                        &DiskIoProtocol, (void **)&DiskIo);
-        if (EFI_ERROR(ret)) {
-                error(L"HandleProtocol (DiskIoProtocol)\n", ret);
-                goto out;
-        }
-        MediaId = BlockIo->Media->MediaId;
-
-        *MediaIdPtr = MediaId;
-        *BlockIoPtr = BlockIo;
-        *DiskIoPtr = DiskIo;
-out:
-        FreePool(HandleBuffer);
-        return ret;
-}
-
 void path_to_dos(CHAR16 *path)
 {
 	while (*path) {
@@ -839,47 +844,6 @@ void path_to_dos(CHAR16 *path)
 	}
 }
 
-/* Return a newly allocated string containing the concatenation of the
- * two parameters with a space between them
- *
- * return NULL if the two strings are empty or the allocation failed,
- */
-CHAR8 *append_strings(CHAR8 *s1, CHAR8 *s2)
-{
-	INTN len_s1;
-	INTN len_s2;
-	BOOLEAN space;
-	CHAR8 *new;
-
-	len_s1 = s1 ? strlena(s1) : 0;
-	len_s2 = s2 ? strlena(s2) : 0;
-	space = s1 && s2;
-
-	if (!s1 && !s2)
-		return NULL;
-
-	new = AllocatePool(len_s1 + len_s2 + 1 + space);
-	if (!new) {
-		error(L"Failed to allocate new command line\n");
-		return NULL;
-	}
-
-	UINTN i = 0;
-	if (s1) {
-		CopyMem(new, s1, len_s1);
-		i += len_s1;
-	}
-	if (space)
-		new[i++] = ' ';
-	if (s2) {
-		CopyMem(new + i, s2, len_s2);
-		i += len_s2;
-	}
-
-	new[i] = '\0';
-	return new;
-}
-
 static INTN to_digit(CHAR16 c, UINTN base)
 {
 	UINTN value = -1;
@@ -1096,6 +1060,61 @@ fail:
 	return err;
 }
 
+/**
+ * largest_free_range - Find the largest free memory range
+ * @max_addr: ranges are clipped to end at or below this address
+ * @start: used to return the physical start address of the range
+ * @nr_pages: used to return the number of pages of the range
+ *
+ * Walk the memory map for the largest EfiConventionalMemory range above
+ * 1MB. The range is not allocated, the caller is expected to do it with
+ * allocate_pages() and AllocateAddress.
+ */
+EFI_STATUS largest_free_range(EFI_PHYSICAL_ADDRESS max_addr,
+			      EFI_PHYSICAL_ADDRESS *start, UINT64 *nr_pages)
+{
+	UINTN map_size, map_key, desc_size;
+	EFI_MEMORY_DESCRIPTOR *map_buf;
+	UINTN d, map_end;
+	UINT32 desc_version;
+	EFI_STATUS err;
+
+	err = memory_map(&map_buf, &map_size, &map_key,
+			 &desc_size, &desc_version);
+	if (err != EFI_SUCCESS)
+		return err;
+
+	*nr_pages = 0;
+	map_end = (UINTN)map_buf + map_size;
+	for (d = (UINTN)map_buf; d < map_end; d += desc_size) {
+		EFI_MEMORY_DESCRIPTOR *desc;
+		EFI_PHYSICAL_ADDRESS range_start, range_end;
+
+		desc = (EFI_MEMORY_DESCRIPTOR *)d;
+		if (desc->Type != EfiConventionalMemory)
+			continue;
+
+		range_start = desc->PhysicalStart;
+		range_end = range_start + (desc->NumberOfPages << EFI_PAGE_SHIFT);
+
+		/* Low-memory is super-precious! */
+		if (range_start < (1 << 20))
+			range_start = (1 << 20);
+		if (range_end > max_addr)
+			range_end = max_addr & ~((EFI_PHYSICAL_ADDRESS)EFI_PAGE_SIZE - 1);
+		if (range_end <= range_start)
+			continue;
+
+		if (((range_end - range_start) >> EFI_PAGE_SHIFT) > *nr_pages) {
+			*start = range_start;
+			*nr_pages = (range_end - range_start) >> EFI_PAGE_SHIFT;
+		}
+	}
+
+	FreePool(map_buf);
+	return *nr_pages ? EFI_SUCCESS : EFI_OUT_OF_RESOURCES;
+}
+
 /**
  * efree - Return memory allocated with emalloc
  * @memory: the address of the emalloc() allocation
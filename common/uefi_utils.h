@@ -37,6 +37,7 @@
 #define offsetof(TYPE, MEMBER) ((UINTN) &((TYPE *)0)->MEMBER)
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof(*x))
 #define max(x,y) (x < y ? y : x)
+#define ALIGN_UP(x, a) (((x) + (a) - 1) & ~((a) - 1))
 
 /**
  * allocate_pages - Allocate memory pages from the system
@@ -178,19 +179,15 @@ EFI_STATUS uefi_msleep(UINTN mseconds);
 
 EFI_STATUS str_to_stra(CHAR8 *dst, CHAR16 *src, UINTN len);
 CHAR16 *stra_to_str(CHAR8 *src);
+/* Non allocating stra_to_str(), @size is the number of CHAR16 of @dst */
+EFI_STATUS stra_to_str_buf(CHAR16 *dst, UINTN size, CHAR8 *src);
 VOID StrNCpy(OUT CHAR16 *dest, IN const CHAR16 *src, UINT32 n);
 UINT8 getdigit(IN CHAR16 *str);
 EFI_STATUS string_to_guid(IN CHAR16 *in_guid_str, OUT EFI_GUID *guid);
 UINT32 swap_bytes32(UINT32 n);
 UINT16 swap_bytes16(UINT16 n);
 void copy_and_swap_guid(EFI_GUID *dst, const EFI_GUID *src);
-EFI_STATUS open_partition(
-                IN const EFI_GUID *guid,
-                OUT UINT32 *MediaIdPtr,
-                OUT EFI_BLOCK_IO **BlockIoPtr,
-                OUT EFI_DISK_IO **DiskIoPtr);
 void path_to_dos(CHAR16 *path);
-CHAR8 *append_strings(CHAR8 *s1, CHAR8 *s2);
 UINTN strtoul16(const CHAR16 *nptr, CHAR16 **endptr, UINTN base);
 UINTN split_cmdline(CHAR16 *cmdline, UINTN max_token, CHAR16 *args[]);
 
@@ -202,6 +199,8 @@ EFI_STATUS memory_map(EFI_MEMORY_DESCRIPTOR **map_buf,
 			     UINTN *desc_size, UINT32 *desc_version);
 EFI_STATUS emalloc(UINTN, UINTN, EFI_PHYSICAL_ADDRESS *);
 void efree(EFI_PHYSICAL_ADDRESS, UINTN);
+EFI_STATUS largest_free_range(EFI_PHYSICAL_ADDRESS max_addr,
+			      EFI_PHYSICAL_ADDRESS *start, UINT64 *nr_pages);
 
 /* Basic port I/O */
 static inline void outb(UINT16 port, UINT8 value)
@@ -63,7 +63,7 @@ endif
 EFILINUX_PROFILING_CFLAGS := -finstrument-functions -finstrument-functions-exclude-file-list=stack_chk.c,profiling.c,efilinux.h,stdlib.h,loaders/ -finstrument-functions-exclude-function-list=handover_kernel,checkpoint,exit_boot_services,setup_efi_memory_map,Print,SPrint,VSPrint,memory_map,stub_get_current_time_us,rdtsc,rdmsr
 EFILINUX_PROFILING_SRC_FILES := profiling.c
 
-EFILINUX_LIBRARIES := libuefi_log libuefi_utils libuefi_posix libuefi_cpu libuefi_time libuefi_stack_chk libuefi_bootimg libuefi_watchdog
+EFILINUX_LIBRARIES := libuefi_log libuefi_utils libuefi_posix libuefi_cpu libuefi_time libuefi_stack_chk libuefi_bootimg libuefi_watchdog libuefi_gpt libuefi_checkpoint libuefi_arena
 ################################################################################
 
 include $(CLEAR_VARS)
@@ -71,7 +71,8 @@ include $(CLEAR_VARS)
 LOCAL_MODULE := efilinux-user
 LOCAL_MODULE_TAGS := optional
 LOCAL_MODULE_PATH := $(PRODUCT_OUT)
-LOCAL_CFLAGS := $(EFILINUX_CFLAGS) -DCONFIG_LOG_LEVEL=LEVEL_ERROR
+LOCAL_CFLAGS := $(EFILINUX_CFLAGS) -DCONFIG_LOG_LEVEL=LEVEL_ERROR \
+	-DCONFIG_LOG_COMPILE_LEVEL=LEVEL_ERROR
 LOCAL_SRC_FILES := $(EFILINUX_SRC_FILES)
 LOCAL_C_INCLUDES := $(EFILINUX_C_INCLUDES)
 LOCAL_STATIC_LIBRARIES := $(EFILINUX_LIBRARIES) libuefi_profiling_stub
@@ -40,6 +40,8 @@
 #include "config.h"
 #include "fs.h"
 #include "pmic.h"
+#include <checkpoint.h>
+#include <arena.h>
 
 static enum targets boot_bcb(int dummy)
 {
@@ -293,8 +295,10 @@ enum targets target_from_inputs(enum flow_types flow_type)
 
 	if (!loader_ops.em_ops->is_battery_ok())
 		return TARGET_COLD_OFF;
+	loader_ops.prefetch_step();
 
 	ws = loader_ops.get_wake_source();
+	loader_ops.prefetch_step();
 	debug(L"Wake source = 0x%x\n", ws);
 	if (ws == WAKE_ERROR) {
 		error(L"Wake source couldn't be retrieved. Falling back in TARGET_BOOT\n");
@@ -305,6 +309,7 @@ enum targets target_from_inputs(enum flow_types flow_type)
 		return target_from_off(ws);
 
 	rs = loader_ops.get_reset_source();
+	loader_ops.prefetch_step();
 	if (rs == RESET_ERROR) {
 		error(L"Reset source couldn't be retrieved. Falling back in TARGET_BOOT\n");
 		return TARGET_BOOT;
@@ -329,12 +334,10 @@ CHAR8 *get_extra_cmdline(CHAR8 *cmdline)
 	extra_cmdline = loader_ops.get_extra_cmdline();
 	debug(L"Getting extra commandline: %a\n", extra_cmdline ? extra_cmdline : (CHAR8 *)"");
 
-	updated_cmdline = append_strings(extra_cmdline, cmdline);
+	updated_cmdline = arena_join_strings(&scratch_arena, extra_cmdline, cmdline);
 
 	if (extra_cmdline)
 		FreePool(extra_cmdline);
-	if (cmdline)
-		FreePool(cmdline);
 
 	return updated_cmdline;
 }
@@ -345,9 +348,7 @@ CHAR8 *check_vbattfreqlmt(CHAR8 *cmdline)
 
 	if (loader_ops.em_ops->is_battery_below_vbattfreqlmt()) {
 		debug(L"Battery voltage below vbattfreqlmt add battlow in cmdline\n");
-		updated_cmdline = append_strings((CHAR8 *)"battlow ", cmdline);
-		if (cmdline)
-			FreePool(cmdline);
+		updated_cmdline = arena_join_strings(&scratch_arena, (CHAR8 *)"battlow ", cmdline);
 	}
 
 	return updated_cmdline;
@@ -370,19 +371,17 @@ EFI_STATUS check_target(enum targets target)
 static EFI_STATUS launch_or_fallback(enum targets target, CHAR8 *cmdline)
 {
 	EFI_STATUS ret;
-	CHAR8 saved_cmdline[(cmdline ? strlena(cmdline) : 0) + 1];
-
-	if (cmdline) {
-		CopyMem(saved_cmdline, cmdline, strlena(cmdline) + 1);
-		FreePool(cmdline);
-	} else
-		saved_cmdline[0] = '\0';
+	struct arena_mark mark = arena_save(&scratch_arena);
 
+	/* Each target attempt is a boot phase of its own */
 	do {
+		arena_restore(&scratch_arena, mark);
+
 		target = em_fallback_target(target);
 
 		if (target == TARGET_COLD_OFF) {
 			debug(L"TARGET_COLD_OFF shutdown\n");
+			loader_ops.prefetch_abort();
 			loader_ops.do_cold_off();
 		}
 
@@ -394,7 +393,7 @@ static EFI_STATUS launch_or_fallback(enum targets target, CHAR8 *cmdline)
 		if (EFI_ERROR(ret))
 			warning(L"Failed to save the target_mode: %r\n", ret);
 
-		ret = loader_ops.load_target(target, saved_cmdline);
+		ret = loader_ops.load_target(target, cmdline);
 
 		target = fallback_target(target);
 	} while (target != TARGET_UNKNOWN);
@@ -414,10 +413,17 @@ EFI_STATUS start_boot_logic(CHAR8 *cmdline)
 	ret = loader_ops.check_partition_table();
 	if (EFI_ERROR(ret))
 		goto error;
+	checkpoint("partition_table");
+
+	/* TARGET_BOOT is by far the most likely outcome: start reading
+	 * it, one chunk between each decision step */
+	loader_ops.prefetch_target(TARGET_BOOT);
 
 	loader_ops.save_previous_target_mode(loader_ops.get_last_target_mode());
+	loader_ops.prefetch_step();
 
 	flow_type = loader_ops.read_flow_type();
+	loader_ops.prefetch_step();
 
 	target = target_from_inputs(flow_type);
 	if (target == TARGET_ERROR)
@@ -427,10 +433,15 @@ EFI_STATUS start_boot_logic(CHAR8 *cmdline)
 		target = TARGET_BOOT;
 	}
 	debug(L"target = 0x%x\n", target);
+	checkpoint("target");
+
+	loader_ops.prefetch_step();
 
 	loader_ops.display_splash(splash_intel, splash_intel_size);
+	loader_ops.prefetch_step();
 
 	updated_cmdline = check_vbattfreqlmt(cmdline);
+	loader_ops.prefetch_step();
 
 #ifdef RUNTIME_SETTINGS
 	updated_cmdline = get_extra_cmdline(updated_cmdline);
@@ -441,5 +452,8 @@ EFI_STATUS start_boot_logic(CHAR8 *cmdline)
 	ret = launch_or_fallback(target, updated_cmdline);
 
 error:
+	/* Nothing booted, the prefetched image must not stay in the way
+	 * of whatever runs next */
+	loader_ops.prefetch_abort();
 	return ret;
 }
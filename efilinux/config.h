@@ -77,6 +77,7 @@
 #endif	/* CONFIG_LOG_TIMESTAMP */
 
 #define EFILINUX_LOGS_VARNAME EFILINUX_VAR_PREFIX L"Logs"
+#define EFILINUX_CHECKPOINTS_VARNAME EFILINUX_VAR_PREFIX L"Checkpoints"
 
 extern enum loglevel log_level;
 extern BOOLEAN log_flush_to_variable;
@@ -50,6 +50,9 @@ extern EFI_HANDLE efilinux_image;
 extern EFI_HANDLE main_image_handle;
 extern void *efilinux_image_base;
 
+/* Save the function profiler trace, no-op unless built with profiling */
+void profiling_dump(void);
+
 #define PAGE_SIZE	4096
 
 static const CHAR16 *memory_types[] = {
@@ -36,6 +36,9 @@
 #include <stdlib.h>
 #include <string.h>
 #include <tco_reset.h>
+#include <checkpoint.h>
+#include <arena.h>
+#include <gpt.h>
 
 #include "efilinux.h"
 #include "acpi.h"
@@ -268,7 +271,7 @@ parse_args(CHAR16 *options, UINT32 size, CHAR16 *type, CHAR16 **name, CHAR8 **cm
 			int j;
 
 			j = StrLen(n);
-			*cmdline = malloc(j + 1);
+			*cmdline = arena_alloc(&scratch_arena, j + 1);
 			if (!*cmdline) {
 				error(L"Unable to alloc cmdline memory\n");
 				err = EFI_OUT_OF_RESOURCES;
@@ -314,9 +317,6 @@ usage:
 fail:
 	err = EFI_INVALID_PARAMETER;
 
-	if (*cmdline)
-		free(*cmdline);
-
 free_name:
 	if (*name)
 		free(*name);
@@ -512,12 +512,17 @@ efi_main(EFI_HANDLE image, EFI_SYSTEM_TABLE *_table)
 	sys_table = _table;
 	boot = sys_table->BootServices;
 	runtime = sys_table->RuntimeServices;
+	checkpoint("efi_main");
 
 	if (CheckCrc(ST->Hdr.HeaderSize, &ST->Hdr) != TRUE)
 		return EFI_LOAD_ERROR;
 
 	log_init();
 
+	/* Command line pieces live until the kernel jump, or until the
+	 * boot fails and everything is given back at once */
+	arena_init(&scratch_arena, SCRATCH_ARENA_SIZE);
+
 	info(banner, EFILINUX_VERSION_MAJOR, EFILINUX_VERSION_MINOR,
 		EFILINUX_BUILD_STRING, EFILINUX_VERSION_STRING,
 		EFILINUX_VERSION_DATE);
@@ -527,6 +532,7 @@ efi_main(EFI_HANDLE image, EFI_SYSTEM_TABLE *_table)
 	err = fs_init();
 	if (err != EFI_SUCCESS)
 		error(L"fs_init failed, DnX mode ?\n");
+	checkpoint("fs_init");
 
 	err = handle_protocol(image, &LoadedImageProtocol, (void **)&info);
 	if (err != EFI_SUCCESS)
@@ -548,6 +554,7 @@ efi_main(EFI_HANDLE image, EFI_SYSTEM_TABLE *_table)
 		options_size -= i;
 	} else
 		options_from_conf_file = TRUE;
+	checkpoint("read_config");
 
 	err = init_platform_functions();
 	if (EFI_ERROR(err)) {
@@ -565,6 +572,8 @@ efi_main(EFI_HANDLE image, EFI_SYSTEM_TABLE *_table)
 		/* We print the usage message in case of invalid args */
 		if (err == EFI_INVALID_PARAMETER) {
 			fs_exit();
+			gpt_free_cache();
+			arena_destroy(&scratch_arena);
 			return EFI_SUCCESS;
 		}
 
@@ -636,12 +645,12 @@ efi_main(EFI_HANDLE image, EFI_SYSTEM_TABLE *_table)
 	}
 
 free_args:
-	if (cmdline)
-		free(cmdline);
 	if (name)
 		free(name);
 fs_deinit:
 	fs_exit();
+	gpt_free_cache();
+	arena_destroy(&scratch_arena);
 	/*
 	 * We need to be careful not to trash 'err' here. If we fail
 	 * to allocate enough memory to hold the error string fallback
@@ -31,10 +31,13 @@
 #include <efilib.h>
 #include <uefi_utils.h>
 #include <bootimg.h>
+#include <check_signature.h>
+#include <gpt.h>
 #include <stdlib.h>
 #include <string.h>
 #include <bootloader.h>
 #include <tco_reset.h>
+#include <arena.h>
 
 #include "efilinux.h"
 #include "bootlogic.h"
@@ -122,6 +125,64 @@ static EFI_STATUS intel_go_to_rescue_mode(void)
 	return EFI_SUCCESS;
 }
 
+/* Boot image speculatively loaded while the boot logic is still
+ * deciding on the target */
+static struct bootimg_loader prefetch;
+static EFI_GUID prefetch_guid;
+static BOOLEAN prefetching;
+
+EFI_STATUS intel_prefetch_target(enum targets target)
+{
+	struct target_entry *entry;
+	EFI_STATUS ret;
+
+	entry = get_target_entry(target);
+	if (!entry || target == TARGET_DNX)
+		return EFI_UNSUPPORTED;
+
+	/* Signed images are verified as a whole, they cannot be
+	 * loaded in place */
+	if (check_signature_required())
+		return EFI_UNSUPPORTED;
+
+	ret = bootimg_load_begin(&prefetch, &entry->guid);
+	if (EFI_ERROR(ret)) {
+		warning(L"Failed to prefetch target %s: %r\n", entry->name, ret);
+		return ret;
+	}
+
+	debug(L"Prefetching target %s\n", entry->name);
+	CopyMem(&prefetch_guid, &entry->guid, sizeof(prefetch_guid));
+	prefetching = TRUE;
+	return EFI_SUCCESS;
+}
+
+/* Give back the kernel and ramdisk pages of an unused prefetch */
+void intel_prefetch_abort(void)
+{
+	if (!prefetching)
+		return;
+
+	debug(L"Discarding the prefetched boot image\n");
+	bootimg_load_abort(&prefetch);
+	prefetching = FALSE;
+}
+
+void intel_prefetch_step(void)
+{
+	EFI_STATUS ret;
+
+	if (!prefetching)
+		return;
+
+	ret = bootimg_load_step(&prefetch);
+	if (!EFI_ERROR(ret) || ret == EFI_END_OF_MEDIA)
+		return;
+
+	warning(L"Boot image prefetch failed: %r\n", ret);
+	intel_prefetch_abort();
+}
+
 EFI_STATUS intel_load_target(enum targets target, CHAR8 *cmdline)
 {
 	CHAR8 *updated_cmdline;
@@ -130,13 +191,16 @@ EFI_STATUS intel_load_target(enum targets target, CHAR8 *cmdline)
 	struct target_entry *entry = get_target_entry(target);
 	if (!entry) {
 		error(L"Target 0x%x not supported\n", target);
+		intel_prefetch_abort();
 		return EFI_UNSUPPORTED;
 	}
 
-	if (target == TARGET_DNX)
+	if (target == TARGET_DNX) {
+		intel_prefetch_abort();
 		return intel_go_to_rescue_mode();
+	}
 
-	updated_cmdline = append_strings(cmdline, entry->cmdline);
+	updated_cmdline = arena_join_strings(&scratch_arena, cmdline, entry->cmdline);
 
 	debug(L"target cmdline = %a\n", updated_cmdline ? updated_cmdline : (CHAR8 *)"");
 	debug(L"Loading target %s\n", entry->name);
@@ -145,6 +209,12 @@ EFI_STATUS intel_load_target(enum targets target, CHAR8 *cmdline)
 	hooks.before_jump = loader_ops.hook_before_jump;
 	hooks.watchdog = tco_start_watchdog;
 
+	if (prefetching && !CompareGuid(&prefetch_guid, &entry->guid)) {
+		prefetching = FALSE;
+		return bootimg_load_start(&prefetch, updated_cmdline, &hooks);
+	}
+	intel_prefetch_abort();
+
 	return android_image_start_partition(&entry->guid, updated_cmdline, &hooks);
 }
 
@@ -192,28 +262,29 @@ EFI_STATUS target_to_name(enum targets target, CHAR16 **name)
 	return EFI_INVALID_PARAMETER;
 }
 
-EFI_STATUS check_gpt(void) {
-	/* TODO */
-	debug(L"NOT IMPLEMENTED\n");
-	return EFI_SUCCESS;
+EFI_STATUS check_gpt(void)
+{
+	EFI_STATUS ret;
+
+	ret = gpt_check_partition_tables();
+	if (EFI_ERROR(ret))
+		error(L"No valid partition table found: %r\n", ret);
+	return ret;
 }
 
 static EFI_STATUS read_bcb(struct bootloader_message *bcb)
 {
 	EFI_STATUS ret;
-	EFI_BLOCK_IO *BlockIo;
-	EFI_DISK_IO *DiskIo;
-	UINT32 MediaId;
+	struct gpt_partition_interface *gparti;
 	EFI_GUID bcb_guid = MISC_GUID;
 
-	ret = open_partition(&bcb_guid, &MediaId, &BlockIo, &DiskIo);
+	ret = gpt_find_partition_by_guid(&bcb_guid, &gparti);
 	if (EFI_ERROR(ret)) {
 		warning(L"Misc partition not found: %r\n", ret);
 		return EFI_NOT_FOUND;
 	}
 
-	ret = uefi_call_wrapper(DiskIo->ReadDisk, 5, DiskIo, MediaId, 0,
-				sizeof(*bcb), bcb);
+	ret = gpt_read_partition(gparti, 0, sizeof(*bcb), bcb);
 	if (EFI_ERROR(ret)) {
 		warning(L"Could not read Misc partition: %r\n", ret);
 		return ret;
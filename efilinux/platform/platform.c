@@ -89,6 +89,19 @@ static EFI_STATUS stub_load_target(enum targets target, CHAR8 *cmdline)
 	return EFI_LOAD_ERROR;
 }
 
+static EFI_STATUS stub_prefetch_target(enum targets target)
+{
+	return EFI_UNSUPPORTED;
+}
+
+static void stub_prefetch_step(void)
+{
+}
+
+static void stub_prefetch_abort(void)
+{
+}
+
 static enum wake_sources stub_get_wake_source(void)
 {
 	warning(L"stubbed!\n");
@@ -248,6 +261,9 @@ struct osloader_ops loader_ops = {
 	.do_cold_off = stub_do_cold_off,
 	.populate_indicators = stub_populate_indicators,
 	.load_target = stub_load_target,
+	.prefetch_target = stub_prefetch_target,
+	.prefetch_step = stub_prefetch_step,
+	.prefetch_abort = stub_prefetch_abort,
 	.get_wake_source = stub_get_wake_source,
 	.get_reset_source = stub_get_reset_source,
 	.set_reset_source = stub_set_reset_source,
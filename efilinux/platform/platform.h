@@ -40,6 +40,9 @@ struct osloader_ops {
 	void (*do_cold_off)(void);
 	EFI_STATUS (*populate_indicators)(void);
 	EFI_STATUS (*load_target)(enum targets, CHAR8 *cmdline);
+	EFI_STATUS (*prefetch_target)(enum targets);
+	void (*prefetch_step)(void);
+	void (*prefetch_abort)(void);
 	enum wake_sources (*get_wake_source)(void);
 	enum reset_sources (*get_reset_source)(void);
 	EFI_STATUS (*set_reset_source)(enum reset_sources);
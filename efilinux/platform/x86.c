@@ -30,6 +30,7 @@
 #include <efi.h>
 #include <log.h>
 #include <uefi_utils.h>
+#include <checkpoint.h>
 #include "platform.h"
 #include "intel_partitions.h"
 #include "acpi.h"
@@ -42,9 +43,12 @@
 #include "config.h"
 #include "fs.h"
 #include "x86.h"
+#include "efilinux.h"
 
 static void x86_hook_before_exit()
 {
+	checkpoint_export(EFILINUX_CHECKPOINTS_VARNAME, &osloader_guid);
+	profiling_dump();
 	log_save_to_variable(EFILINUX_LOGS_VARNAME, &osloader_guid);
 	fs_close();
 }
@@ -65,6 +69,9 @@ void x86_ops(struct osloader_ops *ops)
 	ops->do_cold_off = uefi_shutdown;
 	ops->populate_indicators = rsci_populate_indicators;
 	ops->load_target = intel_load_target;
+	ops->prefetch_target = intel_prefetch_target;
+	ops->prefetch_step = intel_prefetch_step;
+	ops->prefetch_abort = intel_prefetch_abort;
 	ops->get_wake_source = rsci_get_wake_source;
 	ops->get_reset_source = get_reset_source;
 	ops->set_reset_source = rsci_set_reset_source;
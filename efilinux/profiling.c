@@ -27,20 +27,161 @@
  * OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <efi.h>
+#include <efilib.h>
+#include <cpu.h>
+#include <time.h>
+
 #include "efilinux.h"
-#include "log.h"
+#include "config.h"
+
+/*
+ * Function profiler driven by -finstrument-functions.
+ *
+ * Every function entry and exit appends one fixed size record to a
+ * preallocated ring buffer: the TSC and the function and caller
+ * addresses as offsets from the image base. Nothing is formatted on
+ * target, so the per call cost stays at a few dozen cycles instead of
+ * a Print() per call. The ring is dumped before the loader exits, to
+ * a file on the ESP or, as a fallback, to a volatile EFI variable, and
+ * is decoded on the host by tools/profile_decode.py.
+ */
+
+#ifndef CONFIG_PROFILE_EVENTS
+#define CONFIG_PROFILE_EVENTS	16384
+#endif
+
+#define PROFILE_MAGIC		0x52504645	/* "EFPR" */
+#define PROFILE_VERSION		1
+#define PROFILE_EXIT		0x80000000
+#define PROFILE_FILENAME	L"\\efilinux_profile.bin"
+#define PROFILE_VARNAME		EFILINUX_VAR_PREFIX L"Profile"
+#define PROFILE_VAR_EVENTS	2048
+
+struct profile_event {
+	UINT64 tsc;
+	UINT32 func;		/* PROFILE_EXIT set on function exit */
+	UINT32 caller;
+} __attribute__((packed));
+
+/* Layout shared with tools/profile_decode.py, keep them in sync. */
+struct profile_header {
+	UINT32 magic;
+	UINT16 version;
+	UINT16 event_size;
+	UINT64 image_base;
+	UINT64 tsc_khz;
+	UINT32 capacity;	/* number of event slots that follow */
+	UINT32 head;		/* slot of the oldest event when wrapped */
+	UINT64 total;		/* events recorded, including overwritten */
+} __attribute__((packed));
 
-#define trace(func, caller) \
-	if (efilinux_image_base) \
-		profile(L"func=%x caller=%x\n", func - efilinux_image_base, \
-			caller - efilinux_image_base);
+static struct {
+	struct profile_header hdr;
+	struct profile_event events[CONFIG_PROFILE_EVENTS];
+} __attribute__((packed)) ring;
+
+static UINT32 next;
+static UINT64 total;
+static BOOLEAN stopped;
+
+static inline void record(void *func, void *caller, UINT32 flags)
+{
+	struct profile_event *e;
+
+	if (!efilinux_image_base || stopped)
+		return;
+
+	e = &ring.events[next];
+	if (++next == CONFIG_PROFILE_EVENTS)
+		next = 0;
+	total++;
+
+	e->tsc = rdtsc();
+	e->func = (UINT32)(func - efilinux_image_base) | flags;
+	e->caller = (UINT32)(caller - efilinux_image_base);
+}
 
 void __cyg_profile_func_enter(void *func, void *caller)
 {
-	trace(func, caller);
+	record(func, caller, 0);
 }
 
 void __cyg_profile_func_exit(void *func, void *caller)
 {
-	trace(func, caller);
+	record(func, caller, PROFILE_EXIT);
+}
+
+static EFI_STATUS dump_to_file(void)
+{
+	EFI_STATUS ret;
+	EFI_FILE_IO_INTERFACE *io;
+	UINTN size;
+
+	size = sizeof(ring.hdr) + ring.hdr.capacity * sizeof(ring.events[0]);
+	ret = get_esp_fs(&io);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	return uefi_write_file(io, PROFILE_FILENAME, &ring, &size);
+}
+
+/* Variables are size limited, only keep the most recent events. */
+static EFI_STATUS dump_to_variable(void)
+{
+	EFI_STATUS ret;
+	struct profile_header *hdr;
+	struct profile_event *events;
+	UINT32 count, first, i;
+	UINTN size;
+
+	count = total < PROFILE_VAR_EVENTS ? total : PROFILE_VAR_EVENTS;
+	size = sizeof(*hdr) + count * sizeof(*events);
+	hdr = AllocatePool(size);
+	if (!hdr)
+		return EFI_OUT_OF_RESOURCES;
+
+	CopyMem(hdr, &ring.hdr, sizeof(*hdr));
+	hdr->capacity = count;
+	hdr->head = 0;
+
+	events = (struct profile_event *)(hdr + 1);
+	first = (next + CONFIG_PROFILE_EVENTS - count) % CONFIG_PROFILE_EVENTS;
+	for (i = 0; i < count; i++)
+		events[i] = ring.events[(first + i) % CONFIG_PROFILE_EVENTS];
+
+	ret = LibSetVariable(PROFILE_VARNAME, &osloader_guid, size, hdr);
+	FreePool(hdr);
+	return ret;
+}
+
+void profiling_dump(void)
+{
+	EFI_STATUS ret;
+
+	/* Stop recording, the dump itself goes through instrumented code. */
+	stopped = TRUE;
+
+	ring.hdr.magic = PROFILE_MAGIC;
+	ring.hdr.version = PROFILE_VERSION;
+	ring.hdr.event_size = sizeof(struct profile_event);
+	ring.hdr.image_base = (UINT64)(UINTN)efilinux_image_base;
+	ring.hdr.tsc_khz = get_tsc_khz();
+	ring.hdr.total = total;
+	if (total < CONFIG_PROFILE_EVENTS) {
+		ring.hdr.capacity = total;
+		ring.hdr.head = 0;
+	} else {
+		ring.hdr.capacity = CONFIG_PROFILE_EVENTS;
+		ring.hdr.head = next;
+	}
+
+	ret = dump_to_file();
+	if (EFI_ERROR(ret)) {
+		ret = dump_to_variable();
+		if (EFI_ERROR(ret))
+			warning(L"Failed to save profiling data: %r\n", ret);
+	}
+
+	stopped = FALSE;
 }
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Throughput of the CRC-32 kernels of common/crc32 from 64 bytes to
+ * 64MB, and the time crc32_fill() and crc32_zeros() take over the
+ * largest FILL and DONT_CARE chunks. The overhead column is the time
+ * the dispatched kernel adds to writing the same data at FLASH_RATE,
+ * the cost of verifying a sparse image while flashing it.
+ */
+
+#include "../../common/crc32/crc32.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define MIN_SIZE 64
+#define MAX_SIZE (64 * 1024 * 1024)
+/* Bytes hashed per measurement, whatever the size */
+#define VOLUME (1ULL << 30)
+/* Sequential write rate of a fast eMMC, bytes/s */
+#define FLASH_RATE 200e6
+
+static UINT32 slice8(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	return ~crc32_slice8(~crc, buf, len);
+}
+
+static UINT32 clmul(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	return ~crc32_clmul(~crc, buf, len);
+}
+
+static UINT32 dispatch(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	return crc32(crc, buf, len);
+}
+
+static struct {
+	const char *name;
+	UINT32 (*crc32)(UINT32 crc, const UINT8 *buf, UINTN len);
+	BOOLEAN supported;
+} variants[] = {
+	{ "slice-by-8", slice8, TRUE },
+	{ "pclmul", clmul, FALSE },
+	{ "dispatch", dispatch, TRUE },
+};
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* GB/s */
+static double bench(unsigned int v, UINT8 *buf, UINTN size)
+{
+	UINT64 i, count = VOLUME / size;
+	UINT32 crc = 0;
+	double start;
+
+	start = now();
+	for (i = 0; i < count; i++)
+		crc = variants[v].crc32(crc, buf, size);
+	asm volatile("" : : "r" (crc));
+	return (double)count * size / (now() - start) / 1e9;
+}
+
+/* microseconds per call */
+static double bench_fill(BOOLEAN zeros, UINT64 len)
+{
+	UINT64 i, count = 100000;
+	UINT32 crc = 0;
+	double start;
+
+	start = now();
+	for (i = 0; i < count; i++)
+		crc = zeros ? crc32_zeros(crc, len) : crc32_fill(crc, i, len);
+	asm volatile("" : : "r" (crc));
+	return (now() - start) / count * 1e6;
+}
+
+int main(void)
+{
+	static const UINT64 fill_sizes[] = { 4096, 1 << 20, 1ULL << 30, 1ULL << 40 };
+	double rate[ARRAY_SIZE(variants)];
+	unsigned int v;
+	UINTN size, i;
+	UINT8 *buf;
+
+	buf = malloc(MAX_SIZE);
+	if (!buf) {
+		perror("malloc");
+		return 1;
+	}
+	for (i = 0; i < MAX_SIZE; i++)
+		buf[i] = i * 31 + (i >> 8);
+
+	crc32(0, NULL, 0);
+	variants[1].supported = x86_cpu_has_feature(CPU_FEATURE_PCLMULQDQ) &&
+		x86_cpu_has_feature(CPU_FEATURE_SSE4_1);
+
+	printf("crc32, GB/s\n%10s", "size");
+	for (v = 0; v < ARRAY_SIZE(variants); v++)
+		printf("%12s", variants[v].name);
+	printf("%12s\n", "overhead");
+
+	for (size = MIN_SIZE; size <= MAX_SIZE; size *= 4) {
+		printf("%10lu", size);
+		for (v = 0; v < ARRAY_SIZE(variants); v++) {
+			rate[v] = variants[v].supported ? bench(v, buf, size) : 0;
+			printf("%12.2f", rate[v]);
+		}
+		printf("%11.2f%%\n", FLASH_RATE / 1e9 / rate[ARRAY_SIZE(variants) - 1] * 100);
+	}
+
+	printf("\nFILL and DONT_CARE chunks, us\n%14s%12s%12s\n", "size", "crc32_fill", "crc32_zeros");
+	for (i = 0; i < ARRAY_SIZE(fill_sizes); i++)
+		printf("%14llu%12.2f%12.2f\n", (unsigned long long)fill_sizes[i],
+		       bench_fill(FALSE, fill_sizes[i]), bench_fill(TRUE, fill_sizes[i]));
+
+	free(buf);
+	return 0;
+}
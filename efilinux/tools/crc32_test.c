@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks the CRC-32 kernels of common/crc32 (slice-by-8, PCLMULQDQ
+ * folding and the dispatched one) and crc32_zeros(), crc32_fill(),
+ * crc32_combine() against zlib vectors and a bitwise reference: every
+ * length up to 1KB at every alignment within a cache line, and
+ * computations split at every offset. The source is included so that
+ * the kernels can be called directly.
+ */
+
+#include "../../common/crc32/crc32.c"
+
+#include <stdio.h>
+#include <string.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define MAX_LEN 1024
+#define SLACK 64
+#define GB (1ULL << 30)
+
+static UINT32 slice8(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	return ~crc32_slice8(~crc, buf, len);
+}
+
+static UINT32 clmul(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	return ~crc32_clmul(~crc, buf, len);
+}
+
+static UINT32 dispatch(UINT32 crc, const UINT8 *buf, UINTN len)
+{
+	return crc32(crc, buf, len);
+}
+
+static struct {
+	const char *name;
+	UINT32 (*crc32)(UINT32 crc, const UINT8 *buf, UINTN len);
+	BOOLEAN supported;
+} variants[] = {
+	{ "slice-by-8", slice8, TRUE },
+	{ "pclmul", clmul, FALSE },
+	{ "dispatch", dispatch, TRUE },
+};
+
+/* zlib crc32() of gen_data() */
+static const struct {
+	UINTN len;
+	UINT32 crc;
+} vectors[] = {
+	{ 1, 0xd202ef8d },
+	{ 15, 0x06de9ac0 },
+	{ 16, 0xb8b411e5 },
+	{ 63, 0xd90481eb },
+	{ 64, 0x44d24382 },
+	{ 65, 0x4a941d72 },
+	{ 1000, 0xc8e54c0e },
+	{ 4096, 0x4e30eeb1 },
+	{ 65543, 0xbd45f190 },
+};
+
+#define CHECK		"123456789"
+#define CHECK_CRC	0xcbf43926
+#define FOX		"The quick brown fox jumps over the lazy dog"
+#define FOX_CRC		0x414fa339
+
+static UINT8 data[65543 + SLACK], buf[MAX_LEN + SLACK], zeros[MAX_LEN];
+static UINT32 ref[MAX_LEN + 1];
+static unsigned int failures;
+
+#define fail(fmt, ...) do {						\
+		fprintf(stderr, "FAIL %s: " fmt "\n", name, __VA_ARGS__); \
+		failures++;						\
+	} while (0)
+
+static void gen_data(UINT8 *p, UINTN len)
+{
+	UINTN i;
+
+	for (i = 0; i < len; i++)
+		p[i] = i * 31 + (i >> 8);
+}
+
+/* One bit at a time, straight from the polynomial */
+static UINT32 crc_ref(UINT32 crc, const UINT8 *p, UINTN len)
+{
+	unsigned int k;
+
+	crc = ~crc;
+	while (len--) {
+		crc ^= *p++;
+		for (k = 0; k < 8; k++)
+			crc = crc & 1 ? (crc >> 1) ^ CRC32_POLY : crc >> 1;
+	}
+	return ~crc;
+}
+
+static void check_kernel(const char *name, unsigned int v)
+{
+	UINT32 (*kernel)(UINT32, const UINT8 *, UINTN) = variants[v].crc32;
+	UINTN i, n, off;
+	UINT32 crc;
+
+	if (kernel(0, (const UINT8 *)CHECK, strlen(CHECK)) != CHECK_CRC)
+		fail("%s", "check value");
+	if (kernel(0, (const UINT8 *)FOX, strlen(FOX)) != FOX_CRC)
+		fail("%s", "quick brown fox");
+	if (kernel(0x12345678, data, 0) != 0x12345678)
+		fail("%s", "empty buffer");
+	for (i = 0; i < ARRAY_SIZE(vectors); i++)
+		if ((crc = kernel(0, data, vectors[i].len)) != vectors[i].crc)
+			fail("length %lu: 0x%08x, expected 0x%08x", vectors[i].len, crc,
+			     vectors[i].crc);
+
+	/* every length at every alignment */
+	for (n = 0; n <= MAX_LEN; n++)
+		for (off = 0; off < SLACK; off += n < 256 ? 1 : 7) {
+			memcpy(buf + off, data, n);
+			if ((crc = kernel(0, buf + off, n)) != ref[n])
+				fail("length %lu at +%lu: 0x%08x, expected 0x%08x", n, off,
+				     crc, ref[n]);
+		}
+
+	/* computation split at every offset */
+	for (i = 0; i <= MAX_LEN; i++) {
+		crc = kernel(kernel(0, data, i), data + i, MAX_LEN - i);
+		if (crc != ref[MAX_LEN])
+			fail("split at %lu: 0x%08x, expected 0x%08x", i, crc, ref[MAX_LEN]);
+	}
+}
+
+static void check_zeros(void)
+{
+	static const struct {
+		UINT64 len;
+		UINT32 crc;
+	} zero_vectors[] = {
+		{ 1, 0xd202ef8d },
+		{ 32, 0x190a55ad },
+		{ 4096, 0xc71c0011 },
+		{ 1 << 20, 0xa738ea1c },
+		{ GB, 0x5b64c2b0 },
+	};
+	const char *name = "crc32_zeros";
+	UINTN i;
+	UINT32 crc;
+
+	for (i = 0; i < ARRAY_SIZE(zero_vectors); i++)
+		if ((crc = crc32_zeros(0, zero_vectors[i].len)) != zero_vectors[i].crc)
+			fail("length %llu: 0x%08x, expected 0x%08x",
+			     (unsigned long long)zero_vectors[i].len, crc, zero_vectors[i].crc);
+	if ((crc = crc32_zeros(CHECK_CRC, GB)) != 0x84214fd9)
+		fail("1GB after the check value: 0x%08x", crc);
+
+	for (i = 0; i <= MAX_LEN; i++)
+		if (crc32_zeros(CHECK_CRC, i) != crc_ref(CHECK_CRC, zeros, i))
+			fail("length %lu", i);
+}
+
+static void check_fill(void)
+{
+	const char *name = "crc32_fill";
+	UINT32 pattern = 0xdeadbeef;
+	UINTN i;
+	UINT32 crc;
+
+	if ((crc = crc32_fill(0, pattern, 4099)) != 0x5a8d0f94)
+		fail("length 4099: 0x%08x", crc);
+	if ((crc = crc32_fill(0, pattern, GB + 3)) != 0x58c6cb73)
+		fail("length 1GB + 3: 0x%08x", crc);
+	if ((crc = crc32_fill(CHECK_CRC, pattern, GB + 3)) != 0x975b681a)
+		fail("1GB + 3 after the check value: 0x%08x", crc);
+
+	for (i = 0; i < MAX_LEN; i += sizeof(pattern))
+		memcpy(buf + i, &pattern, sizeof(pattern));
+	for (i = 0; i <= MAX_LEN; i++)
+		if (crc32_fill(CHECK_CRC, pattern, i) != crc_ref(CHECK_CRC, buf, i))
+			fail("length %lu", i);
+}
+
+static void check_combine(void)
+{
+	const char *name = "crc32_combine";
+	UINT32 a, b, crc;
+	UINTN i;
+
+	a = crc32(0, CHECK, strlen(CHECK));
+	b = crc32(0, data, 1000);
+	if ((crc = crc32_combine(a, b, 1000)) != 0xd5664088)
+		fail("check value and 1000 bytes: 0x%08x", crc);
+	if ((crc = crc32_combine(CHECK_CRC, crc32_zeros(0, GB), GB)) != 0x84214fd9)
+		fail("check value and 1GB of zeros: 0x%08x", crc);
+	if (crc32_combine(a, 0, 0) != a)
+		fail("%s", "empty second part");
+
+	for (i = 0; i <= MAX_LEN; i++) {
+		crc = crc32_combine(crc32(0, data, i), crc32(0, data + i, MAX_LEN - i),
+				    MAX_LEN - i);
+		if (crc != ref[MAX_LEN])
+			fail("split at %lu: 0x%08x, expected 0x%08x", i, crc, ref[MAX_LEN]);
+	}
+}
+
+int main(void)
+{
+	unsigned int v;
+	UINTN n;
+
+	gen_data(data, sizeof(data));
+	for (n = 0; n <= MAX_LEN; n++)
+		ref[n] = crc_ref(0, data, n);
+
+	/* the kernels are called directly, the tables are built on first use */
+	crc32(0, NULL, 0);
+	variants[1].supported = x86_cpu_has_feature(CPU_FEATURE_PCLMULQDQ) &&
+		x86_cpu_has_feature(CPU_FEATURE_SSE4_1);
+
+	for (v = 0; v < ARRAY_SIZE(variants); v++) {
+		if (!variants[v].supported) {
+			printf("%s: not supported by this CPU, skipped\n", variants[v].name);
+			continue;
+		}
+		check_kernel(variants[v].name, v);
+	}
+	check_zeros();
+	check_fill();
+	check_combine();
+
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Flashes sparse images split the way the host splits them, each part
+ * covering the whole partition with DONT_CARE chunks around its own
+ * data, to a RAM disk through fastboot/flash.c. Checks the disk content,
+ * the blocks written by each part and the progress of the sessions:
+ * parts of different partitions interleaved, a part sent again after a
+ * write error and written again in full, a new image replacing an
+ * unfinished one. An eMMC host
+ * controller erases the whole groups of the zero fills.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <efi.h>
+#include <efilib.h>
+#include <gpt.h>
+#include "flash.h"
+#include "sparse_format.h"
+/* flash.c owns the GUID */
+#define gEfiSdHostIoProtocolGuid test_sd_host_guid
+#include "SdHostIo.h"
+#undef gEfiSdHostIoProtocolGuid
+#include "Mmc.h"
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define SECTOR_SIZE	512
+#define BLK_SZ		4096
+#define TOTAL_BLKS	256
+#define PART_SIZE	(TOTAL_BLKS * BLK_SZ)
+#define PARTITIONS	5
+#define DISK_SIZE	((PARTITIONS + 1) * PART_SIZE)
+#define ERASE_GRP	1024	/* sectors, HC_ERASE_GRP_SIZE 1 */
+
+enum { RAW, FILL };
+
+/* Data of an image, in the order of the parts it goes to */
+struct chunk {
+	UINTN part;
+	UINT32 type;
+	UINT32 blk;
+	UINT32 count;
+	UINT32 seed;		/* or fill pattern */
+};
+
+/* Leading and in-part holes followed by data, no trailing hole: the
+ * whole image is accounted for once the last part is flashed */
+static const struct chunk image_a[] = {
+	{ 0, RAW, 0, 16, 1 },
+	{ 0, FILL, 20, 10, 0xA5A5A5A5 },
+	{ 1, RAW, 40, 20, 2 },
+	{ 1, RAW, 70, 10, 3 },
+	{ 2, RAW, 100, 60, 4 },
+	{ 2, FILL, 160, 40, 0x5A5A5A5A },
+	{ 2, RAW, 200, 56, 5 },
+};
+#define IMAGE_A_PARTS 3
+
+/* Same layout, other content */
+static struct chunk image_b[ARRAY_SIZE(image_a)];
+
+static UINT8 disk[DISK_SIZE];
+static UINT8 writes[DISK_SIZE / BLK_SZ];
+static UINTN write_calls, fail_call;
+static UINT32 erase_start, erase_end;
+static UINTN erases, bad_erases;
+
+static EFI_BLOCK_IO_MEDIA media = {
+	.MediaId = 1,
+	.MediaPresent = TRUE,
+	.BlockSize = SECTOR_SIZE,
+	.LastBlock = DISK_SIZE / SECTOR_SIZE - 1,
+};
+static EFI_BLOCK_IO bio = { .Media = &media };
+static EFI_DISK_IO dio;
+static struct gpt_partition_interface partitions[PARTITIONS];
+static const CHAR16 *labels[PARTITIONS] = {
+	L"system", L"vendor", L"cache", L"data", L"oem"
+};
+
+static unsigned int failures;
+static const char *test_name;
+
+#define fail(fmt, ...) do {						\
+		fprintf(stderr, "FAIL %s: " fmt "\n", test_name, __VA_ARGS__); \
+		failures++;						\
+	} while (0)
+
+static EFI_STATUS write_disk(EFI_DISK_IO *This, UINT32 MediaId, UINT64 Offset,
+			     UINTN BufferSize, VOID *Buffer)
+{
+	UINT64 blk;
+
+	if (++write_calls == fail_call)
+		return EFI_DEVICE_ERROR;
+	if (MediaId != media.MediaId || Offset + BufferSize > DISK_SIZE)
+		return EFI_INVALID_PARAMETER;
+
+	memcpy(disk + Offset, Buffer, BufferSize);
+	for (blk = Offset / BLK_SZ; blk * BLK_SZ < Offset + BufferSize; blk++)
+		writes[blk]++;
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS read_disk(EFI_DISK_IO *This, UINT32 MediaId, UINT64 Offset,
+			    UINTN BufferSize, VOID *Buffer)
+{
+	if (MediaId != media.MediaId || Offset + BufferSize > DISK_SIZE)
+		return EFI_INVALID_PARAMETER;
+	memcpy(Buffer, disk + Offset, BufferSize);
+	return EFI_SUCCESS;
+}
+
+EFI_STATUS gpt_find_partition_by_label(const CHAR16 *label,
+				       struct gpt_partition_interface **gpart)
+{
+	UINTN i;
+
+	for (i = 0; i < PARTITIONS; i++)
+		if (!StrCmp(label, labels[i])) {
+			*gpart = &partitions[i];
+			return EFI_SUCCESS;
+		}
+	return EFI_NOT_FOUND;
+}
+
+static EFI_STATUS write_blocks(EFI_BLOCK_IO *This, UINT32 MediaId, EFI_LBA Lba,
+			       UINTN BufferSize, VOID *Buffer)
+{
+	return write_disk(&dio, MediaId, Lba * SECTOR_SIZE, BufferSize, Buffer);
+}
+
+/* eMMC with 512KB erase groups, erased to zeros */
+static EFI_STATUS send_command(EFI_SD_HOST_IO_PROTOCOL *This, UINT16 CommandIndex,
+			       UINT32 Argument, TRANSFER_TYPE DataType, UINT8 *Buffer,
+			       UINT32 BufferSize, RESPONSE_TYPE ResponseType,
+			       UINT32 TimeOut, UINT32 *ResponseData)
+{
+	EXT_CSD *ext_csd = (EXT_CSD *)Buffer;
+
+	switch (CommandIndex) {
+	case SEND_EXT_CSD:
+		memset(ext_csd, 0, sizeof(*ext_csd));
+		ext_csd->HC_ERASE_GRP_SIZE = ERASE_GRP / 1024;
+		ext_csd->ERASE_TIMEOUT_MULT = 1;
+		ext_csd->ERASED_MEM_CONT = 0;
+		break;
+	case ERASE_GROUP_START:
+		erase_start = Argument;
+		break;
+	case ERASE_GROUP_END:
+		erase_end = Argument;
+		break;
+	case ERASE:
+		erases++;
+		if (erase_start > erase_end || erase_start % ERASE_GRP ||
+		    (erase_end + 1) % ERASE_GRP || (erase_end + 1) * SECTOR_SIZE > DISK_SIZE) {
+			bad_erases++;
+			return EFI_INVALID_PARAMETER;
+		}
+		memset(disk + erase_start * SECTOR_SIZE, 0,
+		       (erase_end - erase_start + 1) * SECTOR_SIZE);
+		break;
+	default:
+		return EFI_UNSUPPORTED;
+	}
+	return EFI_SUCCESS;
+}
+
+static EFI_SD_HOST_IO_PROTOCOL sd_host = {
+	.HostCapability = { .BoundarySize = 512 },
+	.SendCommand = send_command,
+};
+
+EFI_STATUS LibLocateProtocol(EFI_GUID *protocol, VOID **interface)
+{
+	*interface = &sd_host;
+	return EFI_SUCCESS;
+}
+
+static void disk_init(void)
+{
+	UINTN i;
+
+	dio.ReadDisk = read_disk;
+	dio.WriteDisk = write_disk;
+	bio.WriteBlocks = write_blocks;
+	for (i = 0; i < PARTITIONS; i++) {
+		partitions[i].part.starting_lba = (i + 1) * PART_SIZE / SECTOR_SIZE;
+		partitions[i].part.ending_lba = (i + 2) * PART_SIZE / SECTOR_SIZE - 1;
+		memcpy(partitions[i].part.name, labels[i], (StrLen(labels[i]) + 1) * sizeof(CHAR16));
+		partitions[i].bio = &bio;
+		partitions[i].dio = &dio;
+		partitions[i].media_id = media.MediaId;
+	}
+	memset(disk, 0, sizeof(disk));
+}
+
+static UINT8 *partition_data(UINTN partition)
+{
+	return disk + (partition + 1) * PART_SIZE;
+}
+
+static UINT8 *partition_writes(UINTN partition)
+{
+	return writes + (partition + 1) * TOTAL_BLKS;
+}
+
+static void chunk_data(const struct chunk *c, UINT8 *buf)
+{
+	UINTN i;
+
+	for (i = 0; i < c->count * BLK_SZ; i++) {
+		if (c->type == FILL)
+			buf[i] = c->seed >> (8 * (i % 4));
+		else
+			buf[i] = (c->seed * 131 + i * 7 + i / BLK_SZ) & 0xFF;
+	}
+}
+
+/* The partition content the image leaves */
+static void image_content(const struct chunk *image, UINTN count, UINT8 *buf)
+{
+	UINTN i;
+
+	memset(buf, 0, PART_SIZE);
+	for (i = 0; i < count; i++)
+		chunk_data(&image[i], buf + image[i].blk * BLK_SZ);
+}
+
+static UINT8 *emit_chunk(UINT8 *p, UINT16 type, UINT32 blks, UINT32 payload)
+{
+	chunk_header_t ckh = { type, 0, blks, sizeof(ckh) + payload };
+
+	memcpy(p, &ckh, sizeof(ckh));
+	return p + sizeof(ckh);
+}
+
+/* Sparse image of the chunks of @part, DONT_CARE everywhere else */
+static UINTN build_part(const struct chunk *image, UINTN count, UINTN part, UINT8 *out)
+{
+	sparse_header_t sph = {
+		SPARSE_HEADER_MAGIC, 1, 0, sizeof(sparse_header_t),
+		sizeof(chunk_header_t), BLK_SZ, TOTAL_BLKS, 0, 0
+	};
+	UINT8 *p = out + sizeof(sph);
+	UINT32 blk = 0;
+	UINTN i;
+
+	for (i = 0; i < count; i++) {
+		if (image[i].part != part)
+			continue;
+		if (image[i].blk > blk) {
+			p = emit_chunk(p, CHUNK_TYPE_DONT_CARE, image[i].blk - blk, 0);
+			sph.total_chunks++;
+		}
+		if (image[i].type == FILL) {
+			p = emit_chunk(p, CHUNK_TYPE_FILL, image[i].count, sizeof(UINT32));
+			memcpy(p, &image[i].seed, sizeof(UINT32));
+			p += sizeof(UINT32);
+		} else {
+			p = emit_chunk(p, CHUNK_TYPE_RAW, image[i].count, image[i].count * BLK_SZ);
+			chunk_data(&image[i], p);
+			p += image[i].count * BLK_SZ;
+		}
+		sph.total_chunks++;
+		blk = image[i].blk + image[i].count;
+	}
+	if (blk < TOTAL_BLKS) {
+		p = emit_chunk(p, CHUNK_TYPE_DONT_CARE, TOTAL_BLKS - blk, 0);
+		sph.total_chunks++;
+	}
+
+	memcpy(out, &sph, sizeof(sph));
+	return p - out;
+}
+
+static UINT8 part_buf[PART_SIZE + 64 * 1024];
+static UINT8 expected[PART_SIZE];
+
+static EFI_STATUS flash_part(UINTN partition, const struct chunk *image, UINTN part)
+{
+	UINTN size = build_part(image, ARRAY_SIZE(image_a), part, part_buf);
+
+	return flash(part_buf, size, (CHAR16 *)labels[partition]);
+}
+
+static void expect_progress(UINT32 accounted)
+{
+	UINT32 got, total;
+
+	if (!flash_session_progress(&got, &total))
+		fail("%s", "no session");
+	else if (got != accounted || total != TOTAL_BLKS)
+		fail("%u/%u blocks accounted for, expected %u/%u", got, total,
+		     accounted, TOTAL_BLKS);
+}
+
+static void expect_content(UINTN partition, const struct chunk *image)
+{
+	UINTN i;
+
+	image_content(image, ARRAY_SIZE(image_a), expected);
+	for (i = 0; i < TOTAL_BLKS; i++)
+		if (memcmp(partition_data(partition) + i * BLK_SZ, expected + i * BLK_SZ, BLK_SZ)) {
+			fail("partition %lu block %lu differs", (unsigned long)partition,
+			     (unsigned long)i);
+			return;
+		}
+}
+
+/* Each data block of @image written @times, plus the writes of a
+ * failed attempt in @again if any */
+static void expect_writes(UINTN partition, const struct chunk *image, UINT8 times,
+			  const UINT8 *again)
+{
+	UINT8 w[TOTAL_BLKS] = { 0 };
+	UINTN i, b;
+
+	for (i = 0; i < ARRAY_SIZE(image_a); i++)
+		for (b = image[i].blk; b < image[i].blk + image[i].count; b++)
+			w[b] = times;
+	if (again)
+		for (b = 0; b < TOTAL_BLKS; b++)
+			w[b] += again[b];
+	for (b = 0; b < TOTAL_BLKS; b++)
+		if (partition_writes(partition)[b] != w[b]) {
+			fail("partition %lu block %lu written %u times, expected %u",
+			     (unsigned long)partition, (unsigned long)b,
+			     partition_writes(partition)[b], w[b]);
+			return;
+		}
+}
+
+/* Flashes @part of @image to @partition, failing its second write,
+ * and records the blocks written before the failure in @again */
+static EFI_STATUS flash_part_failing(UINTN partition, const struct chunk *image, UINTN part,
+				     UINT8 *again)
+{
+	EFI_STATUS ret;
+	UINTN b;
+
+	memcpy(again, partition_writes(partition), TOTAL_BLKS);
+	fail_call = write_calls + 2;
+	ret = flash_part(partition, image, part);
+	fail_call = 0;
+	for (b = 0; b < TOTAL_BLKS; b++)
+		again[b] = partition_writes(partition)[b] - again[b];
+	return ret;
+}
+
+static void reset(void)
+{
+	UINTN i;
+
+	/* a raw flash drops the sessions left by the previous test */
+	for (i = 0; i < PARTITIONS; i++)
+		flash(expected, BLK_SZ, (CHAR16 *)labels[i]);
+	memset(disk, 0, sizeof(disk));
+	memset(writes, 0, sizeof(writes));
+	write_calls = fail_call = 0;
+	erases = bad_erases = 0;
+}
+
+static void test_split_image(void)
+{
+	UINTN part;
+
+	reset();
+	test_name = "split image";
+	for (part = 0; part < IMAGE_A_PARTS; part++)
+		if (EFI_ERROR(flash_part(0, image_a, part)))
+			fail("part %lu failed", (unsigned long)part);
+	expect_progress(TOTAL_BLKS);
+	expect_content(0, image_a);
+	expect_writes(0, image_a, 1, NULL);
+}
+
+static void test_interleaved(void)
+{
+	UINT8 again[TOTAL_BLKS];
+	UINTN part;
+
+	reset();
+	test_name = "interleaved partitions";
+	for (part = 0; part < IMAGE_A_PARTS; part++) {
+		if (EFI_ERROR(flash_part(0, image_a, part)) ||
+		    EFI_ERROR(flash_part(1, image_b, part)))
+			fail("part %lu failed", (unsigned long)part);
+	}
+	expect_progress(TOTAL_BLKS);
+	expect_content(0, image_a);
+	expect_content(1, image_b);
+	expect_writes(0, image_a, 1, NULL);
+	expect_writes(1, image_b, 1, NULL);
+
+	/* the session of the first partition outlives the other one's */
+	reset();
+	flash_part(0, image_a, 0);
+	flash_part_failing(0, image_a, 1, again);
+	flash_part(1, image_b, 0);
+	flash_part(1, image_b, 1);
+	flash_part(0, image_a, 1);
+	flash_part(0, image_a, 2);
+	expect_progress(TOTAL_BLKS);
+	expect_content(0, image_a);
+	expect_writes(0, image_a, 1, again);
+}
+
+static void test_part_sent_again(void)
+{
+	UINT8 again[TOTAL_BLKS];
+
+	reset();
+	test_name = "part sent again";
+	flash_part(0, image_a, 0);
+	expect_progress(30);
+
+	/* the second run of the part fails to be written */
+	if (!EFI_ERROR(flash_part_failing(0, image_a, 1, again)))
+		fail("%s", "write error not reported");
+	if (!memchr(again, 1, TOTAL_BLKS))
+		fail("%s", "nothing written before the error");
+
+	if (EFI_ERROR(flash_part(0, image_a, 1)))
+		fail("%s", "part failed when sent again");
+	flash_part(0, image_a, 2);
+	expect_progress(TOTAL_BLKS);
+	expect_content(0, image_a);
+	expect_writes(0, image_a, 1, again);
+}
+
+static void test_new_image(void)
+{
+	UINTN part;
+
+	reset();
+	test_name = "new image over an unfinished one";
+	flash_part(0, image_a, 0);
+	flash_part(0, image_a, 1);
+	for (part = 0; part < IMAGE_A_PARTS; part++)
+		if (EFI_ERROR(flash_part(0, image_b, part)))
+			fail("part %lu failed", (unsigned long)part);
+	expect_progress(TOTAL_BLKS);
+	expect_content(0, image_b);
+}
+
+static void test_evicted(void)
+{
+	UINTN part, p;
+
+	reset();
+	test_name = "more partitions than sessions";
+	for (part = 0; part < IMAGE_A_PARTS; part++)
+		for (p = 0; p < PARTITIONS; p++)
+			if (EFI_ERROR(flash_part(p, image_a, part)))
+				fail("partition %lu part %lu failed", (unsigned long)p,
+				     (unsigned long)part);
+	for (p = 0; p < PARTITIONS; p++)
+		expect_content(p, image_a);
+}
+
+/* One group long but across two groups, then one whole group and
+ * half of the previous one */
+static const struct chunk zeros[] = {
+	{ 3, FILL, 10, ERASE_GRP * SECTOR_SIZE / BLK_SZ, 0 },
+	{ 4, FILL, 64, 192, 0 },
+};
+
+static void test_zero_fill(void)
+{
+	UINTN size;
+
+	reset();
+	test_name = "zero fill";
+	memset(partition_data(3), 0xFF, 2 * PART_SIZE);
+
+	size = build_part(zeros, ARRAY_SIZE(zeros), 3, part_buf);
+	if (EFI_ERROR(flash(part_buf, size, (CHAR16 *)labels[3])))
+		fail("%s", "unaligned group failed");
+	if (erases)
+		fail("%lu erases of an unaligned group", (unsigned long)erases);
+
+	size = build_part(zeros, ARRAY_SIZE(zeros), 4, part_buf);
+	if (EFI_ERROR(flash(part_buf, size, (CHAR16 *)labels[4])))
+		fail("%s", "whole group failed");
+	if (erases != 1 || bad_erases)
+		fail("%lu erases, %lu out of the groups, expected 1", (unsigned long)erases,
+		     (unsigned long)bad_erases);
+
+	image_content(zeros, 1, expected);
+	memset(expected, 0xFF, 10 * BLK_SZ);
+	memset(expected + 138 * BLK_SZ, 0xFF, PART_SIZE - 138 * BLK_SZ);
+	if (memcmp(partition_data(3), expected, PART_SIZE))
+		fail("%s", "unaligned group not filled");
+	memset(expected, 0xFF, 64 * BLK_SZ);
+	memset(expected + 64 * BLK_SZ, 0, PART_SIZE - 64 * BLK_SZ);
+	if (memcmp(partition_data(4), expected, PART_SIZE))
+		fail("%s", "whole group not filled");
+}
+
+int main(void)
+{
+	UINTN i;
+
+	for (i = 0; i < ARRAY_SIZE(image_a); i++) {
+		image_b[i] = image_a[i];
+		image_b[i].seed = ~image_a[i].seed;
+	}
+	disk_init();
+
+	test_split_image();
+	test_interleaved();
+	test_part_sent_again();
+	test_new_image();
+	test_evicted();
+	test_zero_fill();
+
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Minimal gnu-efi types for host builds of the tests and benchmarks:
+ * only what the common code built by tools/Makefile needs, protocols
+ * and services reduced to the members that code uses.
+ */
+
+#ifndef _HOST_EFI_H_
+#define _HOST_EFI_H_
+
+#include <stdint.h>
+#include <stdarg.h>
+
+typedef uint8_t UINT8;
+typedef uint16_t UINT16;
+typedef uint32_t UINT32;
+typedef uint64_t UINT64;
+typedef int8_t INT8;
+typedef int16_t INT16;
+typedef int32_t INT32;
+typedef int64_t INT64;
+typedef uintptr_t UINTN;
+typedef intptr_t INTN;
+typedef unsigned char BOOLEAN;
+typedef unsigned char CHAR8;
+typedef uint16_t CHAR16;
+typedef void VOID;
+
+typedef UINTN EFI_STATUS;
+typedef VOID *EFI_HANDLE;
+typedef VOID *EFI_EVENT;
+typedef UINTN EFI_TPL;
+typedef UINT64 EFI_LBA;
+typedef UINT64 EFI_PHYSICAL_ADDRESS;
+typedef UINT64 EFI_VIRTUAL_ADDRESS;
+
+#define TRUE	1
+#define FALSE	0
+#ifndef NULL
+#define NULL	((VOID *)0)
+#endif
+
+#define IN
+#define OUT
+#define OPTIONAL
+#define EFIAPI
+
+#define uefi_call_wrapper(func, va_num, ...) func(__VA_ARGS__)
+
+#define EFIERR(a)		(((UINTN)1 << (sizeof(UINTN) * 8 - 1)) | (a))
+#define EFI_ERROR(a)		(((INTN)(a)) < 0)
+
+#define EFI_SUCCESS		0
+#define EFI_LOAD_ERROR		EFIERR(1)
+#define EFI_INVALID_PARAMETER	EFIERR(2)
+#define EFI_UNSUPPORTED		EFIERR(3)
+#define EFI_BAD_BUFFER_SIZE	EFIERR(4)
+#define EFI_BUFFER_TOO_SMALL	EFIERR(5)
+#define EFI_NOT_READY		EFIERR(6)
+#define EFI_DEVICE_ERROR	EFIERR(7)
+#define EFI_WRITE_PROTECTED	EFIERR(8)
+#define EFI_OUT_OF_RESOURCES	EFIERR(9)
+#define EFI_VOLUME_CORRUPTED	EFIERR(10)
+#define EFI_NOT_FOUND		EFIERR(14)
+#define EFI_ACCESS_DENIED	EFIERR(15)
+#define EFI_TIMEOUT		EFIERR(18)
+#define EFI_ABORTED		EFIERR(21)
+#define EFI_CRC_ERROR		EFIERR(27)
+#define EFI_END_OF_MEDIA	EFIERR(28)
+#define EFI_END_OF_FILE		EFIERR(31)
+#define EFI_WARN_DELETE_FAILURE	2
+
+typedef struct {
+	UINT32 Data1;
+	UINT16 Data2;
+	UINT16 Data3;
+	UINT8 Data4[8];
+} EFI_GUID;
+
+typedef struct {
+	UINT16 Year;
+	UINT8 Month;
+	UINT8 Day;
+	UINT8 Hour;
+	UINT8 Minute;
+	UINT8 Second;
+	UINT8 Pad1;
+	UINT32 Nanosecond;
+	INT16 TimeZone;
+	UINT8 Daylight;
+	UINT8 Pad2;
+} EFI_TIME;
+
+/* Memory */
+
+#define EFI_PAGE_SIZE		4096
+#define EFI_PAGE_SHIFT		12
+#define EFI_SIZE_TO_PAGES(a)	(((a) >> EFI_PAGE_SHIFT) + (((a) & (EFI_PAGE_SIZE - 1)) ? 1 : 0))
+
+typedef enum {
+	AllocateAnyPages,
+	AllocateMaxAddress,
+	AllocateAddress,
+	MaxAllocateType
+} EFI_ALLOCATE_TYPE;
+
+typedef enum {
+	EfiReservedMemoryType,
+	EfiLoaderCode,
+	EfiLoaderData,
+	EfiBootServicesCode,
+	EfiBootServicesData,
+	EfiRuntimeServicesCode,
+	EfiRuntimeServicesData,
+	EfiConventionalMemory,
+	EfiUnusableMemory,
+	EfiACPIReclaimMemory,
+	EfiACPIMemoryNVS,
+	EfiMemoryMappedIO,
+	EfiMemoryMappedIOPortSpace,
+	EfiPalCode,
+	EfiMaxMemoryType
+} EFI_MEMORY_TYPE;
+
+typedef struct {
+	UINT32 Type;
+	UINT32 Pad;
+	EFI_PHYSICAL_ADDRESS PhysicalStart;
+	EFI_VIRTUAL_ADDRESS VirtualStart;
+	UINT64 NumberOfPages;
+	UINT64 Attribute;
+} EFI_MEMORY_DESCRIPTOR;
+
+/* Protocols, reduced to the members the tree calls */
+
+typedef struct {
+	UINT8 Type;
+	UINT8 SubType;
+	UINT8 Length[2];
+} EFI_DEVICE_PATH;
+
+typedef struct {
+	UINT8 Blue;
+	UINT8 Green;
+	UINT8 Red;
+	UINT8 Reserved;
+} EFI_GRAPHICS_OUTPUT_BLT_PIXEL;
+
+typedef enum {
+	EfiBltVideoFill,
+	EfiBltVideoToBltBuffer,
+	EfiBltBufferToVideo,
+	EfiBltVideoToVideo
+} EFI_GRAPHICS_OUTPUT_BLT_OPERATION;
+
+typedef struct {
+	UINT32 Version;
+	UINT32 HorizontalResolution;
+	UINT32 VerticalResolution;
+	UINT32 PixelFormat;
+	UINT32 PixelInformation[4];
+	UINT32 PixelsPerScanLine;
+} EFI_GRAPHICS_OUTPUT_MODE_INFORMATION;
+
+typedef struct {
+	UINT32 MaxMode;
+	UINT32 Mode;
+	EFI_GRAPHICS_OUTPUT_MODE_INFORMATION *Info;
+	UINTN SizeOfInfo;
+	EFI_PHYSICAL_ADDRESS FrameBufferBase;
+	UINTN FrameBufferSize;
+} EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE;
+
+typedef struct _EFI_GRAPHICS_OUTPUT_PROTOCOL {
+	VOID *QueryMode;
+	VOID *SetMode;
+	EFI_STATUS (*Blt)(struct _EFI_GRAPHICS_OUTPUT_PROTOCOL *This,
+			  EFI_GRAPHICS_OUTPUT_BLT_PIXEL *BltBuffer,
+			  EFI_GRAPHICS_OUTPUT_BLT_OPERATION BltOperation,
+			  UINTN SourceX, UINTN SourceY, UINTN DestinationX,
+			  UINTN DestinationY, UINTN Width, UINTN Height, UINTN Delta);
+	EFI_GRAPHICS_OUTPUT_PROTOCOL_MODE *Mode;
+} EFI_GRAPHICS_OUTPUT_PROTOCOL;
+
+typedef struct {
+	UINT32 MediaId;
+	BOOLEAN RemovableMedia;
+	BOOLEAN MediaPresent;
+	BOOLEAN LogicalPartition;
+	BOOLEAN ReadOnly;
+	BOOLEAN WriteCaching;
+	UINT32 BlockSize;
+	UINT32 IoAlign;
+	EFI_LBA LastBlock;
+} EFI_BLOCK_IO_MEDIA;
+
+typedef struct _EFI_BLOCK_IO {
+	UINT64 Revision;
+	EFI_BLOCK_IO_MEDIA *Media;
+	EFI_STATUS (*Reset)(struct _EFI_BLOCK_IO *This, BOOLEAN ExtendedVerification);
+	EFI_STATUS (*ReadBlocks)(struct _EFI_BLOCK_IO *This, UINT32 MediaId, EFI_LBA Lba,
+				 UINTN BufferSize, VOID *Buffer);
+	EFI_STATUS (*WriteBlocks)(struct _EFI_BLOCK_IO *This, UINT32 MediaId, EFI_LBA Lba,
+				  UINTN BufferSize, VOID *Buffer);
+	EFI_STATUS (*FlushBlocks)(struct _EFI_BLOCK_IO *This);
+} EFI_BLOCK_IO;
+
+typedef struct _EFI_DISK_IO {
+	UINT64 Revision;
+	EFI_STATUS (*ReadDisk)(struct _EFI_DISK_IO *This, UINT32 MediaId, UINT64 Offset,
+			       UINTN BufferSize, VOID *Buffer);
+	EFI_STATUS (*WriteDisk)(struct _EFI_DISK_IO *This, UINT32 MediaId, UINT64 Offset,
+				UINTN BufferSize, VOID *Buffer);
+} EFI_DISK_IO;
+
+#define EFI_FILE_MODE_READ	0x0000000000000001
+#define EFI_FILE_MODE_WRITE	0x0000000000000002
+#define EFI_FILE_MODE_CREATE	0x8000000000000000
+#define EFI_FILE_DIRECTORY	0x0000000000000010
+
+typedef struct _EFI_FILE {
+	UINT64 Revision;
+	EFI_STATUS (*Open)(struct _EFI_FILE *File, struct _EFI_FILE **NewHandle,
+			   CHAR16 *FileName, UINT64 OpenMode, UINT64 Attributes);
+	EFI_STATUS (*Close)(struct _EFI_FILE *File);
+	EFI_STATUS (*Delete)(struct _EFI_FILE *File);
+	EFI_STATUS (*Read)(struct _EFI_FILE *File, UINTN *BufferSize, VOID *Buffer);
+	EFI_STATUS (*Write)(struct _EFI_FILE *File, UINTN *BufferSize, VOID *Buffer);
+	EFI_STATUS (*GetPosition)(struct _EFI_FILE *File, UINT64 *Position);
+	EFI_STATUS (*SetPosition)(struct _EFI_FILE *File, UINT64 Position);
+	EFI_STATUS (*GetInfo)(struct _EFI_FILE *File, EFI_GUID *InformationType,
+			      UINTN *BufferSize, VOID *Buffer);
+} EFI_FILE, *EFI_FILE_HANDLE;
+
+typedef struct {
+	UINT64 Size;
+	UINT64 FileSize;
+	UINT64 PhysicalSize;
+	EFI_TIME CreateTime;
+	EFI_TIME LastAccessTime;
+	EFI_TIME ModificationTime;
+	UINT64 Attribute;
+	CHAR16 FileName[1];
+} EFI_FILE_INFO;
+
+#define SIZE_OF_EFI_FILE_INFO	((UINTN)&((EFI_FILE_INFO *)0)->FileName)
+
+#define SIMPLE_FILE_SYSTEM_PROTOCOL \
+	{ 0x964e5b22, 0x6459, 0x11d2, { 0x8e, 0x39, 0x00, 0xa0, 0xc9, 0x69, 0x72, 0x3b } }
+
+typedef struct _EFI_FILE_IO_INTERFACE {
+	UINT64 Revision;
+	EFI_STATUS (*OpenVolume)(struct _EFI_FILE_IO_INTERFACE *This, EFI_FILE **Root);
+} EFI_FILE_IO_INTERFACE;
+
+/* Services */
+
+typedef enum {
+	AllHandles,
+	ByRegisterNotify,
+	ByProtocol
+} EFI_LOCATE_SEARCH_TYPE;
+
+typedef enum {
+	EfiResetCold,
+	EfiResetWarm,
+	EfiResetShutdown
+} EFI_RESET_TYPE;
+
+typedef struct {
+	UINT64 Signature;
+	UINT32 Revision;
+	UINT32 HeaderSize;
+	UINT32 CRC32;
+	UINT32 Reserved;
+} EFI_TABLE_HEADER;
+
+typedef struct {
+	EFI_TABLE_HEADER Hdr;
+	EFI_STATUS (*AllocatePages)(EFI_ALLOCATE_TYPE Type, EFI_MEMORY_TYPE MemoryType,
+				    UINTN NoPages, EFI_PHYSICAL_ADDRESS *Memory);
+	EFI_STATUS (*FreePages)(EFI_PHYSICAL_ADDRESS Memory, UINTN NoPages);
+	EFI_STATUS (*GetMemoryMap)(UINTN *MemoryMapSize, EFI_MEMORY_DESCRIPTOR *MemoryMap,
+				   UINTN *MapKey, UINTN *DescriptorSize,
+				   UINT32 *DescriptorVersion);
+	EFI_STATUS (*AllocatePool)(EFI_MEMORY_TYPE PoolType, UINTN Size, VOID **Buffer);
+	EFI_STATUS (*FreePool)(VOID *Buffer);
+	EFI_STATUS (*HandleProtocol)(EFI_HANDLE Handle, EFI_GUID *Protocol, VOID **Interface);
+	EFI_STATUS (*LocateHandle)(EFI_LOCATE_SEARCH_TYPE SearchType, EFI_GUID *Protocol,
+				   VOID *SearchKey, UINTN *BufferSize, EFI_HANDLE *Buffer);
+	EFI_STATUS (*OpenProtocol)(EFI_HANDLE Handle, EFI_GUID *Protocol, VOID **Interface,
+				   EFI_HANDLE AgentHandle, EFI_HANDLE ControllerHandle,
+				   UINT32 Attributes);
+	EFI_STATUS (*Exit)(EFI_HANDLE ImageHandle, EFI_STATUS ExitStatus,
+			   UINTN ExitDataSize, CHAR16 *ExitData);
+	EFI_STATUS (*ExitBootServices)(EFI_HANDLE ImageHandle, UINTN MapKey);
+	EFI_STATUS (*Stall)(UINTN Microseconds);
+	EFI_STATUS (*LocateProtocol)(EFI_GUID *Protocol, VOID *Registration, VOID **Interface);
+} EFI_BOOT_SERVICES;
+
+typedef struct {
+	EFI_TABLE_HEADER Hdr;
+	EFI_STATUS (*GetVariable)(CHAR16 *VariableName, EFI_GUID *VendorGuid,
+				  UINT32 *Attributes, UINTN *DataSize, VOID *Data);
+	EFI_STATUS (*SetVariable)(CHAR16 *VariableName, EFI_GUID *VendorGuid,
+				  UINT32 Attributes, UINTN DataSize, VOID *Data);
+	VOID (*ResetSystem)(EFI_RESET_TYPE ResetType, EFI_STATUS ResetStatus,
+			    UINTN DataSize, CHAR16 *ResetData);
+} EFI_RUNTIME_SERVICES;
+
+typedef struct {
+	EFI_TABLE_HEADER Hdr;
+	EFI_RUNTIME_SERVICES *RuntimeServices;
+	EFI_BOOT_SERVICES *BootServices;
+} EFI_SYSTEM_TABLE;
+
+#define MBR_TYPE_EFI_PARTITION_TABLE_HEADER	0x02
+#define SIGNATURE_TYPE_GUID			0x02
+
+#define EFI_VARIABLE_NON_VOLATILE	0x00000001
+#define EFI_VARIABLE_BOOTSERVICE_ACCESS	0x00000002
+#define EFI_VARIABLE_RUNTIME_ACCESS	0x00000004
+
+#endif	/* _HOST_EFI_H_ */
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * The memory helpers are byte loops, as in gnu-efi: the benchmarks use
+ * them as the reference the optimized routines are measured against.
+ * The service tables are left NULL for the tests to fill in.
+ */
+
+#include <stdlib.h>
+#include <efi.h>
+#include <efilib.h>
+
+EFI_SYSTEM_TABLE *ST;
+EFI_BOOT_SERVICES *BS;
+EFI_RUNTIME_SERVICES *RT;
+
+EFI_GUID GenericFileInfo = {
+	0x09576e92, 0x6d3f, 0x11d2, { 0x8e, 0x39, 0x00, 0xa0, 0xc9, 0x69, 0x72, 0x3b }
+};
+EFI_GUID FileSystemProtocol = SIMPLE_FILE_SYSTEM_PROTOCOL;
+EFI_GUID EfiPartTypeSystemPartitionGuid = {
+	0xc12a7328, 0xf81f, 0x11d2, { 0xba, 0x4b, 0x00, 0xa0, 0xc9, 0x3e, 0xc9, 0x3b }
+};
+
+/* Like the firmware pool, only 8 bytes aligned */
+#define POOL_HEADER 8
+
+VOID *AllocatePool(UINTN size)
+{
+	UINT8 *p = malloc(POOL_HEADER + size);
+
+	return p ? p + POOL_HEADER : NULL;
+}
+
+VOID *AllocateZeroPool(UINTN size)
+{
+	UINT8 *p = calloc(1, POOL_HEADER + size);
+
+	return p ? p + POOL_HEADER : NULL;
+}
+
+VOID FreePool(VOID *buf)
+{
+	if (buf)
+		free((UINT8 *)buf - POOL_HEADER);
+}
+
+/* Overlapping buffers are supported */
+VOID CopyMem(VOID *dst, const VOID *src, UINTN len)
+{
+	CHAR8 *d = dst;
+	const CHAR8 *s = src;
+
+	if (d > s && d < s + len) {
+		d += len;
+		s += len;
+		while (len--)
+			*--d = *--s;
+	} else {
+		while (len--)
+			*d++ = *s++;
+	}
+}
+
+VOID SetMem(VOID *buf, UINTN size, UINT8 value)
+{
+	UINT8 *p = buf;
+
+	while (size--)
+		*p++ = value;
+}
+
+VOID ZeroMem(VOID *buf, UINTN size)
+{
+	SetMem(buf, size, 0);
+}
+
+INTN CompareMem(const VOID *dst, const VOID *src, UINTN len)
+{
+	const UINT8 *d = dst, *s = src;
+
+	for (; len; len--, d++, s++)
+		if (*d != *s)
+			return *d - *s;
+	return 0;
+}
+
+UINTN strlena(const CHAR8 *s)
+{
+	UINTN len;
+
+	for (len = 0; s[len]; len++)
+		;
+	return len;
+}
+
+INTN strcmpa(const CHAR8 *s1, const CHAR8 *s2)
+{
+	for (; *s1 && *s1 == *s2; s1++, s2++)
+		;
+	return *s1 - *s2;
+}
+
+INTN strncmpa(const CHAR8 *s1, const CHAR8 *s2, UINTN len)
+{
+	for (; len; len--, s1++, s2++) {
+		if (*s1 != *s2)
+			return *s1 - *s2;
+		if (!*s1)
+			break;
+	}
+	return 0;
+}
+
+UINTN StrLen(const CHAR16 *s)
+{
+	UINTN len;
+
+	for (len = 0; s[len]; len++)
+		;
+	return len;
+}
+
+INTN StrCmp(const CHAR16 *s1, const CHAR16 *s2)
+{
+	for (; *s1 && *s1 == *s2; s1++, s2++)
+		;
+	return *s1 - *s2;
+}
+
+UINTN xtoi(const CHAR16 *str)
+{
+	UINTN u = 0;
+	CHAR16 c;
+
+	for (; (c = *str); str++) {
+		if (c >= 'a' && c <= 'f')
+			c -= 'a' - 'A';
+		if (c >= '0' && c <= '9')
+			u = u * 16 + c - '0';
+		else if (c >= 'A' && c <= 'F')
+			u = u * 16 + c - 'A' + 10;
+		else
+			break;
+	}
+	return u;
+}
+
+UINT64 MultU64x32(UINT64 multiplicand, UINTN multiplier)
+{
+	return multiplicand * multiplier;
+}
+
+UINT64 DivU64x32(UINT64 dividend, UINTN divisor, UINTN *remainder)
+{
+	if (remainder)
+		*remainder = dividend % divisor;
+	return dividend / divisor;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Host implementations of the gnu-efi library functions used by the
+ * common code built by tools/Makefile.
+ */
+
+#ifndef _HOST_EFILIB_H_
+#define _HOST_EFILIB_H_
+
+#include <efi.h>
+
+extern EFI_SYSTEM_TABLE *ST;
+extern EFI_BOOT_SERVICES *BS;
+extern EFI_RUNTIME_SERVICES *RT;
+
+extern EFI_GUID GenericFileInfo;
+extern EFI_GUID FileSystemProtocol;
+extern EFI_GUID EfiPartTypeSystemPartitionGuid;
+
+VOID *AllocatePool(UINTN size);
+VOID *AllocateZeroPool(UINTN size);
+VOID FreePool(VOID *buf);
+
+VOID CopyMem(VOID *dst, const VOID *src, UINTN len);
+VOID SetMem(VOID *buf, UINTN size, UINT8 value);
+VOID ZeroMem(VOID *buf, UINTN size);
+INTN CompareMem(const VOID *dst, const VOID *src, UINTN len);
+
+UINTN strlena(const CHAR8 *s);
+INTN strcmpa(const CHAR8 *s1, const CHAR8 *s2);
+INTN strncmpa(const CHAR8 *s1, const CHAR8 *s2, UINTN len);
+UINTN StrLen(const CHAR16 *s);
+INTN StrCmp(const CHAR16 *s1, const CHAR16 *s2);
+UINTN xtoi(const CHAR16 *str);
+
+UINTN Print(const CHAR16 *fmt, ...);
+UINTN SPrint(CHAR16 *str, UINTN size, const CHAR16 *fmt, ...);
+UINTN VSPrint(CHAR16 *str, UINTN size, const CHAR16 *fmt, va_list args);
+CHAR16 *PoolPrint(const CHAR16 *fmt, ...);
+CHAR16 *VPoolPrint(const CHAR16 *fmt, va_list args);
+
+VOID StatusToString(CHAR16 *buf, EFI_STATUS status);
+VOID GuidToString(CHAR16 *buf, EFI_GUID *guid);
+VOID TimeToString(CHAR16 *buf, EFI_TIME *time);
+
+UINT64 MultU64x32(UINT64 multiplicand, UINTN multiplier);
+UINT64 DivU64x32(UINT64 dividend, UINTN divisor, UINTN *remainder);
+
+/* Declared for the code built alongside, not provided on the host */
+EFI_STATUS LibLocateProtocol(EFI_GUID *protocol, VOID **interface);
+EFI_STATUS LibLocateHandleByDiskSignature(UINT8 mbr_type, UINT8 signature_type,
+					  VOID *signature, UINTN *count, EFI_HANDLE **buffer);
+EFI_DEVICE_PATH *DevicePathFromHandle(EFI_HANDLE handle);
+CHAR16 *DevicePathToStr(EFI_DEVICE_PATH *path);
+EFI_STATUS LibSetVariable(CHAR16 *name, EFI_GUID *guid, UINTN size, VOID *data);
+EFI_STATUS LibSetNVVariable(CHAR16 *name, EFI_GUID *guid, UINTN size, VOID *data);
+VOID *LibGetVariable(CHAR16 *name, EFI_GUID *guid);
+VOID *LibGetVariableAndSize(CHAR16 *name, EFI_GUID *guid, UINTN *size);
+EFI_STATUS LibDeleteVariable(CHAR16 *name, EFI_GUID *guid);
+
+#endif	/* _HOST_EFILIB_H_ */
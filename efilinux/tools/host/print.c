@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * CHAR16 formatting in the way of gnu-efi's _Print(): every character
+ * goes through an output callback, numbers are converted in a scratch
+ * buffer first and VPoolPrint() grows its pool buffer as it goes.  The
+ * output follows gnu-efi: %a is a CHAR8 string, %s a CHAR16 string,
+ * hexadecimal digits are upper case and %X is zero padded to 8 digits
+ * (16 with 'l').
+ */
+
+#include <stdio.h>
+#include <efi.h>
+#include <efilib.h>
+
+struct print_state {
+	CHAR16 *buf;
+	UINTN size;		/* in characters, NUL included */
+	UINTN len;
+	BOOLEAN pool;
+	BOOLEAN failed;
+};
+
+static VOID output(struct print_state *ps, CHAR16 c)
+{
+	CHAR16 *buf;
+
+	if (ps->len + 1 >= ps->size) {
+		if (!ps->pool || ps->failed)
+			return;
+		buf = AllocatePool(ps->size * 2 * sizeof(CHAR16));
+		if (!buf) {
+			ps->failed = TRUE;
+			return;
+		}
+		CopyMem(buf, ps->buf, ps->len * sizeof(CHAR16));
+		FreePool(ps->buf);
+		ps->buf = buf;
+		ps->size *= 2;
+	}
+	ps->buf[ps->len++] = c;
+}
+
+static VOID value_to_string(CHAR16 *buf, BOOLEAN comma, INT64 v)
+{
+	CHAR8 str[40], *p = str;
+	UINT64 u = v < 0 ? -(UINT64)v : (UINT64)v;
+	UINTN count = 0;
+
+	do {
+		if (comma && count && count % 3 == 0)
+			*p++ = ',';
+		*p++ = '0' + u % 10;
+		u /= 10;
+		count++;
+	} while (u);
+	if (v < 0)
+		*p++ = '-';
+
+	while (p != str)
+		*buf++ = *--p;
+	*buf = 0;
+}
+
+static VOID unsigned_to_string(CHAR16 *buf, BOOLEAN comma, UINT64 u)
+{
+	CHAR8 str[40], *p = str;
+	UINTN count = 0;
+
+	do {
+		if (comma && count && count % 3 == 0)
+			*p++ = ',';
+		*p++ = '0' + u % 10;
+		u /= 10;
+		count++;
+	} while (u);
+
+	while (p != str)
+		*buf++ = *--p;
+	*buf = 0;
+}
+
+static VOID value_to_hex(CHAR16 *buf, UINT64 v)
+{
+	static const CHAR8 digits[] = "0123456789ABCDEF";
+	CHAR8 str[20], *p = str;
+
+	do {
+		*p++ = digits[v & 0xF];
+		v >>= 4;
+	} while (v);
+
+	while (p != str)
+		*buf++ = *--p;
+	*buf = 0;
+}
+
+static UINTN format(struct print_state *ps, const CHAR16 *fmt, va_list args)
+{
+	CHAR16 scratch[64], *ws;
+	CHAR8 *as;
+	UINTN width, max, len, i;
+	BOOLEAN is_long, comma, pad_after, ascii;
+	CHAR16 pad;
+
+	for (; *fmt; fmt++) {
+		if (*fmt != '%') {
+			output(ps, *fmt);
+			continue;
+		}
+
+		width = 0;
+		max = (UINTN)-1;
+		is_long = comma = pad_after = FALSE;
+		pad = ' ';
+		ws = scratch;
+		as = NULL;
+		ascii = FALSE;
+
+		for (fmt++; ; fmt++) {
+			if (*fmt == '-') {
+				pad_after = TRUE;
+			} else if (*fmt == '0' && !width) {
+				pad = '0';
+			} else if (*fmt == ',') {
+				comma = TRUE;
+			} else if (*fmt == '.') {
+				max = 0;
+				for (fmt++; *fmt >= '0' && *fmt <= '9'; fmt++)
+					max = max * 10 + *fmt - '0';
+				fmt--;
+			} else if (*fmt == '*') {
+				width = va_arg(args, UINTN);
+			} else if (*fmt >= '0' && *fmt <= '9') {
+				width = width * 10 + *fmt - '0';
+			} else if (*fmt == 'l') {
+				is_long = TRUE;
+			} else {
+				break;
+			}
+		}
+
+		switch (*fmt) {
+		case 'a':
+			as = va_arg(args, CHAR8 *);
+			if (!as)
+				as = (CHAR8 *)"(null)";
+			ascii = TRUE;
+			break;
+		case 's':
+			ws = va_arg(args, CHAR16 *);
+			if (!ws)
+				ws = L"(null)";
+			break;
+		case 'c':
+			scratch[0] = (CHAR16)va_arg(args, UINTN);
+			scratch[1] = 0;
+			break;
+		case 'd':
+			value_to_string(scratch, comma, is_long ? va_arg(args, INT64) : va_arg(args, INT32));
+			break;
+		case 'u':
+			unsigned_to_string(scratch, comma, is_long ? va_arg(args, UINT64) : va_arg(args, UINT32));
+			break;
+		case 'X':
+			width = is_long ? 16 : 8;
+			pad = '0';
+			/* fall through */
+		case 'x':
+			value_to_hex(scratch, is_long ? va_arg(args, UINT64) : va_arg(args, UINT32));
+			break;
+		case 'r':
+			StatusToString(scratch, va_arg(args, EFI_STATUS));
+			break;
+		case 'g':
+			GuidToString(scratch, va_arg(args, EFI_GUID *));
+			break;
+		case 't':
+			TimeToString(scratch, va_arg(args, EFI_TIME *));
+			break;
+		case '%':
+			scratch[0] = '%';
+			scratch[1] = 0;
+			break;
+		default:
+			scratch[0] = '?';
+			scratch[1] = 0;
+			break;
+		}
+		if (!*fmt)
+			break;
+
+		for (len = 0; len < max && (ascii ? as[len] : ws[len]); len++)
+			;
+		if (!pad_after)
+			for (i = len; i < width; i++)
+				output(ps, pad);
+		for (i = 0; i < len; i++)
+			output(ps, ascii ? as[i] : ws[i]);
+		if (pad_after)
+			for (i = len; i < width; i++)
+				output(ps, pad);
+	}
+
+	if (ps->size)
+		ps->buf[ps->len] = 0;
+	return ps->len;
+}
+
+UINTN VSPrint(CHAR16 *str, UINTN size, const CHAR16 *fmt, va_list args)
+{
+	struct print_state ps = {
+		.buf = str,
+		.size = size ? size / sizeof(CHAR16) : (UINTN)-1,
+	};
+
+	return format(&ps, fmt, args);
+}
+
+UINTN SPrint(CHAR16 *str, UINTN size, const CHAR16 *fmt, ...)
+{
+	va_list args;
+	UINTN len;
+
+	va_start(args, fmt);
+	len = VSPrint(str, size, fmt, args);
+	va_end(args);
+	return len;
+}
+
+CHAR16 *VPoolPrint(const CHAR16 *fmt, va_list args)
+{
+	struct print_state ps = {
+		.size = 64,
+		.pool = TRUE,
+	};
+
+	ps.buf = AllocatePool(ps.size * sizeof(CHAR16));
+	if (!ps.buf)
+		return NULL;
+
+	format(&ps, fmt, args);
+	if (ps.failed) {
+		FreePool(ps.buf);
+		return NULL;
+	}
+	return ps.buf;
+}
+
+CHAR16 *PoolPrint(const CHAR16 *fmt, ...)
+{
+	va_list args;
+	CHAR16 *str;
+
+	va_start(args, fmt);
+	str = VPoolPrint(fmt, args);
+	va_end(args);
+	return str;
+}
+
+/* The console is the host standard output, non ASCII shows as '?' */
+UINTN Print(const CHAR16 *fmt, ...)
+{
+	va_list args;
+	CHAR16 *str;
+	UINTN i;
+
+	va_start(args, fmt);
+	str = VPoolPrint(fmt, args);
+	va_end(args);
+	if (!str)
+		return 0;
+
+	for (i = 0; str[i]; i++)
+		putchar(str[i] < 0x80 ? str[i] : '?');
+	FreePool(str);
+	return i;
+}
+
+static const struct {
+	EFI_STATUS status;
+	const CHAR16 *str;
+} status_strings[] = {
+	{ EFI_SUCCESS, L"Success" },
+	{ EFI_LOAD_ERROR, L"Load Error" },
+	{ EFI_INVALID_PARAMETER, L"Invalid Parameter" },
+	{ EFI_UNSUPPORTED, L"Unsupported" },
+	{ EFI_BAD_BUFFER_SIZE, L"Bad Buffer Size" },
+	{ EFI_BUFFER_TOO_SMALL, L"Buffer Too Small" },
+	{ EFI_NOT_READY, L"Not Ready" },
+	{ EFI_DEVICE_ERROR, L"Device Error" },
+	{ EFI_WRITE_PROTECTED, L"Write Protected" },
+	{ EFI_OUT_OF_RESOURCES, L"Out of Resources" },
+	{ EFI_VOLUME_CORRUPTED, L"Volume Corrupt" },
+	{ EFI_NOT_FOUND, L"Not Found" },
+	{ EFI_ACCESS_DENIED, L"Access Denied" },
+	{ EFI_TIMEOUT, L"Time out" },
+	{ EFI_ABORTED, L"Aborted" },
+	{ EFI_CRC_ERROR, L"CRC Error" },
+	{ EFI_END_OF_MEDIA, L"End of Media" },
+	{ EFI_END_OF_FILE, L"End of File" },
+	{ EFI_WARN_DELETE_FAILURE, L"Warning Delete Failure" },
+};
+
+VOID StatusToString(CHAR16 *buf, EFI_STATUS status)
+{
+	UINTN i;
+
+	for (i = 0; i < sizeof(status_strings) / sizeof(*status_strings); i++) {
+		if (status_strings[i].status == status) {
+			SPrint(buf, 0, L"%s", status_strings[i].str);
+			return;
+		}
+	}
+	SPrint(buf, 0, L"%X", status);
+}
+
+VOID GuidToString(CHAR16 *buf, EFI_GUID *guid)
+{
+	SPrint(buf, 0, L"%08x-%04x-%04x-%02x%02x-%02x%02x%02x%02x%02x%02x",
+	       guid->Data1, guid->Data2, guid->Data3,
+	       guid->Data4[0], guid->Data4[1], guid->Data4[2], guid->Data4[3],
+	       guid->Data4[4], guid->Data4[5], guid->Data4[6], guid->Data4[7]);
+}
+
+VOID TimeToString(CHAR16 *buf, EFI_TIME *time)
+{
+	UINT32 hour = time->Hour;
+	CHAR16 am_pm = 'a';
+
+	if (hour >= 12)
+		am_pm = 'p';
+	if (hour > 12)
+		hour -= 12;
+	if (!hour)
+		hour = 12;
+
+	SPrint(buf, 0, L"%02d/%02d/%02d  %02d:%02d%c", time->Month, time->Day,
+	       time->Year % 100, hour, time->Minute, am_pm);
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Decoding throughput of the common/lz4 streaming decoder, the way
+ * fastboot feeds it: input in RX_RING_SIZE slices, as the USB receive
+ * ring delivers it, and in one piece. The frames are made at startup by
+ * a greedy LZ4 encoder from data that compresses about 1.7:1, like a
+ * system image, with the block sizes and checksums of the lz4 command
+ * line tool options.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <efi.h>
+#include <efilib.h>
+#include <lz4.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define CONTENT_SIZE (64 * 1024 * 1024)
+#define RX_RING_SIZE (512 * 1024)
+/* Bytes decoded per measurement */
+#define VOLUME (1ULL << 30)
+
+#define FLG_VERSION		0x40
+#define FLG_BLOCK_INDEP		(1 << 5)
+#define FLG_BLOCK_CHECKSUM	(1 << 4)
+#define FLG_CONTENT_CHECKSUM	(1 << 2)
+#define BLOCK_UNCOMPRESSED	0x80000000
+
+#define MIN_MATCH	4
+#define LAST_LITERALS	5
+#define MATCH_LIMIT	12
+#define HASH_BITS	16
+
+static const struct {
+	const char *name;
+	UINT8 flg;
+	UINT8 bsid;		/* block size id, 64KB to 4MB */
+} configs[] = {
+	{ "4MB indep, content xxh", FLG_BLOCK_INDEP | FLG_CONTENT_CHECKSUM, 7 },
+	{ "4MB indep, all xxh", FLG_BLOCK_INDEP | FLG_BLOCK_CHECKSUM | FLG_CONTENT_CHECKSUM, 7 },
+	{ "64KB linked, no xxh", 0, 4 },
+	{ "64KB linked, all xxh", FLG_BLOCK_CHECKSUM | FLG_CONTENT_CHECKSUM, 4 },
+};
+
+static UINT32 table[1 << HASH_BITS];
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static UINT32 xorshift32(UINT32 *x)
+{
+	*x ^= *x << 13;
+	*x ^= *x >> 17;
+	*x ^= *x << 5;
+	return *x;
+}
+
+/* 64 bytes segments, half random, half copied from up to 32KB back
+ * with a byte changed */
+static void gen_content(UINT8 *p, UINTN len)
+{
+	UINT32 x = 2463534242U, r;
+	UINTN i, j, from;
+
+	for (i = 0; i + 64 <= len; i += 64) {
+		r = xorshift32(&x);
+		if (i >= 32 * 1024 && (r & 1)) {
+			from = i - 64 - (r >> 8) % (32 * 1024 - 64);
+			memcpy(p + i, p + from, 64);
+			p[i + (r >> 1) % 64] ^= 0x55;
+		} else
+			for (j = 0; j < 64; j++)
+				p[i + j] = xorshift32(&x);
+	}
+}
+
+static void put_le32(UINT8 *p, UINT32 v)
+{
+	p[0] = v;
+	p[1] = v >> 8;
+	p[2] = v >> 16;
+	p[3] = v >> 24;
+}
+
+static UINT8 *put_length(UINT8 *op, UINTN len)
+{
+	for (; len >= 255; len -= 255)
+		*op++ = 255;
+	*op++ = len;
+	return op;
+}
+
+static UINT8 *put_sequence(UINT8 *op, const UINT8 *lit, UINTN lit_len, UINTN offset,
+			   UINTN ml)
+{
+	UINT8 *token = op++;
+
+	*token = (lit_len < 15 ? lit_len : 15) << 4;
+	if (lit_len >= 15)
+		op = put_length(op, lit_len - 15);
+	memcpy(op, lit, lit_len);
+	op += lit_len;
+	if (!ml)
+		return op;
+
+	*op++ = offset;
+	*op++ = offset >> 8;
+	ml -= MIN_MATCH;
+	*token |= ml < 15 ? ml : 15;
+	if (ml >= 15)
+		op = put_length(op, ml - 15);
+	return op;
+}
+
+static UINT32 hash4(const UINT8 *p)
+{
+	UINT32 v;
+
+	memcpy(&v, p, sizeof(v));
+	return (v * 2654435761U) >> (32 - HASH_BITS);
+}
+
+/* Greedy encoding of base[start, end), matches reaching down to @low */
+static UINTN encode_block(const UINT8 *base, UINTN low, UINTN start, UINTN end, UINT8 *dst)
+{
+	UINTN ip = start, anchor = start, ref, ml;
+	UINT8 *op = dst;
+	UINT32 h;
+
+	while (end - start > MATCH_LIMIT && ip < end - MATCH_LIMIT) {
+		h = hash4(base + ip);
+		ref = table[h];
+		table[h] = ip + 1;
+		if (!ref-- || ref < low || ip - ref > 65535 ||
+		    memcmp(base + ref, base + ip, MIN_MATCH)) {
+			ip++;
+			continue;
+		}
+		for (ml = MIN_MATCH; ip + ml < end - LAST_LITERALS &&
+			     base[ref + ml] == base[ip + ml]; ml++)
+			;
+		op = put_sequence(op, base + anchor, ip - anchor, ip - ref, ml);
+		ip += ml;
+		anchor = ip;
+	}
+	op = put_sequence(op, base + anchor, end - anchor, 0, 0);
+	return op - dst;
+}
+
+static UINTN encode_frame(const UINT8 *src, UINTN len, UINT8 flg, UINT8 bsid, UINT8 *dst)
+{
+	UINTN block_max = 1 << (8 + 2 * bsid);
+	UINTN start, end, size;
+	UINT8 *op = dst, *block;
+
+	put_le32(op, LZ4_FRAME_MAGIC);
+	op[4] = FLG_VERSION | flg;
+	op[5] = bsid << 4;
+	op[6] = xxh32(op + 4, 2, 0) >> 8;
+	op += 7;
+
+	memset(table, 0, sizeof(table));
+	for (start = 0; start < len; start = end) {
+		end = start + block_max < len ? start + block_max : len;
+		block = op + 4;
+		size = encode_block(src, flg & FLG_BLOCK_INDEP ? start : 0, start, end, block);
+		if (size >= end - start) {
+			size = end - start;
+			memcpy(block, src + start, size);
+			put_le32(op, size | BLOCK_UNCOMPRESSED);
+		} else
+			put_le32(op, size);
+		op = block + size;
+		if (flg & FLG_BLOCK_CHECKSUM) {
+			put_le32(op, xxh32(block, size, 0));
+			op += 4;
+		}
+	}
+
+	put_le32(op, 0);
+	op += 4;
+	if (flg & FLG_CONTENT_CHECKSUM) {
+		put_le32(op, xxh32(src, len, 0));
+		op += 4;
+	}
+	return op - dst;
+}
+
+static const UINT8 *check_content;
+static UINTN check_pos;
+static BOOLEAN check_failed;
+
+static EFI_STATUS output_check(VOID *ctx, VOID *data, UINTN size)
+{
+	if (memcmp(check_content + check_pos, data, size))
+		check_failed = TRUE;
+	check_pos += size;
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS output_discard(VOID *ctx, VOID *data, UINTN size)
+{
+	asm volatile("" : : "r" (data) : "memory");
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS decode(const UINT8 *frame, UINTN size, UINTN slice, lz4_output_t output)
+{
+	struct lz4_stream ls;
+	EFI_STATUS ret = EFI_SUCCESS;
+	UINTN len;
+
+	lz4_stream_init(&ls, output, NULL);
+	for (; size && !EFI_ERROR(ret); frame += len, size -= len) {
+		len = size < slice ? size : slice;
+		ret = lz4_stream_write(&ls, frame, len);
+	}
+	if (!EFI_ERROR(ret))
+		ret = lz4_stream_end(&ls);
+	lz4_stream_free(&ls);
+	return ret;
+}
+
+/* GB/s of decoded data */
+static double bench(const UINT8 *frame, UINTN size, UINTN slice)
+{
+	UINT64 i, count = VOLUME / CONTENT_SIZE;
+	double start;
+
+	start = now();
+	for (i = 0; i < count; i++)
+		decode(frame, size, slice, output_discard);
+	return (double)count * CONTENT_SIZE / (now() - start) / 1e9;
+}
+
+int main(void)
+{
+	UINT8 *content, *frame;
+	UINTN size, c;
+	double start, xxh;
+	UINT32 h = 0;
+
+	content = malloc(CONTENT_SIZE);
+	frame = malloc(CONTENT_SIZE + CONTENT_SIZE / 64 + 1024);
+	if (!content || !frame) {
+		perror("malloc");
+		return 1;
+	}
+	gen_content(content, CONTENT_SIZE);
+
+	start = now();
+	for (c = 0; c < VOLUME / CONTENT_SIZE; c++)
+		h += xxh32(content, CONTENT_SIZE, c);
+	xxh = VOLUME / (now() - start) / 1e9;
+	asm volatile("" : : "r" (h));
+	printf("xxh32: %.2f GB/s\n\n", xxh);
+
+	printf("lz4 decode of %uMB, GB/s of output\n%-24s%8s%12s%12s\n", CONTENT_SIZE >> 20,
+	       "frame", "ratio", "512KB rx", "whole");
+	for (c = 0; c < ARRAY_SIZE(configs); c++) {
+		size = encode_frame(content, CONTENT_SIZE, configs[c].flg, configs[c].bsid, frame);
+
+		check_content = content;
+		check_pos = 0;
+		check_failed = FALSE;
+		if (EFI_ERROR(decode(frame, size, RX_RING_SIZE, output_check)) || check_failed ||
+		    check_pos != CONTENT_SIZE) {
+			fprintf(stderr, "%s: frame does not decode back\n", configs[c].name);
+			return 1;
+		}
+
+		printf("%-24s%8.2f%12.2f%12.2f\n", configs[c].name, (double)CONTENT_SIZE / size,
+		       bench(frame, size, RX_RING_SIZE), bench(frame, size, size));
+	}
+
+	free(content);
+	free(frame);
+	return 0;
+}
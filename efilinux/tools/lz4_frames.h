@@ -0,0 +1,845 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * LZ4 frames of the lz4 command line tool v1.9.4, for lz4_test. The
+ * content is gen_content(72KB) of lz4_test.c, the uncompressed frame
+ * holds gen_random(300), the bytes that follow in the same sequence:
+ *
+ *   lz4 -B4 -BD --no-frame-crc content linked
+ *   lz4 -B4 -BI -BX content independent
+ *   lz4 -B4 -BD -BX --content-size content linked_checksums
+ *   lz4 -B4 --content-size random uncompressed
+ *
+ * With 64KB blocks the content takes two blocks. The second block of
+ * the linked frames is mostly matches into the first one. The random
+ * bytes do not compress and are stored as an uncompressed block. The
+ * skippable frame is built by hand: magic 0x184D2A5A, a 6 bytes
+ * payload.
+ */
+
+#ifndef _LZ4_FRAMES_H_
+#define _LZ4_FRAMES_H_
+
+static const UINT8 frame_linked[] = {
+	0x04, 0x22, 0x4d, 0x18, 0x40, 0x40, 0xc0, 0xf6, 0x08, 0x00, 0x00, 0xff,
+	0xff, 0xff, 0xff, 0xf5, 0x00, 0x7a, 0xa0, 0x7e, 0xe1, 0xea, 0xf2, 0x3d,
+	0xc7, 0x39, 0x6d, 0x0d, 0xa6, 0x78, 0x16, 0x80, 0x05, 0x12, 0x3a, 0xa7,
+	0x4e, 0xde, 0x9f, 0x78, 0x9c, 0x70, 0x63, 0x00, 0x0b, 0xe6, 0xc8, 0x25,
+	0x21, 0x3d, 0xad, 0x22, 0xbc, 0x70, 0xb3, 0x85, 0xda, 0x21, 0x23, 0x63,
+	0x36, 0x17, 0x7b, 0xc3, 0x79, 0xfd, 0x62, 0x6c, 0xf9, 0x66, 0x43, 0xf1,
+	0x1f, 0xbd, 0x61, 0x63, 0xbd, 0x7c, 0x99, 0x90, 0x67, 0xf3, 0xd1, 0x98,
+	0xf0, 0x8c, 0x88, 0xd3, 0x90, 0x34, 0x3f, 0x14, 0xd1, 0xaa, 0xff, 0x72,
+	0x48, 0x27, 0x35, 0xf9, 0xde, 0x34, 0x4e, 0xb0, 0x4a, 0x10, 0xd8, 0xd5,
+	0x83, 0x7e, 0x10, 0xa4, 0x57, 0x4d, 0xd7, 0x31, 0x39, 0x3c, 0x26, 0x9f,
+	0x56, 0x69, 0x48, 0x3b, 0x0d, 0x32, 0x34, 0xa7, 0x0c, 0x79, 0x3d, 0x1a,
+	0x24, 0x37, 0xbf, 0xc2, 0x8b, 0xd2, 0x16, 0x20, 0xcf, 0x84, 0x7c, 0xbe,
+	0xc6, 0xba, 0xbb, 0xf4, 0x77, 0x3f, 0x32, 0x89, 0xc9, 0xbb, 0xae, 0xed,
+	0x0b, 0x7d, 0x14, 0xa7, 0x1e, 0xe0, 0xed, 0x3c, 0x0f, 0x8f, 0x3e, 0xb7,
+	0x78, 0xb6, 0x7e, 0x23, 0x38, 0x04, 0x7c, 0x01, 0x4d, 0x4b, 0x54, 0x38,
+	0xbd, 0xcc, 0x3a, 0xf0, 0x63, 0x23, 0x20, 0xc6, 0x4b, 0x4b, 0xfb, 0xff,
+	0xbd, 0x42, 0x33, 0x75, 0x5f, 0xff, 0x20, 0xe5, 0x40, 0x6d, 0x89, 0x6f,
+	0xf6, 0x43, 0x77, 0xf8, 0xf4, 0x1f, 0x1e, 0x04, 0x87, 0xba, 0x00, 0xe4,
+	0x21, 0x6e, 0x90, 0xf1, 0x46, 0xfd, 0xfd, 0x02, 0x47, 0x05, 0x2a, 0x17,
+	0x9e, 0x5f, 0xd9, 0x80, 0x78, 0x69, 0x83, 0x0a, 0x73, 0x67, 0xd2, 0x82,
+	0x9c, 0x0b, 0x03, 0xe3, 0xc0, 0xf4, 0x9d, 0x33, 0x74, 0xf1, 0x9f, 0x58,
+	0x1a, 0x8e, 0x02, 0x27, 0x78, 0x51, 0xb6, 0xeb, 0x45, 0x10, 0x6d, 0x4a,
+	0xad, 0xfe, 0x90, 0x66, 0xc1, 0xe1, 0xe6, 0xbf, 0x01, 0x9d, 0x9f, 0x30,
+	0xe8, 0xe4, 0x1a, 0xdc, 0x28, 0xb7, 0x40, 0xd7, 0xe3, 0x78, 0x2c, 0xcb,
+	0x8c, 0x01, 0x96, 0x34, 0x26, 0x51, 0xcb, 0x32, 0xab, 0x0a, 0x18, 0x14,
+	0x3f, 0x03, 0xad, 0x2e, 0x12, 0x58, 0x57, 0xd6, 0x7b, 0x4d, 0xda, 0x20,
+	0xc6, 0xee, 0xf2, 0x4f, 0xe2, 0x32, 0xe1, 0x2f, 0x21, 0x7a, 0x79, 0x04,
+	0x23, 0x65, 0x59, 0xc3, 0x27, 0x19, 0xa5, 0x14, 0x3f, 0x4e, 0x2f, 0x73,
+	0xa9, 0xe6, 0x5d, 0x22, 0x07, 0xc5, 0x1d, 0xbf, 0x1e, 0xb3, 0xd0, 0x2e,
+	0x12, 0x0a, 0x33, 0x3b, 0x66, 0x66, 0x47, 0xe7, 0x7d, 0xa4, 0x3b, 0xbd,
+	0x19, 0x43, 0xbd, 0xe0, 0x5b, 0x02, 0x14, 0x4c, 0x10, 0x96, 0xd5, 0xe4,
+	0x05, 0x23, 0x57, 0x10, 0x8a, 0x7b, 0xea, 0xda, 0x70, 0x66, 0x51, 0x22,
+	0xc7, 0x7a, 0xbd, 0x57, 0x66, 0xed, 0xdb, 0x6a, 0x81, 0x37, 0x07, 0x40,
+	0x35, 0x68, 0x62, 0xe3, 0x54, 0x33, 0x55, 0x93, 0x89, 0x99, 0x15, 0x43,
+	0x3d, 0x77, 0x50, 0x7e, 0xe9, 0x2c, 0x42, 0x6c, 0x4f, 0x63, 0xce, 0x48,
+	0x4a, 0x99, 0x3a, 0x57, 0x1a, 0x56, 0x1f, 0x79, 0xf9, 0xb5, 0xab, 0xc9,
+	0x2e, 0x6c, 0xcc, 0x04, 0xcb, 0x99, 0x3e, 0x50, 0x0d, 0x19, 0x4c, 0x1e,
+	0x4d, 0x32, 0x50, 0xb0, 0xb7, 0x68, 0xd7, 0x76, 0xcb, 0xb2, 0x4e, 0x60,
+	0x87, 0x73, 0xa0, 0xa3, 0xf3, 0x34, 0x81, 0x8a, 0x59, 0xe1, 0x21, 0x3f,
+	0x7c, 0x10, 0x2d, 0x2d, 0xac, 0xdc, 0x16, 0xfb, 0xac, 0xc8, 0x10, 0xea,
+	0x12, 0x24, 0x18, 0xf6, 0x21, 0xb5, 0xeb, 0x01, 0xb2, 0xc0, 0xd3, 0x78,
+	0x2b, 0xa5, 0x86, 0x17, 0x0c, 0xb3, 0xc8, 0xbf, 0x61, 0x67, 0x27, 0x5b,
+	0x97, 0x3e, 0xe7, 0xfe, 0x21, 0x60, 0x61, 0x67, 0x6a, 0xbb, 0xa8, 0x8b,
+	0x92, 0xa7, 0x3a, 0x79, 0x9d, 0xea, 0x70, 0x5e, 0x2a, 0x9d, 0x68, 0x86,
+	0x02, 0x2e, 0x8d, 0x58, 0x56, 0xa5, 0x74, 0xbf, 0x7d, 0xe4, 0x76, 0xaa,
+	0xe3, 0x56, 0xfe, 0xbb, 0x5c, 0xd8, 0x9b, 0xad, 0x5d, 0xbb, 0x9f, 0x2d,
+	0x9d, 0xb4, 0x55, 0x18, 0x49, 0xa2, 0x3d, 0x19, 0x63, 0x4f, 0x27, 0xd5,
+	0x60, 0xcf, 0x83, 0xbc, 0xfb, 0xef, 0x79, 0x62, 0x24, 0x1a, 0xa2, 0xbc,
+	0x41, 0x04, 0x77, 0x53, 0xbc, 0x79, 0xd3, 0x8b, 0x1a, 0x4a, 0xb5, 0xc0,
+	0xfb, 0x9e, 0x02, 0x48, 0xf4, 0x45, 0x35, 0xea, 0x56, 0x5d, 0x70, 0x93,
+	0x5f, 0xa7, 0xd4, 0xfe, 0x3a, 0x6f, 0xd6, 0x7b, 0x03, 0x22, 0x1e, 0x25,
+	0x0e, 0xc8, 0x2a, 0x24, 0x66, 0x52, 0x55, 0x5b, 0x5a, 0x52, 0xf3, 0xe7,
+	0x51, 0xad, 0x58, 0xe5, 0x24, 0x31, 0xe9, 0x7d, 0xf1, 0x75, 0x81, 0x98,
+	0x58, 0xd1, 0x52, 0x11, 0x6a, 0xa4, 0xbb, 0xa8, 0x95, 0x30, 0x62, 0x3a,
+	0x49, 0xa3, 0x37, 0x86, 0x76, 0xa8, 0xef, 0xec, 0x9c, 0xfe, 0xaa, 0x63,
+	0xe5, 0x43, 0x64, 0xb9, 0x93, 0x2c, 0xf2, 0x7c, 0xab, 0x20, 0x64, 0x61,
+	0x39, 0xd2, 0x0e, 0xc1, 0xe2, 0x4f, 0xd6, 0xb3, 0xac, 0xae, 0x85, 0xf4,
+	0xdf, 0x98, 0x7d, 0xbe, 0x61, 0x59, 0xa7, 0x5c, 0xd0, 0x9a, 0xc3, 0x95,
+	0xd8, 0x17, 0x78, 0x82, 0xf8, 0x40, 0x0f, 0x74, 0x6a, 0x49, 0x2e, 0x8a,
+	0x07, 0xab, 0x5d, 0xde, 0x8b, 0xb7, 0x36, 0xbb, 0x00, 0x0b, 0x73, 0x33,
+	0x8f, 0xff, 0x7b, 0x70, 0x58, 0x13, 0x8c, 0xf8, 0x2c, 0xed, 0x54, 0x89,
+	0xcb, 0x67, 0x95, 0x0f, 0x7f, 0xd1, 0x21, 0xaa, 0x97, 0xaa, 0xc1, 0x12,
+	0xef, 0xcf, 0xb7, 0xec, 0xe6, 0xa0, 0x55, 0x4c, 0x13, 0x54, 0x34, 0xa7,
+	0xb9, 0x76, 0x1c, 0x16, 0x69, 0x76, 0x12, 0xfb, 0xe5, 0x6c, 0xce, 0xd2,
+	0x60, 0x6b, 0x07, 0x4f, 0x70, 0x0a, 0x44, 0xd8, 0xf2, 0x66, 0x72, 0x90,
+	0x36, 0x15, 0xe2, 0xc2, 0x03, 0x94, 0x04, 0x4c, 0x8d, 0x06, 0xff, 0x14,
+	0xf7, 0xaa, 0x3a, 0xcb, 0x97, 0x4d, 0x67, 0xb0, 0x35, 0x03, 0xe1, 0x18,
+	0xef, 0x35, 0x83, 0x33, 0xee, 0x0f, 0x99, 0x21, 0x69, 0xfa, 0xde, 0x39,
+	0x9e, 0x9f, 0x7c, 0x17, 0x67, 0x95, 0x68, 0xea, 0x07, 0xd3, 0xa3, 0x5b,
+	0xe7, 0x04, 0x7b, 0x42, 0x58, 0xff, 0x48, 0xea, 0x24, 0x4f, 0xe7, 0x61,
+	0xe5, 0xc7, 0x45, 0x2b, 0xe2, 0xef, 0xf7, 0xf5, 0x2a, 0xe2, 0x80, 0x9c,
+	0x89, 0x9a, 0x8b, 0xb0, 0xa1, 0xc9, 0x17, 0x27, 0xab, 0x8a, 0x12, 0xad,
+	0x97, 0x80, 0xfa, 0x24, 0x5b, 0xc2, 0x0b, 0x46, 0x13, 0xa0, 0x22, 0x97,
+	0xea, 0x26, 0x8b, 0xc4, 0x10, 0x33, 0xe1, 0x43, 0xf6, 0x0c, 0x54, 0x88,
+	0xa7, 0x39, 0x03, 0xed, 0x6c, 0x55, 0x86, 0xa6, 0x18, 0x3c, 0x38, 0x3d,
+	0xb3, 0x2a, 0x27, 0x34, 0x99, 0xfb, 0x1b, 0x69, 0xb8, 0x8c, 0x4b, 0x2e,
+	0xfd, 0xbd, 0x38, 0x01, 0xfe, 0x83, 0x23, 0x60, 0xb3, 0x07, 0x7c, 0x2e,
+	0xa5, 0x83, 0x62, 0x55, 0x58, 0xa7, 0xb7, 0x76, 0x69, 0x7c, 0x4a, 0xa6,
+	0x5f, 0x28, 0x6c, 0x18, 0x1a, 0x5a, 0x98, 0xa8, 0x9d, 0x32, 0xd5, 0x15,
+	0x27, 0x27, 0x63, 0x94, 0x86, 0xb0, 0x4d, 0x49, 0xdf, 0xf7, 0x2a, 0xfc,
+	0xf8, 0xfb, 0xbd, 0xd2, 0x79, 0x42, 0x5e, 0xc8, 0x9e, 0x41, 0x65, 0xf6,
+	0xce, 0xd2, 0x93, 0xc1, 0x37, 0xe5, 0x66, 0x0f, 0xf9, 0xc3, 0xff, 0x05,
+	0x0f, 0xbb, 0x00, 0x96, 0xe1, 0xa5, 0xfd, 0x23, 0x03, 0x0c, 0xc8, 0x11,
+	0x2a, 0x9f, 0x4c, 0xd2, 0x7b, 0xc3, 0xe5, 0xc8, 0x89, 0x4c, 0xde, 0xa9,
+	0xcd, 0xe0, 0xca, 0xc1, 0x3c, 0x50, 0xcf, 0x6c, 0x4b, 0xcf, 0xd0, 0xe9,
+	0x8d, 0x29, 0x4f, 0x4f, 0x7c, 0xf7, 0x58, 0xf5, 0xff, 0x83, 0xd1, 0xfc,
+	0xb4, 0x55, 0x20, 0xd3, 0x88, 0xf5, 0x43, 0x0d, 0x04, 0x00, 0x04, 0xec,
+	0x1f, 0x05, 0x00, 0x04, 0xec, 0x1f, 0x06, 0x00, 0x04, 0xec, 0x1f, 0x07,
+	0x00, 0x04, 0xec, 0x1f, 0x08, 0x00, 0x08, 0xec, 0x1f, 0x09, 0x00, 0x04,
+	0xec, 0x1f, 0x0a, 0x00, 0x04, 0xec, 0x1f, 0x0b, 0x00, 0x04, 0xec, 0x1f,
+	0x0c, 0x00, 0x0c, 0xec, 0x1f, 0x0d, 0x00, 0x04, 0xec, 0x1f, 0x0e, 0x00,
+	0x04, 0xec, 0x1f, 0x0f, 0x00, 0x04, 0xec, 0x1f, 0x10, 0x00, 0x04, 0xec,
+	0x1f, 0x11, 0x00, 0x04, 0xec, 0x1f, 0x12, 0x00, 0x04, 0xec, 0x1f, 0x13,
+	0x00, 0x04, 0xec, 0x1f, 0x14, 0x00, 0x04, 0xec, 0x1f, 0x15, 0x00, 0x04,
+	0xec, 0x1f, 0x16, 0x00, 0x04, 0xec, 0x1f, 0x17, 0x00, 0x04, 0xec, 0x1f,
+	0x18, 0x00, 0x04, 0xec, 0x1f, 0x19, 0x00, 0x04, 0xec, 0x1f, 0x1a, 0x00,
+	0x04, 0xec, 0x1f, 0x1b, 0x00, 0x04, 0xec, 0x1f, 0x1c, 0x00, 0x04, 0xec,
+	0x1f, 0x1d, 0x00, 0x04, 0xec, 0x1f, 0x1e, 0x00, 0x04, 0xec, 0x1f, 0x1f,
+	0x00, 0x04, 0xec, 0x1f, 0x20, 0x00, 0x04, 0xec, 0x1f, 0x21, 0x00, 0x04,
+	0xec, 0x1f, 0x22, 0x00, 0x04, 0xec, 0x1f, 0x23, 0x00, 0x04, 0xec, 0x1f,
+	0x24, 0x00, 0x04, 0xec, 0x1f, 0x25, 0x00, 0x04, 0xec, 0x1f, 0x26, 0x00,
+	0x04, 0xec, 0x1f, 0x27, 0x00, 0x04, 0xec, 0x1f, 0x28, 0x00, 0x04, 0xec,
+	0x1f, 0x29, 0x00, 0x04, 0xec, 0x1f, 0x2a, 0x00, 0x04, 0xec, 0x1f, 0x2b,
+	0x00, 0x04, 0xec, 0x1f, 0x2c, 0x00, 0x04, 0xec, 0x1f, 0x2d, 0x00, 0x04,
+	0xec, 0x1f, 0x2e, 0x00, 0x04, 0xec, 0x1f, 0x2f, 0x00, 0x04, 0xec, 0x1f,
+	0x30, 0x00, 0x04, 0xec, 0x1f, 0x31, 0x00, 0x04, 0xec, 0x1f, 0x32, 0x00,
+	0x04, 0xec, 0x1f, 0x33, 0x00, 0x04, 0xec, 0x1f, 0x34, 0x00, 0x04, 0xec,
+	0x1f, 0x35, 0x00, 0x04, 0xec, 0x1f, 0x36, 0x00, 0x04, 0xec, 0x1f, 0x37,
+	0x00, 0x04, 0xec, 0x1f, 0x38, 0x00, 0x04, 0xec, 0x1f, 0x39, 0x00, 0x04,
+	0xec, 0x1f, 0x3a, 0x00, 0x04, 0xec, 0x1f, 0x3b, 0x00, 0x04, 0xec, 0x1f,
+	0x3c, 0x00, 0x04, 0xec, 0x1f, 0x3d, 0x00, 0x04, 0xec, 0x1f, 0x3e, 0x00,
+	0x04, 0xec, 0x1f, 0x3f, 0x00, 0x04, 0xec, 0x1f, 0x40, 0x00, 0x04, 0xec,
+	0x1f, 0x41, 0x00, 0x04, 0xec, 0x1f, 0x42, 0x00, 0x04, 0xec, 0x1f, 0x43,
+	0x00, 0x04, 0xec, 0x1f, 0x44, 0x00, 0x04, 0xec, 0x1f, 0x45, 0x00, 0x04,
+	0xec, 0x1f, 0x46, 0x00, 0x04, 0xec, 0x1f, 0x47, 0x00, 0x04, 0xec, 0x1f,
+	0x48, 0x00, 0x04, 0xec, 0x1f, 0x49, 0x00, 0x04, 0xec, 0x1f, 0x4a, 0x00,
+	0x04, 0xec, 0x1f, 0x4b, 0x00, 0x04, 0xec, 0x1f, 0x4c, 0x00, 0x04, 0xec,
+	0x1f, 0x4d, 0x00, 0x04, 0xec, 0x1f, 0x4e, 0x00, 0x04, 0xec, 0x1f, 0x4f,
+	0x00, 0x04, 0xec, 0x1f, 0x50, 0x00, 0x04, 0xec, 0x1f, 0x51, 0x00, 0x04,
+	0xec, 0x1f, 0x52, 0x00, 0x04, 0xec, 0x1f, 0x53, 0x00, 0x04, 0xec, 0x1f,
+	0x54, 0x00, 0x04, 0xec, 0x1f, 0x55, 0x00, 0x04, 0xec, 0x1f, 0x56, 0x00,
+	0x04, 0xec, 0x1f, 0x57, 0x00, 0x04, 0xec, 0x1f, 0x58, 0x00, 0x04, 0xec,
+	0x1f, 0x59, 0x00, 0x04, 0xec, 0x1f, 0x5a, 0x00, 0x04, 0xec, 0x1f, 0x5b,
+	0x00, 0x04, 0xec, 0x1f, 0x5c, 0x00, 0x04, 0xec, 0x1f, 0x5d, 0x00, 0x04,
+	0xec, 0x1f, 0x5e, 0x00, 0x04, 0xec, 0x1f, 0x5f, 0x00, 0x04, 0xec, 0x1f,
+	0x60, 0x00, 0x04, 0xec, 0x1f, 0x61, 0x00, 0x04, 0xec, 0x1f, 0x62, 0x00,
+	0x04, 0xec, 0x1f, 0x63, 0x00, 0x04, 0xec, 0x1f, 0x64, 0x00, 0x04, 0xec,
+	0x1f, 0x65, 0x00, 0x04, 0xec, 0x1f, 0x66, 0x00, 0x04, 0xec, 0x1f, 0x67,
+	0x00, 0x04, 0xec, 0x1f, 0x68, 0x00, 0x04, 0xec, 0x1f, 0x69, 0x00, 0x04,
+	0xec, 0x1f, 0x6a, 0x00, 0x04, 0xec, 0x1f, 0x6b, 0x00, 0x04, 0xec, 0x1f,
+	0x6c, 0x00, 0x04, 0xec, 0x1f, 0x6d, 0x00, 0x04, 0xec, 0x1f, 0x6e, 0x00,
+	0x04, 0xec, 0x1f, 0x6f, 0x00, 0x04, 0xec, 0x1f, 0x70, 0x00, 0x04, 0xec,
+	0x1f, 0x71, 0x00, 0x04, 0xec, 0x1f, 0x72, 0x00, 0x04, 0xec, 0x1f, 0x73,
+	0x00, 0x04, 0xec, 0x1f, 0x74, 0x00, 0x04, 0xec, 0x1f, 0x75, 0x00, 0x04,
+	0xec, 0x1f, 0x76, 0x00, 0x04, 0xec, 0x1f, 0x77, 0x00, 0x04, 0xec, 0x1f,
+	0x78, 0x00, 0x04, 0xec, 0x1f, 0x79, 0x00, 0x04, 0xec, 0x1f, 0x7a, 0x00,
+	0x04, 0xec, 0x1f, 0x7b, 0x00, 0x04, 0xec, 0x1f, 0x7c, 0x00, 0x04, 0xec,
+	0x1f, 0x7d, 0x00, 0x04, 0xec, 0x1f, 0x7e, 0x00, 0x04, 0xec, 0x1f, 0x7f,
+	0x00, 0x04, 0xec, 0x1f, 0x80, 0x00, 0x04, 0xec, 0x1f, 0x81, 0x00, 0x04,
+	0xec, 0x1f, 0x82, 0x00, 0x04, 0xec, 0x1f, 0x83, 0x00, 0x04, 0xec, 0x1f,
+	0x84, 0x00, 0x04, 0xec, 0x1f, 0x85, 0x00, 0x04, 0xec, 0x1f, 0x86, 0x00,
+	0x04, 0xec, 0x1f, 0x87, 0x00, 0x04, 0xec, 0x1f, 0x88, 0x00, 0x04, 0xec,
+	0x1f, 0x89, 0x00, 0x04, 0xec, 0x1f, 0x8a, 0x00, 0x04, 0xec, 0x1f, 0x8b,
+	0x00, 0x04, 0xec, 0x1f, 0x8c, 0x00, 0x04, 0xec, 0x1f, 0x8d, 0x00, 0x04,
+	0xec, 0x1f, 0x8e, 0x00, 0x04, 0xec, 0x1f, 0x8f, 0x00, 0x04, 0xec, 0x1f,
+	0x90, 0x00, 0x04, 0xec, 0x1f, 0x91, 0x00, 0x04, 0xec, 0x1f, 0x92, 0x00,
+	0x04, 0xec, 0x1f, 0x93, 0x00, 0x04, 0xec, 0x1f, 0x94, 0x00, 0x04, 0xec,
+	0x1f, 0x95, 0x00, 0x04, 0xec, 0x1f, 0x96, 0x00, 0x04, 0xec, 0x1f, 0x97,
+	0x00, 0x04, 0xec, 0x1f, 0x98, 0x00, 0x04, 0xec, 0x1f, 0x99, 0x00, 0x04,
+	0xec, 0x1f, 0x9a, 0x00, 0x04, 0xec, 0x1f, 0x9b, 0x00, 0x04, 0xec, 0x1f,
+	0x9c, 0x00, 0x04, 0xec, 0x1f, 0x9d, 0x00, 0x04, 0xec, 0x1f, 0x9e, 0x00,
+	0x04, 0xec, 0x1f, 0x9f, 0x00, 0x04, 0xec, 0x1f, 0xa0, 0x00, 0x04, 0xec,
+	0x1f, 0xa1, 0x00, 0x04, 0xec, 0x1f, 0xa2, 0x00, 0x04, 0xec, 0x1f, 0xa3,
+	0x00, 0x04, 0xec, 0x1f, 0xa4, 0x00, 0x04, 0xec, 0x1f, 0xa5, 0x00, 0x04,
+	0xec, 0x1f, 0xa6, 0x00, 0x04, 0xec, 0x1f, 0xa7, 0x00, 0x04, 0xec, 0x1f,
+	0xa8, 0x00, 0x04, 0xec, 0x1f, 0xa9, 0x00, 0x04, 0xec, 0x1f, 0xaa, 0x00,
+	0x04, 0xec, 0x1f, 0xab, 0x00, 0x04, 0xec, 0x1f, 0xac, 0x00, 0x04, 0xec,
+	0x1f, 0xad, 0x00, 0x04, 0xec, 0x1f, 0xae, 0x00, 0x04, 0xec, 0x1f, 0xaf,
+	0x00, 0x04, 0xec, 0x1f, 0xb0, 0x00, 0x04, 0xec, 0x1f, 0xb1, 0x00, 0x04,
+	0xec, 0x1f, 0xb2, 0x00, 0x04, 0xec, 0x1f, 0xb3, 0x00, 0x04, 0xec, 0x1f,
+	0xb4, 0x00, 0x04, 0xec, 0x1f, 0xb5, 0x00, 0x04, 0xec, 0x1f, 0xb6, 0x00,
+	0x04, 0xec, 0x1f, 0xb7, 0x00, 0x04, 0xec, 0x1f, 0xb8, 0x00, 0x04, 0xec,
+	0x1f, 0xb9, 0x00, 0x04, 0xec, 0x1f, 0xba, 0x00, 0x04, 0xec, 0x1f, 0xbb,
+	0x00, 0x04, 0xec, 0x1f, 0xbc, 0x00, 0x04, 0xec, 0x1f, 0xbd, 0x00, 0x04,
+	0xec, 0x1f, 0xbe, 0x00, 0x04, 0xec, 0x1f, 0xbf, 0x00, 0x04, 0xec, 0x1f,
+	0xc0, 0x00, 0x04, 0xec, 0x1f, 0xc1, 0x00, 0x04, 0xec, 0x1f, 0xc2, 0x00,
+	0x04, 0xec, 0x1f, 0xc3, 0x00, 0x04, 0xec, 0x1f, 0xc4, 0x00, 0x04, 0xec,
+	0x1f, 0xc5, 0x00, 0x04, 0xec, 0x1f, 0xc6, 0x00, 0x04, 0xec, 0x1f, 0xc7,
+	0x00, 0x04, 0xec, 0x1f, 0xc8, 0x00, 0x04, 0xec, 0x1f, 0xc9, 0x00, 0x04,
+	0xec, 0x1f, 0xca, 0x00, 0x04, 0xec, 0x1f, 0xcb, 0x00, 0x04, 0xec, 0x1f,
+	0xcc, 0x00, 0x04, 0xec, 0x1f, 0xcd, 0x00, 0x04, 0xec, 0x1f, 0xce, 0x00,
+	0x04, 0xec, 0x1f, 0xcf, 0x00, 0x04, 0xec, 0x1f, 0xd0, 0x00, 0x04, 0xec,
+	0x1f, 0xd1, 0x00, 0x04, 0xec, 0x1f, 0xd2, 0x00, 0x04, 0xec, 0x1f, 0xd3,
+	0x00, 0x04, 0xec, 0x1f, 0xd4, 0x00, 0x04, 0xec, 0x1f, 0xd5, 0x00, 0x04,
+	0xec, 0x1f, 0xd6, 0x00, 0x04, 0xec, 0x1f, 0xd7, 0x00, 0x04, 0xec, 0x1f,
+	0xd8, 0x00, 0x04, 0xec, 0x1f, 0xd9, 0x00, 0x04, 0xec, 0x1f, 0xda, 0x00,
+	0x04, 0xec, 0x1f, 0xdb, 0x00, 0x04, 0xec, 0x1f, 0xdc, 0x00, 0x04, 0xec,
+	0x1f, 0xdd, 0x00, 0x04, 0xec, 0x1f, 0xde, 0x00, 0x04, 0xec, 0x1f, 0xdf,
+	0x00, 0x04, 0xec, 0x1f, 0xe0, 0x00, 0x04, 0xec, 0x1f, 0xe1, 0x00, 0x04,
+	0xec, 0x1f, 0xe2, 0x00, 0x04, 0xec, 0x1f, 0xe3, 0x00, 0x04, 0xec, 0x1f,
+	0xe4, 0x00, 0x04, 0xec, 0x1f, 0xe5, 0x00, 0x04, 0xec, 0x1f, 0xe6, 0x00,
+	0x04, 0xec, 0x1f, 0xe7, 0x00, 0x04, 0xec, 0x1f, 0xe8, 0x00, 0x04, 0xec,
+	0x1f, 0xe9, 0x00, 0x04, 0xec, 0x1f, 0xea, 0x00, 0x04, 0xec, 0x1f, 0xeb,
+	0x00, 0x04, 0xec, 0x1f, 0xec, 0x00, 0x04, 0xec, 0x1f, 0xed, 0x00, 0x04,
+	0xec, 0x1f, 0xee, 0x00, 0x04, 0xec, 0x1f, 0xef, 0x00, 0x04, 0xec, 0x1f,
+	0xf0, 0x00, 0x04, 0xec, 0x1f, 0xf1, 0x00, 0x04, 0xec, 0x1f, 0xf2, 0x00,
+	0x04, 0xec, 0x1f, 0xf3, 0x00, 0x04, 0xec, 0x1f, 0xf4, 0x00, 0x04, 0xec,
+	0x1f, 0xf5, 0x00, 0x04, 0xec, 0x1f, 0xf6, 0x00, 0x04, 0xec, 0x1f, 0xf7,
+	0x00, 0x04, 0xec, 0x1f, 0xf8, 0x00, 0x04, 0xec, 0x1f, 0xf9, 0x00, 0x04,
+	0xec, 0x1f, 0xfa, 0x00, 0x04, 0xec, 0x1f, 0xfb, 0x00, 0x04, 0xec, 0x1f,
+	0xfc, 0x00, 0x04, 0xec, 0x1f, 0xfd, 0x00, 0x04, 0xec, 0x1f, 0xfe, 0x00,
+	0x04, 0xec, 0x1f, 0xff, 0x00, 0x04, 0xe7, 0x50, 0xd3, 0x88, 0xf5, 0x43,
+	0x0d, 0xa2, 0x01, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x04, 0xec, 0x1f, 0x01,
+	0x00, 0x04, 0xec, 0x1f, 0x02, 0x00, 0x04, 0xec, 0x1f, 0x03, 0x00, 0x04,
+	0xec, 0x1f, 0x04, 0x00, 0x04, 0xec, 0x1f, 0x05, 0x00, 0x04, 0xec, 0x1f,
+	0x06, 0x00, 0x04, 0xec, 0x1f, 0x07, 0x00, 0x04, 0xec, 0x1f, 0x08, 0x00,
+	0x04, 0xec, 0x1f, 0x09, 0x00, 0x04, 0xec, 0x1f, 0x0a, 0x00, 0x04, 0xec,
+	0x1f, 0x0b, 0x00, 0x04, 0xec, 0xff, 0xf2, 0x0c, 0x7a, 0xa0, 0x7e, 0xe1,
+	0xea, 0xf2, 0x3d, 0xc7, 0x39, 0x6d, 0x0d, 0xa6, 0x78, 0x16, 0x80, 0x05,
+	0x12, 0x3a, 0xa7, 0x4e, 0xde, 0x9f, 0x78, 0x9c, 0x70, 0x63, 0x00, 0x0b,
+	0xe6, 0xc8, 0x25, 0x21, 0x3d, 0xad, 0x22, 0xbc, 0x70, 0xb3, 0x85, 0xda,
+	0x21, 0x23, 0x63, 0x36, 0x17, 0x7b, 0xc3, 0x79, 0xfd, 0x62, 0x6c, 0xf9,
+	0x66, 0x43, 0xf1, 0x1f, 0xbd, 0x61, 0x63, 0xbd, 0x7c, 0x99, 0x90, 0x67,
+	0xf3, 0xd1, 0x98, 0xf0, 0x8c, 0x88, 0xd3, 0x90, 0x34, 0x3f, 0x14, 0xd1,
+	0xaa, 0xff, 0x72, 0x48, 0x27, 0x35, 0xf9, 0xde, 0x34, 0x4e, 0xb0, 0x4a,
+	0x10, 0xd8, 0xd5, 0x83, 0x7e, 0x10, 0xa4, 0x57, 0x4d, 0xd7, 0x31, 0x39,
+	0x3c, 0x26, 0x9f, 0x56, 0x69, 0x48, 0x3b, 0x0d, 0x32, 0x34, 0xa7, 0x0c,
+	0x79, 0x3d, 0x1a, 0x24, 0x37, 0xbf, 0xc2, 0x8b, 0xd2, 0x16, 0x20, 0xcf,
+	0x84, 0x7c, 0xbe, 0xc6, 0xba, 0xbb, 0xf4, 0x77, 0x3f, 0x32, 0x89, 0xc9,
+	0xbb, 0xae, 0xed, 0x0b, 0x7d, 0x14, 0xa7, 0x1e, 0xe0, 0xed, 0x3c, 0x0f,
+	0x8f, 0x3e, 0xb7, 0x78, 0xb6, 0x7e, 0x23, 0x38, 0x04, 0x7c, 0x01, 0x4d,
+	0x4b, 0x54, 0x38, 0xbd, 0xcc, 0x3a, 0xf0, 0x63, 0x23, 0x20, 0xc6, 0x4b,
+	0x4b, 0xfb, 0xff, 0xbd, 0x42, 0x33, 0x75, 0x5f, 0xff, 0x20, 0xe5, 0x40,
+	0x6d, 0x89, 0x6f, 0xf6, 0x43, 0x77, 0xf8, 0xf4, 0x1f, 0x1e, 0x04, 0x87,
+	0xba, 0x00, 0xe4, 0x21, 0x6e, 0x90, 0xf1, 0x46, 0xfd, 0xfd, 0x02, 0x47,
+	0x05, 0x2a, 0x17, 0x9e, 0x5f, 0xd9, 0x80, 0x78, 0x69, 0x83, 0x0a, 0x73,
+	0x67, 0xd2, 0x82, 0x9c, 0x0b, 0x03, 0xe3, 0xc0, 0xf4, 0x9d, 0x33, 0x74,
+	0xf1, 0x9f, 0x58, 0x1a, 0x8e, 0x02, 0x27, 0x78, 0x51, 0xb6, 0xeb, 0x45,
+	0x10, 0x6d, 0x4a, 0xad, 0xfe, 0x90, 0x66, 0xc1, 0xe1, 0xe6, 0xbf, 0x0d,
+	0x00, 0x04, 0xec, 0x1f, 0x0e, 0x00, 0x04, 0xec, 0x1f, 0x0f, 0x00, 0x04,
+	0xec, 0x1f, 0x10, 0x00, 0x04, 0xec, 0x1f, 0x11, 0x00, 0x04, 0xec, 0x1f,
+	0x12, 0x00, 0x04, 0xec, 0x1f, 0x13, 0x00, 0x04, 0xec, 0x1f, 0x14, 0x00,
+	0x04, 0xec, 0x1f, 0x15, 0x00, 0x04, 0xec, 0x1f, 0x16, 0x00, 0x04, 0xec,
+	0x1f, 0x17, 0x00, 0x04, 0xec, 0x1f, 0x18, 0x00, 0x04, 0xec, 0x1f, 0x19,
+	0x00, 0x04, 0xec, 0x1f, 0x1a, 0x00, 0x04, 0xec, 0x1f, 0x1b, 0x00, 0x04,
+	0xec, 0x1f, 0x1c, 0x00, 0x04, 0xec, 0x1f, 0x1d, 0x00, 0x04, 0xec, 0x1f,
+	0x1e, 0x00, 0x04, 0xec, 0x1f, 0x1f, 0x00, 0x04, 0xe7, 0x50, 0xd3, 0x88,
+	0xf5, 0x43, 0x0d, 0x00, 0x00, 0x00, 0x00,
+};
+
+static const UINT8 frame_independent[] = {
+	0x04, 0x22, 0x4d, 0x18, 0x74, 0x40, 0xbd, 0xf6, 0x08, 0x00, 0x00, 0xff,
+	0xff, 0xff, 0xff, 0xf5, 0x00, 0x7a, 0xa0, 0x7e, 0xe1, 0xea, 0xf2, 0x3d,
+	0xc7, 0x39, 0x6d, 0x0d, 0xa6, 0x78, 0x16, 0x80, 0x05, 0x12, 0x3a, 0xa7,
+	0x4e, 0xde, 0x9f, 0x78, 0x9c, 0x70, 0x63, 0x00, 0x0b, 0xe6, 0xc8, 0x25,
+	0x21, 0x3d, 0xad, 0x22, 0xbc, 0x70, 0xb3, 0x85, 0xda, 0x21, 0x23, 0x63,
+	0x36, 0x17, 0x7b, 0xc3, 0x79, 0xfd, 0x62, 0x6c, 0xf9, 0x66, 0x43, 0xf1,
+	0x1f, 0xbd, 0x61, 0x63, 0xbd, 0x7c, 0x99, 0x90, 0x67, 0xf3, 0xd1, 0x98,
+	0xf0, 0x8c, 0x88, 0xd3, 0x90, 0x34, 0x3f, 0x14, 0xd1, 0xaa, 0xff, 0x72,
+	0x48, 0x27, 0x35, 0xf9, 0xde, 0x34, 0x4e, 0xb0, 0x4a, 0x10, 0xd8, 0xd5,
+	0x83, 0x7e, 0x10, 0xa4, 0x57, 0x4d, 0xd7, 0x31, 0x39, 0x3c, 0x26, 0x9f,
+	0x56, 0x69, 0x48, 0x3b, 0x0d, 0x32, 0x34, 0xa7, 0x0c, 0x79, 0x3d, 0x1a,
+	0x24, 0x37, 0xbf, 0xc2, 0x8b, 0xd2, 0x16, 0x20, 0xcf, 0x84, 0x7c, 0xbe,
+	0xc6, 0xba, 0xbb, 0xf4, 0x77, 0x3f, 0x32, 0x89, 0xc9, 0xbb, 0xae, 0xed,
+	0x0b, 0x7d, 0x14, 0xa7, 0x1e, 0xe0, 0xed, 0x3c, 0x0f, 0x8f, 0x3e, 0xb7,
+	0x78, 0xb6, 0x7e, 0x23, 0x38, 0x04, 0x7c, 0x01, 0x4d, 0x4b, 0x54, 0x38,
+	0xbd, 0xcc, 0x3a, 0xf0, 0x63, 0x23, 0x20, 0xc6, 0x4b, 0x4b, 0xfb, 0xff,
+	0xbd, 0x42, 0x33, 0x75, 0x5f, 0xff, 0x20, 0xe5, 0x40, 0x6d, 0x89, 0x6f,
+	0xf6, 0x43, 0x77, 0xf8, 0xf4, 0x1f, 0x1e, 0x04, 0x87, 0xba, 0x00, 0xe4,
+	0x21, 0x6e, 0x90, 0xf1, 0x46, 0xfd, 0xfd, 0x02, 0x47, 0x05, 0x2a, 0x17,
+	0x9e, 0x5f, 0xd9, 0x80, 0x78, 0x69, 0x83, 0x0a, 0x73, 0x67, 0xd2, 0x82,
+	0x9c, 0x0b, 0x03, 0xe3, 0xc0, 0xf4, 0x9d, 0x33, 0x74, 0xf1, 0x9f, 0x58,
+	0x1a, 0x8e, 0x02, 0x27, 0x78, 0x51, 0xb6, 0xeb, 0x45, 0x10, 0x6d, 0x4a,
+	0xad, 0xfe, 0x90, 0x66, 0xc1, 0xe1, 0xe6, 0xbf, 0x01, 0x9d, 0x9f, 0x30,
+	0xe8, 0xe4, 0x1a, 0xdc, 0x28, 0xb7, 0x40, 0xd7, 0xe3, 0x78, 0x2c, 0xcb,
+	0x8c, 0x01, 0x96, 0x34, 0x26, 0x51, 0xcb, 0x32, 0xab, 0x0a, 0x18, 0x14,
+	0x3f, 0x03, 0xad, 0x2e, 0x12, 0x58, 0x57, 0xd6, 0x7b, 0x4d, 0xda, 0x20,
+	0xc6, 0xee, 0xf2, 0x4f, 0xe2, 0x32, 0xe1, 0x2f, 0x21, 0x7a, 0x79, 0x04,
+	0x23, 0x65, 0x59, 0xc3, 0x27, 0x19, 0xa5, 0x14, 0x3f, 0x4e, 0x2f, 0x73,
+	0xa9, 0xe6, 0x5d, 0x22, 0x07, 0xc5, 0x1d, 0xbf, 0x1e, 0xb3, 0xd0, 0x2e,
+	0x12, 0x0a, 0x33, 0x3b, 0x66, 0x66, 0x47, 0xe7, 0x7d, 0xa4, 0x3b, 0xbd,
+	0x19, 0x43, 0xbd, 0xe0, 0x5b, 0x02, 0x14, 0x4c, 0x10, 0x96, 0xd5, 0xe4,
+	0x05, 0x23, 0x57, 0x10, 0x8a, 0x7b, 0xea, 0xda, 0x70, 0x66, 0x51, 0x22,
+	0xc7, 0x7a, 0xbd, 0x57, 0x66, 0xed, 0xdb, 0x6a, 0x81, 0x37, 0x07, 0x40,
+	0x35, 0x68, 0x62, 0xe3, 0x54, 0x33, 0x55, 0x93, 0x89, 0x99, 0x15, 0x43,
+	0x3d, 0x77, 0x50, 0x7e, 0xe9, 0x2c, 0x42, 0x6c, 0x4f, 0x63, 0xce, 0x48,
+	0x4a, 0x99, 0x3a, 0x57, 0x1a, 0x56, 0x1f, 0x79, 0xf9, 0xb5, 0xab, 0xc9,
+	0x2e, 0x6c, 0xcc, 0x04, 0xcb, 0x99, 0x3e, 0x50, 0x0d, 0x19, 0x4c, 0x1e,
+	0x4d, 0x32, 0x50, 0xb0, 0xb7, 0x68, 0xd7, 0x76, 0xcb, 0xb2, 0x4e, 0x60,
+	0x87, 0x73, 0xa0, 0xa3, 0xf3, 0x34, 0x81, 0x8a, 0x59, 0xe1, 0x21, 0x3f,
+	0x7c, 0x10, 0x2d, 0x2d, 0xac, 0xdc, 0x16, 0xfb, 0xac, 0xc8, 0x10, 0xea,
+	0x12, 0x24, 0x18, 0xf6, 0x21, 0xb5, 0xeb, 0x01, 0xb2, 0xc0, 0xd3, 0x78,
+	0x2b, 0xa5, 0x86, 0x17, 0x0c, 0xb3, 0xc8, 0xbf, 0x61, 0x67, 0x27, 0x5b,
+	0x97, 0x3e, 0xe7, 0xfe, 0x21, 0x60, 0x61, 0x67, 0x6a, 0xbb, 0xa8, 0x8b,
+	0x92, 0xa7, 0x3a, 0x79, 0x9d, 0xea, 0x70, 0x5e, 0x2a, 0x9d, 0x68, 0x86,
+	0x02, 0x2e, 0x8d, 0x58, 0x56, 0xa5, 0x74, 0xbf, 0x7d, 0xe4, 0x76, 0xaa,
+	0xe3, 0x56, 0xfe, 0xbb, 0x5c, 0xd8, 0x9b, 0xad, 0x5d, 0xbb, 0x9f, 0x2d,
+	0x9d, 0xb4, 0x55, 0x18, 0x49, 0xa2, 0x3d, 0x19, 0x63, 0x4f, 0x27, 0xd5,
+	0x60, 0xcf, 0x83, 0xbc, 0xfb, 0xef, 0x79, 0x62, 0x24, 0x1a, 0xa2, 0xbc,
+	0x41, 0x04, 0x77, 0x53, 0xbc, 0x79, 0xd3, 0x8b, 0x1a, 0x4a, 0xb5, 0xc0,
+	0xfb, 0x9e, 0x02, 0x48, 0xf4, 0x45, 0x35, 0xea, 0x56, 0x5d, 0x70, 0x93,
+	0x5f, 0xa7, 0xd4, 0xfe, 0x3a, 0x6f, 0xd6, 0x7b, 0x03, 0x22, 0x1e, 0x25,
+	0x0e, 0xc8, 0x2a, 0x24, 0x66, 0x52, 0x55, 0x5b, 0x5a, 0x52, 0xf3, 0xe7,
+	0x51, 0xad, 0x58, 0xe5, 0x24, 0x31, 0xe9, 0x7d, 0xf1, 0x75, 0x81, 0x98,
+	0x58, 0xd1, 0x52, 0x11, 0x6a, 0xa4, 0xbb, 0xa8, 0x95, 0x30, 0x62, 0x3a,
+	0x49, 0xa3, 0x37, 0x86, 0x76, 0xa8, 0xef, 0xec, 0x9c, 0xfe, 0xaa, 0x63,
+	0xe5, 0x43, 0x64, 0xb9, 0x93, 0x2c, 0xf2, 0x7c, 0xab, 0x20, 0x64, 0x61,
+	0x39, 0xd2, 0x0e, 0xc1, 0xe2, 0x4f, 0xd6, 0xb3, 0xac, 0xae, 0x85, 0xf4,
+	0xdf, 0x98, 0x7d, 0xbe, 0x61, 0x59, 0xa7, 0x5c, 0xd0, 0x9a, 0xc3, 0x95,
+	0xd8, 0x17, 0x78, 0x82, 0xf8, 0x40, 0x0f, 0x74, 0x6a, 0x49, 0x2e, 0x8a,
+	0x07, 0xab, 0x5d, 0xde, 0x8b, 0xb7, 0x36, 0xbb, 0x00, 0x0b, 0x73, 0x33,
+	0x8f, 0xff, 0x7b, 0x70, 0x58, 0x13, 0x8c, 0xf8, 0x2c, 0xed, 0x54, 0x89,
+	0xcb, 0x67, 0x95, 0x0f, 0x7f, 0xd1, 0x21, 0xaa, 0x97, 0xaa, 0xc1, 0x12,
+	0xef, 0xcf, 0xb7, 0xec, 0xe6, 0xa0, 0x55, 0x4c, 0x13, 0x54, 0x34, 0xa7,
+	0xb9, 0x76, 0x1c, 0x16, 0x69, 0x76, 0x12, 0xfb, 0xe5, 0x6c, 0xce, 0xd2,
+	0x60, 0x6b, 0x07, 0x4f, 0x70, 0x0a, 0x44, 0xd8, 0xf2, 0x66, 0x72, 0x90,
+	0x36, 0x15, 0xe2, 0xc2, 0x03, 0x94, 0x04, 0x4c, 0x8d, 0x06, 0xff, 0x14,
+	0xf7, 0xaa, 0x3a, 0xcb, 0x97, 0x4d, 0x67, 0xb0, 0x35, 0x03, 0xe1, 0x18,
+	0xef, 0x35, 0x83, 0x33, 0xee, 0x0f, 0x99, 0x21, 0x69, 0xfa, 0xde, 0x39,
+	0x9e, 0x9f, 0x7c, 0x17, 0x67, 0x95, 0x68, 0xea, 0x07, 0xd3, 0xa3, 0x5b,
+	0xe7, 0x04, 0x7b, 0x42, 0x58, 0xff, 0x48, 0xea, 0x24, 0x4f, 0xe7, 0x61,
+	0xe5, 0xc7, 0x45, 0x2b, 0xe2, 0xef, 0xf7, 0xf5, 0x2a, 0xe2, 0x80, 0x9c,
+	0x89, 0x9a, 0x8b, 0xb0, 0xa1, 0xc9, 0x17, 0x27, 0xab, 0x8a, 0x12, 0xad,
+	0x97, 0x80, 0xfa, 0x24, 0x5b, 0xc2, 0x0b, 0x46, 0x13, 0xa0, 0x22, 0x97,
+	0xea, 0x26, 0x8b, 0xc4, 0x10, 0x33, 0xe1, 0x43, 0xf6, 0x0c, 0x54, 0x88,
+	0xa7, 0x39, 0x03, 0xed, 0x6c, 0x55, 0x86, 0xa6, 0x18, 0x3c, 0x38, 0x3d,
+	0xb3, 0x2a, 0x27, 0x34, 0x99, 0xfb, 0x1b, 0x69, 0xb8, 0x8c, 0x4b, 0x2e,
+	0xfd, 0xbd, 0x38, 0x01, 0xfe, 0x83, 0x23, 0x60, 0xb3, 0x07, 0x7c, 0x2e,
+	0xa5, 0x83, 0x62, 0x55, 0x58, 0xa7, 0xb7, 0x76, 0x69, 0x7c, 0x4a, 0xa6,
+	0x5f, 0x28, 0x6c, 0x18, 0x1a, 0x5a, 0x98, 0xa8, 0x9d, 0x32, 0xd5, 0x15,
+	0x27, 0x27, 0x63, 0x94, 0x86, 0xb0, 0x4d, 0x49, 0xdf, 0xf7, 0x2a, 0xfc,
+	0xf8, 0xfb, 0xbd, 0xd2, 0x79, 0x42, 0x5e, 0xc8, 0x9e, 0x41, 0x65, 0xf6,
+	0xce, 0xd2, 0x93, 0xc1, 0x37, 0xe5, 0x66, 0x0f, 0xf9, 0xc3, 0xff, 0x05,
+	0x0f, 0xbb, 0x00, 0x96, 0xe1, 0xa5, 0xfd, 0x23, 0x03, 0x0c, 0xc8, 0x11,
+	0x2a, 0x9f, 0x4c, 0xd2, 0x7b, 0xc3, 0xe5, 0xc8, 0x89, 0x4c, 0xde, 0xa9,
+	0xcd, 0xe0, 0xca, 0xc1, 0x3c, 0x50, 0xcf, 0x6c, 0x4b, 0xcf, 0xd0, 0xe9,
+	0x8d, 0x29, 0x4f, 0x4f, 0x7c, 0xf7, 0x58, 0xf5, 0xff, 0x83, 0xd1, 0xfc,
+	0xb4, 0x55, 0x20, 0xd3, 0x88, 0xf5, 0x43, 0x0d, 0x04, 0x00, 0x04, 0xec,
+	0x1f, 0x05, 0x00, 0x04, 0xec, 0x1f, 0x06, 0x00, 0x04, 0xec, 0x1f, 0x07,
+	0x00, 0x04, 0xec, 0x1f, 0x08, 0x00, 0x08, 0xec, 0x1f, 0x09, 0x00, 0x04,
+	0xec, 0x1f, 0x0a, 0x00, 0x04, 0xec, 0x1f, 0x0b, 0x00, 0x04, 0xec, 0x1f,
+	0x0c, 0x00, 0x04, 0xec, 0x1f, 0x0d, 0x00, 0x04, 0xec, 0x1f, 0x0e, 0x00,
+	0x04, 0xec, 0x1f, 0x0f, 0x00, 0x04, 0xec, 0x1f, 0x10, 0x00, 0x04, 0xec,
+	0x1f, 0x11, 0x00, 0x04, 0xec, 0x1f, 0x12, 0x00, 0x04, 0xec, 0x1f, 0x13,
+	0x00, 0x04, 0xec, 0x1f, 0x14, 0x00, 0x04, 0xec, 0x1f, 0x15, 0x00, 0x04,
+	0xec, 0x1f, 0x16, 0x00, 0x04, 0xec, 0x1f, 0x17, 0x00, 0x04, 0xec, 0x1f,
+	0x18, 0x00, 0x04, 0xec, 0x1f, 0x19, 0x00, 0x04, 0xec, 0x1f, 0x1a, 0x00,
+	0x04, 0xec, 0x1f, 0x1b, 0x00, 0x04, 0xec, 0x1f, 0x1c, 0x00, 0x04, 0xec,
+	0x1f, 0x1d, 0x00, 0x04, 0xec, 0x1f, 0x1e, 0x00, 0x04, 0xec, 0x1f, 0x1f,
+	0x00, 0x04, 0xec, 0x1f, 0x20, 0x00, 0x04, 0xec, 0x1f, 0x21, 0x00, 0x04,
+	0xec, 0x1f, 0x22, 0x00, 0x04, 0xec, 0x1f, 0x23, 0x00, 0x04, 0xec, 0x1f,
+	0x24, 0x00, 0x04, 0xec, 0x1f, 0x25, 0x00, 0x04, 0xec, 0x1f, 0x26, 0x00,
+	0x04, 0xec, 0x1f, 0x27, 0x00, 0x04, 0xec, 0x1f, 0x28, 0x00, 0x04, 0xec,
+	0x1f, 0x29, 0x00, 0x04, 0xec, 0x1f, 0x2a, 0x00, 0x04, 0xec, 0x1f, 0x2b,
+	0x00, 0x04, 0xec, 0x1f, 0x2c, 0x00, 0x04, 0xec, 0x1f, 0x2d, 0x00, 0x04,
+	0xec, 0x1f, 0x2e, 0x00, 0x04, 0xec, 0x1f, 0x2f, 0x00, 0x04, 0xec, 0x1f,
+	0x30, 0x00, 0x04, 0xec, 0x1f, 0x31, 0x00, 0x04, 0xec, 0x1f, 0x32, 0x00,
+	0x04, 0xec, 0x1f, 0x33, 0x00, 0x04, 0xec, 0x1f, 0x34, 0x00, 0x04, 0xec,
+	0x1f, 0x35, 0x00, 0x04, 0xec, 0x1f, 0x36, 0x00, 0x04, 0xec, 0x1f, 0x37,
+	0x00, 0x04, 0xec, 0x1f, 0x38, 0x00, 0x04, 0xec, 0x1f, 0x39, 0x00, 0x04,
+	0xec, 0x1f, 0x3a, 0x00, 0x04, 0xec, 0x1f, 0x3b, 0x00, 0x04, 0xec, 0x1f,
+	0x3c, 0x00, 0x04, 0xec, 0x1f, 0x3d, 0x00, 0x04, 0xec, 0x1f, 0x3e, 0x00,
+	0x04, 0xec, 0x1f, 0x3f, 0x00, 0x04, 0xec, 0x1f, 0x40, 0x00, 0x04, 0xec,
+	0x1f, 0x41, 0x00, 0x04, 0xec, 0x1f, 0x42, 0x00, 0x04, 0xec, 0x1f, 0x43,
+	0x00, 0x04, 0xec, 0x1f, 0x44, 0x00, 0x04, 0xec, 0x1f, 0x45, 0x00, 0x04,
+	0xec, 0x1f, 0x46, 0x00, 0x04, 0xec, 0x1f, 0x47, 0x00, 0x04, 0xec, 0x1f,
+	0x48, 0x00, 0x04, 0xec, 0x1f, 0x49, 0x00, 0x04, 0xec, 0x1f, 0x4a, 0x00,
+	0x04, 0xec, 0x1f, 0x4b, 0x00, 0x04, 0xec, 0x1f, 0x4c, 0x00, 0x04, 0xec,
+	0x1f, 0x4d, 0x00, 0x04, 0xec, 0x1f, 0x4e, 0x00, 0x04, 0xec, 0x1f, 0x4f,
+	0x00, 0x04, 0xec, 0x1f, 0x50, 0x00, 0x04, 0xec, 0x1f, 0x51, 0x00, 0x04,
+	0xec, 0x1f, 0x52, 0x00, 0x04, 0xec, 0x1f, 0x53, 0x00, 0x04, 0xec, 0x1f,
+	0x54, 0x00, 0x04, 0xec, 0x1f, 0x55, 0x00, 0x04, 0xec, 0x1f, 0x56, 0x00,
+	0x04, 0xec, 0x1f, 0x57, 0x00, 0x04, 0xec, 0x1f, 0x58, 0x00, 0x04, 0xec,
+	0x1f, 0x59, 0x00, 0x04, 0xec, 0x1f, 0x5a, 0x00, 0x04, 0xec, 0x1f, 0x5b,
+	0x00, 0x04, 0xec, 0x1f, 0x5c, 0x00, 0x04, 0xec, 0x1f, 0x5d, 0x00, 0x04,
+	0xec, 0x1f, 0x5e, 0x00, 0x04, 0xec, 0x1f, 0x5f, 0x00, 0x04, 0xec, 0x1f,
+	0x60, 0x00, 0x04, 0xec, 0x1f, 0x61, 0x00, 0x04, 0xec, 0x1f, 0x62, 0x00,
+	0x04, 0xec, 0x1f, 0x63, 0x00, 0x04, 0xec, 0x1f, 0x64, 0x00, 0x04, 0xec,
+	0x1f, 0x65, 0x00, 0x04, 0xec, 0x1f, 0x66, 0x00, 0x04, 0xec, 0x1f, 0x67,
+	0x00, 0x04, 0xec, 0x1f, 0x68, 0x00, 0x04, 0xec, 0x1f, 0x69, 0x00, 0x04,
+	0xec, 0x1f, 0x6a, 0x00, 0x04, 0xec, 0x1f, 0x6b, 0x00, 0x04, 0xec, 0x1f,
+	0x6c, 0x00, 0x04, 0xec, 0x1f, 0x6d, 0x00, 0x04, 0xec, 0x1f, 0x6e, 0x00,
+	0x04, 0xec, 0x1f, 0x6f, 0x00, 0x04, 0xec, 0x1f, 0x70, 0x00, 0x04, 0xec,
+	0x1f, 0x71, 0x00, 0x04, 0xec, 0x1f, 0x72, 0x00, 0x04, 0xec, 0x1f, 0x73,
+	0x00, 0x04, 0xec, 0x1f, 0x74, 0x00, 0x04, 0xec, 0x1f, 0x75, 0x00, 0x04,
+	0xec, 0x1f, 0x76, 0x00, 0x04, 0xec, 0x1f, 0x77, 0x00, 0x04, 0xec, 0x1f,
+	0x78, 0x00, 0x04, 0xec, 0x1f, 0x79, 0x00, 0x04, 0xec, 0x1f, 0x7a, 0x00,
+	0x04, 0xec, 0x1f, 0x7b, 0x00, 0x04, 0xec, 0x1f, 0x7c, 0x00, 0x04, 0xec,
+	0x1f, 0x7d, 0x00, 0x04, 0xec, 0x1f, 0x7e, 0x00, 0x04, 0xec, 0x1f, 0x7f,
+	0x00, 0x04, 0xec, 0x1f, 0x80, 0x00, 0x04, 0xec, 0x1f, 0x81, 0x00, 0x04,
+	0xec, 0x1f, 0x82, 0x00, 0x04, 0xec, 0x1f, 0x83, 0x00, 0x04, 0xec, 0x1f,
+	0x84, 0x00, 0x04, 0xec, 0x1f, 0x85, 0x00, 0x04, 0xec, 0x1f, 0x86, 0x00,
+	0x04, 0xec, 0x1f, 0x87, 0x00, 0x04, 0xec, 0x1f, 0x88, 0x00, 0x04, 0xec,
+	0x1f, 0x89, 0x00, 0x04, 0xec, 0x1f, 0x8a, 0x00, 0x04, 0xec, 0x1f, 0x8b,
+	0x00, 0x04, 0xec, 0x1f, 0x8c, 0x00, 0x04, 0xec, 0x1f, 0x8d, 0x00, 0x04,
+	0xec, 0x1f, 0x8e, 0x00, 0x04, 0xec, 0x1f, 0x8f, 0x00, 0x04, 0xec, 0x1f,
+	0x90, 0x00, 0x04, 0xec, 0x1f, 0x91, 0x00, 0x04, 0xec, 0x1f, 0x92, 0x00,
+	0x04, 0xec, 0x1f, 0x93, 0x00, 0x04, 0xec, 0x1f, 0x94, 0x00, 0x04, 0xec,
+	0x1f, 0x95, 0x00, 0x04, 0xec, 0x1f, 0x96, 0x00, 0x04, 0xec, 0x1f, 0x97,
+	0x00, 0x04, 0xec, 0x1f, 0x98, 0x00, 0x04, 0xec, 0x1f, 0x99, 0x00, 0x04,
+	0xec, 0x1f, 0x9a, 0x00, 0x04, 0xec, 0x1f, 0x9b, 0x00, 0x04, 0xec, 0x1f,
+	0x9c, 0x00, 0x04, 0xec, 0x1f, 0x9d, 0x00, 0x04, 0xec, 0x1f, 0x9e, 0x00,
+	0x04, 0xec, 0x1f, 0x9f, 0x00, 0x04, 0xec, 0x1f, 0xa0, 0x00, 0x04, 0xec,
+	0x1f, 0xa1, 0x00, 0x04, 0xec, 0x1f, 0xa2, 0x00, 0x04, 0xec, 0x1f, 0xa3,
+	0x00, 0x04, 0xec, 0x1f, 0xa4, 0x00, 0x04, 0xec, 0x1f, 0xa5, 0x00, 0x04,
+	0xec, 0x1f, 0xa6, 0x00, 0x04, 0xec, 0x1f, 0xa7, 0x00, 0x04, 0xec, 0x1f,
+	0xa8, 0x00, 0x04, 0xec, 0x1f, 0xa9, 0x00, 0x04, 0xec, 0x1f, 0xaa, 0x00,
+	0x04, 0xec, 0x1f, 0xab, 0x00, 0x04, 0xec, 0x1f, 0xac, 0x00, 0x04, 0xec,
+	0x1f, 0xad, 0x00, 0x04, 0xec, 0x1f, 0xae, 0x00, 0x04, 0xec, 0x1f, 0xaf,
+	0x00, 0x04, 0xec, 0x1f, 0xb0, 0x00, 0x04, 0xec, 0x1f, 0xb1, 0x00, 0x04,
+	0xec, 0x1f, 0xb2, 0x00, 0x04, 0xec, 0x1f, 0xb3, 0x00, 0x04, 0xec, 0x1f,
+	0xb4, 0x00, 0x04, 0xec, 0x1f, 0xb5, 0x00, 0x04, 0xec, 0x1f, 0xb6, 0x00,
+	0x04, 0xec, 0x1f, 0xb7, 0x00, 0x04, 0xec, 0x1f, 0xb8, 0x00, 0x04, 0xec,
+	0x1f, 0xb9, 0x00, 0x04, 0xec, 0x1f, 0xba, 0x00, 0x04, 0xec, 0x1f, 0xbb,
+	0x00, 0x04, 0xec, 0x1f, 0xbc, 0x00, 0x04, 0xec, 0x1f, 0xbd, 0x00, 0x04,
+	0xec, 0x1f, 0xbe, 0x00, 0x04, 0xec, 0x1f, 0xbf, 0x00, 0x04, 0xec, 0x1f,
+	0xc0, 0x00, 0x04, 0xec, 0x1f, 0xc1, 0x00, 0x04, 0xec, 0x1f, 0xc2, 0x00,
+	0x04, 0xec, 0x1f, 0xc3, 0x00, 0x04, 0xec, 0x1f, 0xc4, 0x00, 0x04, 0xec,
+	0x1f, 0xc5, 0x00, 0x04, 0xec, 0x1f, 0xc6, 0x00, 0x04, 0xec, 0x1f, 0xc7,
+	0x00, 0x04, 0xec, 0x1f, 0xc8, 0x00, 0x04, 0xec, 0x1f, 0xc9, 0x00, 0x04,
+	0xec, 0x1f, 0xca, 0x00, 0x04, 0xec, 0x1f, 0xcb, 0x00, 0x04, 0xec, 0x1f,
+	0xcc, 0x00, 0x04, 0xec, 0x1f, 0xcd, 0x00, 0x04, 0xec, 0x1f, 0xce, 0x00,
+	0x04, 0xec, 0x1f, 0xcf, 0x00, 0x04, 0xec, 0x1f, 0xd0, 0x00, 0x04, 0xec,
+	0x1f, 0xd1, 0x00, 0x04, 0xec, 0x1f, 0xd2, 0x00, 0x04, 0xec, 0x1f, 0xd3,
+	0x00, 0x04, 0xec, 0x1f, 0xd4, 0x00, 0x04, 0xec, 0x1f, 0xd5, 0x00, 0x04,
+	0xec, 0x1f, 0xd6, 0x00, 0x04, 0xec, 0x1f, 0xd7, 0x00, 0x04, 0xec, 0x1f,
+	0xd8, 0x00, 0x04, 0xec, 0x1f, 0xd9, 0x00, 0x04, 0xec, 0x1f, 0xda, 0x00,
+	0x04, 0xec, 0x1f, 0xdb, 0x00, 0x04, 0xec, 0x1f, 0xdc, 0x00, 0x04, 0xec,
+	0x1f, 0xdd, 0x00, 0x04, 0xec, 0x1f, 0xde, 0x00, 0x04, 0xec, 0x1f, 0xdf,
+	0x00, 0x04, 0xec, 0x1f, 0xe0, 0x00, 0x04, 0xec, 0x1f, 0xe1, 0x00, 0x04,
+	0xec, 0x1f, 0xe2, 0x00, 0x04, 0xec, 0x1f, 0xe3, 0x00, 0x04, 0xec, 0x1f,
+	0xe4, 0x00, 0x04, 0xec, 0x1f, 0xe5, 0x00, 0x04, 0xec, 0x1f, 0xe6, 0x00,
+	0x04, 0xec, 0x1f, 0xe7, 0x00, 0x04, 0xec, 0x1f, 0xe8, 0x00, 0x04, 0xec,
+	0x1f, 0xe9, 0x00, 0x04, 0xec, 0x1f, 0xea, 0x00, 0x04, 0xec, 0x1f, 0xeb,
+	0x00, 0x04, 0xec, 0x1f, 0xec, 0x00, 0x04, 0xec, 0x1f, 0xed, 0x00, 0x04,
+	0xec, 0x1f, 0xee, 0x00, 0x04, 0xec, 0x1f, 0xef, 0x00, 0x04, 0xec, 0x1f,
+	0xf0, 0x00, 0x04, 0xec, 0x1f, 0xf1, 0x00, 0x04, 0xec, 0x1f, 0xf2, 0x00,
+	0x04, 0xec, 0x1f, 0xf3, 0x00, 0x04, 0xec, 0x1f, 0xf4, 0x00, 0x04, 0xec,
+	0x1f, 0xf5, 0x00, 0x04, 0xec, 0x1f, 0xf6, 0x00, 0x04, 0xec, 0x1f, 0xf7,
+	0x00, 0x04, 0xec, 0x1f, 0xf8, 0x00, 0x04, 0xec, 0x1f, 0xf9, 0x00, 0x04,
+	0xec, 0x1f, 0xfa, 0x00, 0x04, 0xec, 0x1f, 0xfb, 0x00, 0x04, 0xec, 0x1f,
+	0xfc, 0x00, 0x04, 0xec, 0x1f, 0xfd, 0x00, 0x04, 0xec, 0x1f, 0xfe, 0x00,
+	0x04, 0xec, 0x1f, 0xff, 0x00, 0x04, 0xe7, 0x50, 0xd3, 0x88, 0xf5, 0x43,
+	0x0d, 0x6d, 0xd8, 0xbf, 0x05, 0x96, 0x04, 0x00, 0x00, 0xff, 0xff, 0xff,
+	0xff, 0xf5, 0x00, 0x7a, 0xa0, 0x7e, 0xe1, 0xea, 0xf2, 0x3d, 0xc7, 0x39,
+	0x6d, 0x0d, 0xa6, 0x78, 0x16, 0x80, 0x05, 0x12, 0x3a, 0xa7, 0x4e, 0xde,
+	0x9f, 0x78, 0x9c, 0x70, 0x63, 0x00, 0x0b, 0xe6, 0xc8, 0x25, 0x21, 0x3d,
+	0xad, 0x22, 0xbc, 0x70, 0xb3, 0x85, 0xda, 0x21, 0x23, 0x63, 0x36, 0x17,
+	0x7b, 0xc3, 0x79, 0xfd, 0x62, 0x6c, 0xf9, 0x66, 0x43, 0xf1, 0x1f, 0xbd,
+	0x61, 0x63, 0xbd, 0x7c, 0x99, 0x90, 0x67, 0xf3, 0xd1, 0x98, 0xf0, 0x8c,
+	0x88, 0xd3, 0x90, 0x34, 0x3f, 0x14, 0xd1, 0xaa, 0xff, 0x72, 0x48, 0x27,
+	0x35, 0xf9, 0xde, 0x34, 0x4e, 0xb0, 0x4a, 0x10, 0xd8, 0xd5, 0x83, 0x7e,
+	0x10, 0xa4, 0x57, 0x4d, 0xd7, 0x31, 0x39, 0x3c, 0x26, 0x9f, 0x56, 0x69,
+	0x48, 0x3b, 0x0d, 0x32, 0x34, 0xa7, 0x0c, 0x79, 0x3d, 0x1a, 0x24, 0x37,
+	0xbf, 0xc2, 0x8b, 0xd2, 0x16, 0x20, 0xcf, 0x84, 0x7c, 0xbe, 0xc6, 0xba,
+	0xbb, 0xf4, 0x77, 0x3f, 0x32, 0x89, 0xc9, 0xbb, 0xae, 0xed, 0x0b, 0x7d,
+	0x14, 0xa7, 0x1e, 0xe0, 0xed, 0x3c, 0x0f, 0x8f, 0x3e, 0xb7, 0x78, 0xb6,
+	0x7e, 0x23, 0x38, 0x04, 0x7c, 0x01, 0x4d, 0x4b, 0x54, 0x38, 0xbd, 0xcc,
+	0x3a, 0xf0, 0x63, 0x23, 0x20, 0xc6, 0x4b, 0x4b, 0xfb, 0xff, 0xbd, 0x42,
+	0x33, 0x75, 0x5f, 0xff, 0x20, 0xe5, 0x40, 0x6d, 0x89, 0x6f, 0xf6, 0x43,
+	0x77, 0xf8, 0xf4, 0x1f, 0x1e, 0x04, 0x87, 0xba, 0x00, 0xe4, 0x21, 0x6e,
+	0x90, 0xf1, 0x46, 0xfd, 0xfd, 0x02, 0x47, 0x05, 0x2a, 0x17, 0x9e, 0x5f,
+	0xd9, 0x80, 0x78, 0x69, 0x83, 0x0a, 0x73, 0x67, 0xd2, 0x82, 0x9c, 0x0b,
+	0x03, 0xe3, 0xc0, 0xf4, 0x9d, 0x33, 0x74, 0xf1, 0x9f, 0x58, 0x1a, 0x8e,
+	0x02, 0x27, 0x78, 0x51, 0xb6, 0xeb, 0x45, 0x10, 0x6d, 0x4a, 0xad, 0xfe,
+	0x90, 0x66, 0xc1, 0xe1, 0xe6, 0xbf, 0x01, 0x9d, 0x9f, 0x30, 0xe8, 0xe4,
+	0x1a, 0xdc, 0x28, 0xb7, 0x40, 0xd7, 0xe3, 0x78, 0x2c, 0xcb, 0x8c, 0x01,
+	0x96, 0x34, 0x26, 0x51, 0xcb, 0x32, 0xab, 0x0a, 0x18, 0x14, 0x3f, 0x03,
+	0xad, 0x2e, 0x12, 0x58, 0x57, 0xd6, 0x7b, 0x4d, 0xda, 0x20, 0xc6, 0xee,
+	0xf2, 0x4f, 0xe2, 0x32, 0xe1, 0x2f, 0x21, 0x7a, 0x79, 0x04, 0x23, 0x65,
+	0x59, 0xc3, 0x27, 0x19, 0xa5, 0x14, 0x3f, 0x4e, 0x2f, 0x73, 0xa9, 0xe6,
+	0x5d, 0x22, 0x07, 0xc5, 0x1d, 0xbf, 0x1e, 0xb3, 0xd0, 0x2e, 0x12, 0x0a,
+	0x33, 0x3b, 0x66, 0x66, 0x47, 0xe7, 0x7d, 0xa4, 0x3b, 0xbd, 0x19, 0x43,
+	0xbd, 0xe0, 0x5b, 0x02, 0x14, 0x4c, 0x10, 0x96, 0xd5, 0xe4, 0x05, 0x23,
+	0x57, 0x10, 0x8a, 0x7b, 0xea, 0xda, 0x70, 0x66, 0x51, 0x22, 0xc7, 0x7a,
+	0xbd, 0x57, 0x66, 0xed, 0xdb, 0x6a, 0x81, 0x37, 0x07, 0x40, 0x35, 0x68,
+	0x62, 0xe3, 0x54, 0x33, 0x55, 0x93, 0x89, 0x99, 0x15, 0x43, 0x3d, 0x77,
+	0x50, 0x7e, 0xe9, 0x2c, 0x42, 0x6c, 0x4f, 0x63, 0xce, 0x48, 0x4a, 0x99,
+	0x3a, 0x57, 0x1a, 0x56, 0x1f, 0x79, 0xf9, 0xb5, 0xab, 0xc9, 0x2e, 0x6c,
+	0xcc, 0x04, 0xcb, 0x99, 0x3e, 0x50, 0x0d, 0x19, 0x4c, 0x1e, 0x4d, 0x32,
+	0x50, 0xb0, 0xb7, 0x68, 0xd7, 0x76, 0xcb, 0xb2, 0x4e, 0x60, 0x87, 0x73,
+	0xa0, 0xa3, 0xf3, 0x34, 0x81, 0x8a, 0x59, 0xe1, 0x21, 0x3f, 0x7c, 0x10,
+	0x2d, 0x2d, 0xac, 0xdc, 0x16, 0xfb, 0xac, 0xc8, 0x10, 0xea, 0x12, 0x24,
+	0x18, 0xf6, 0x21, 0xb5, 0xeb, 0x01, 0xb2, 0xc0, 0xd3, 0x78, 0x2b, 0xa5,
+	0x86, 0x17, 0x0c, 0xb3, 0xc8, 0xbf, 0x61, 0x67, 0x27, 0x5b, 0x97, 0x3e,
+	0xe7, 0xfe, 0x21, 0x60, 0x61, 0x67, 0x6a, 0xbb, 0xa8, 0x8b, 0x92, 0xa7,
+	0x3a, 0x79, 0x9d, 0xea, 0x70, 0x5e, 0x2a, 0x9d, 0x68, 0x86, 0x02, 0x2e,
+	0x8d, 0x58, 0x56, 0xa5, 0x74, 0xbf, 0x7d, 0xe4, 0x76, 0xaa, 0xe3, 0x56,
+	0xfe, 0xbb, 0x5c, 0xd8, 0x9b, 0xad, 0x5d, 0xbb, 0x9f, 0x2d, 0x9d, 0xb4,
+	0x55, 0x18, 0x49, 0xa2, 0x3d, 0x19, 0x63, 0x4f, 0x27, 0xd5, 0x60, 0xcf,
+	0x83, 0xbc, 0xfb, 0xef, 0x79, 0x62, 0x24, 0x1a, 0xa2, 0xbc, 0x41, 0x04,
+	0x77, 0x53, 0xbc, 0x79, 0xd3, 0x8b, 0x1a, 0x4a, 0xb5, 0xc0, 0xfb, 0x9e,
+	0x02, 0x48, 0xf4, 0x45, 0x35, 0xea, 0x56, 0x5d, 0x70, 0x93, 0x5f, 0xa7,
+	0xd4, 0xfe, 0x3a, 0x6f, 0xd6, 0x7b, 0x03, 0x22, 0x1e, 0x25, 0x0e, 0xc8,
+	0x2a, 0x24, 0x66, 0x52, 0x55, 0x5b, 0x5a, 0x52, 0xf3, 0xe7, 0x51, 0xad,
+	0x58, 0xe5, 0x24, 0x31, 0xe9, 0x7d, 0xf1, 0x75, 0x81, 0x98, 0x58, 0xd1,
+	0x52, 0x11, 0x6a, 0xa4, 0xbb, 0xa8, 0x95, 0x30, 0x62, 0x3a, 0x49, 0xa3,
+	0x37, 0x86, 0x76, 0xa8, 0xef, 0xec, 0x9c, 0xfe, 0xaa, 0x63, 0xe5, 0x43,
+	0x64, 0xb9, 0x93, 0x2c, 0xf2, 0x7c, 0xab, 0x20, 0x64, 0x61, 0x39, 0xd2,
+	0x0e, 0xc1, 0xe2, 0x4f, 0xd6, 0xb3, 0xac, 0xae, 0x85, 0xf4, 0xdf, 0x98,
+	0x7d, 0xbe, 0x61, 0x59, 0xa7, 0x5c, 0xd0, 0x9a, 0xc3, 0x95, 0xd8, 0x17,
+	0x78, 0x82, 0xf8, 0x40, 0x0f, 0x74, 0x6a, 0x49, 0x2e, 0x8a, 0x07, 0xab,
+	0x5d, 0xde, 0x8b, 0xb7, 0x36, 0xbb, 0x00, 0x0b, 0x73, 0x33, 0x8f, 0xff,
+	0x7b, 0x70, 0x58, 0x13, 0x8c, 0xf8, 0x2c, 0xed, 0x54, 0x89, 0xcb, 0x67,
+	0x95, 0x0f, 0x7f, 0xd1, 0x21, 0xaa, 0x97, 0xaa, 0xc1, 0x12, 0xef, 0xcf,
+	0xb7, 0xec, 0xe6, 0xa0, 0x55, 0x4c, 0x13, 0x54, 0x34, 0xa7, 0xb9, 0x76,
+	0x1c, 0x16, 0x69, 0x76, 0x12, 0xfb, 0xe5, 0x6c, 0xce, 0xd2, 0x60, 0x6b,
+	0x07, 0x4f, 0x70, 0x0a, 0x44, 0xd8, 0xf2, 0x66, 0x72, 0x90, 0x36, 0x15,
+	0xe2, 0xc2, 0x03, 0x94, 0x04, 0x4c, 0x8d, 0x06, 0xff, 0x14, 0xf7, 0xaa,
+	0x3a, 0xcb, 0x97, 0x4d, 0x67, 0xb0, 0x35, 0x03, 0xe1, 0x18, 0xef, 0x35,
+	0x83, 0x33, 0xee, 0x0f, 0x99, 0x21, 0x69, 0xfa, 0xde, 0x39, 0x9e, 0x9f,
+	0x7c, 0x17, 0x67, 0x95, 0x68, 0xea, 0x07, 0xd3, 0xa3, 0x5b, 0xe7, 0x04,
+	0x7b, 0x42, 0x58, 0xff, 0x48, 0xea, 0x24, 0x4f, 0xe7, 0x61, 0xe5, 0xc7,
+	0x45, 0x2b, 0xe2, 0xef, 0xf7, 0xf5, 0x2a, 0xe2, 0x80, 0x9c, 0x89, 0x9a,
+	0x8b, 0xb0, 0xa1, 0xc9, 0x17, 0x27, 0xab, 0x8a, 0x12, 0xad, 0x97, 0x80,
+	0xfa, 0x24, 0x5b, 0xc2, 0x0b, 0x46, 0x13, 0xa0, 0x22, 0x97, 0xea, 0x26,
+	0x8b, 0xc4, 0x10, 0x33, 0xe1, 0x43, 0xf6, 0x0c, 0x54, 0x88, 0xa7, 0x39,
+	0x03, 0xed, 0x6c, 0x55, 0x86, 0xa6, 0x18, 0x3c, 0x38, 0x3d, 0xb3, 0x2a,
+	0x27, 0x34, 0x99, 0xfb, 0x1b, 0x69, 0xb8, 0x8c, 0x4b, 0x2e, 0xfd, 0xbd,
+	0x38, 0x01, 0xfe, 0x83, 0x23, 0x60, 0xb3, 0x07, 0x7c, 0x2e, 0xa5, 0x83,
+	0x62, 0x55, 0x58, 0xa7, 0xb7, 0x76, 0x69, 0x7c, 0x4a, 0xa6, 0x5f, 0x28,
+	0x6c, 0x18, 0x1a, 0x5a, 0x98, 0xa8, 0x9d, 0x32, 0xd5, 0x15, 0x27, 0x27,
+	0x63, 0x94, 0x86, 0xb0, 0x4d, 0x49, 0xdf, 0xf7, 0x2a, 0xfc, 0xf8, 0xfb,
+	0xbd, 0xd2, 0x79, 0x42, 0x5e, 0xc8, 0x9e, 0x41, 0x65, 0xf6, 0xce, 0xd2,
+	0x93, 0xc1, 0x37, 0xe5, 0x66, 0x0f, 0xf9, 0xc3, 0xff, 0x05, 0x0f, 0xbb,
+	0x00, 0x96, 0xe1, 0xa5, 0xfd, 0x23, 0x03, 0x0c, 0xc8, 0x11, 0x2a, 0x9f,
+	0x4c, 0xd2, 0x7b, 0xc3, 0xe5, 0xc8, 0x89, 0x4c, 0xde, 0xa9, 0xcd, 0xe0,
+	0xca, 0xc1, 0x3c, 0x50, 0xcf, 0x6c, 0x4b, 0xcf, 0xd0, 0xe9, 0x8d, 0x29,
+	0x4f, 0x4f, 0x7c, 0xf7, 0x58, 0xf5, 0xff, 0x83, 0xd1, 0xfc, 0xb4, 0x55,
+	0x20, 0xd3, 0x88, 0xf5, 0x43, 0x0d, 0x04, 0x00, 0x04, 0xec, 0x1f, 0x05,
+	0x00, 0x04, 0xec, 0x1f, 0x06, 0x00, 0x04, 0xec, 0x1f, 0x07, 0x00, 0x04,
+	0xec, 0x1f, 0x08, 0x00, 0x08, 0xec, 0x1f, 0x09, 0x00, 0x04, 0xec, 0x1f,
+	0x0a, 0x00, 0x04, 0xec, 0x1f, 0x0b, 0x00, 0x04, 0xec, 0x1f, 0x0c, 0x00,
+	0x04, 0xec, 0x1f, 0x0d, 0x00, 0x04, 0xec, 0x1f, 0x0e, 0x00, 0x04, 0xec,
+	0x1f, 0x0f, 0x00, 0x04, 0xec, 0x1f, 0x10, 0x00, 0x04, 0xec, 0x1f, 0x11,
+	0x00, 0x04, 0xec, 0x1f, 0x12, 0x00, 0x04, 0xec, 0x1f, 0x13, 0x00, 0x04,
+	0xec, 0x1f, 0x14, 0x00, 0x04, 0xec, 0x1f, 0x15, 0x00, 0x04, 0xec, 0x1f,
+	0x16, 0x00, 0x04, 0xec, 0x1f, 0x17, 0x00, 0x04, 0xec, 0x1f, 0x18, 0x00,
+	0x04, 0xec, 0x1f, 0x19, 0x00, 0x04, 0xec, 0x1f, 0x1a, 0x00, 0x04, 0xec,
+	0x1f, 0x1b, 0x00, 0x04, 0xec, 0x1f, 0x1c, 0x00, 0x04, 0xec, 0x1f, 0x1d,
+	0x00, 0x04, 0xec, 0x1f, 0x1e, 0x00, 0x04, 0xec, 0x1f, 0x1f, 0x00, 0x04,
+	0xe7, 0x50, 0xd3, 0x88, 0xf5, 0x43, 0x0d, 0x70, 0x6b, 0x79, 0x95, 0x00,
+	0x00, 0x00, 0x00, 0x28, 0x45, 0xa9, 0x7c,
+};
+
+static const UINT8 frame_linked_checksums[] = {
+	0x04, 0x22, 0x4d, 0x18, 0x5c, 0x40, 0x00, 0x20, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0xe6, 0xf6, 0x08, 0x00, 0x00, 0xff, 0xff, 0xff, 0xff, 0xf5,
+	0x00, 0x7a, 0xa0, 0x7e, 0xe1, 0xea, 0xf2, 0x3d, 0xc7, 0x39, 0x6d, 0x0d,
+	0xa6, 0x78, 0x16, 0x80, 0x05, 0x12, 0x3a, 0xa7, 0x4e, 0xde, 0x9f, 0x78,
+	0x9c, 0x70, 0x63, 0x00, 0x0b, 0xe6, 0xc8, 0x25, 0x21, 0x3d, 0xad, 0x22,
+	0xbc, 0x70, 0xb3, 0x85, 0xda, 0x21, 0x23, 0x63, 0x36, 0x17, 0x7b, 0xc3,
+	0x79, 0xfd, 0x62, 0x6c, 0xf9, 0x66, 0x43, 0xf1, 0x1f, 0xbd, 0x61, 0x63,
+	0xbd, 0x7c, 0x99, 0x90, 0x67, 0xf3, 0xd1, 0x98, 0xf0, 0x8c, 0x88, 0xd3,
+	0x90, 0x34, 0x3f, 0x14, 0xd1, 0xaa, 0xff, 0x72, 0x48, 0x27, 0x35, 0xf9,
+	0xde, 0x34, 0x4e, 0xb0, 0x4a, 0x10, 0xd8, 0xd5, 0x83, 0x7e, 0x10, 0xa4,
+	0x57, 0x4d, 0xd7, 0x31, 0x39, 0x3c, 0x26, 0x9f, 0x56, 0x69, 0x48, 0x3b,
+	0x0d, 0x32, 0x34, 0xa7, 0x0c, 0x79, 0x3d, 0x1a, 0x24, 0x37, 0xbf, 0xc2,
+	0x8b, 0xd2, 0x16, 0x20, 0xcf, 0x84, 0x7c, 0xbe, 0xc6, 0xba, 0xbb, 0xf4,
+	0x77, 0x3f, 0x32, 0x89, 0xc9, 0xbb, 0xae, 0xed, 0x0b, 0x7d, 0x14, 0xa7,
+	0x1e, 0xe0, 0xed, 0x3c, 0x0f, 0x8f, 0x3e, 0xb7, 0x78, 0xb6, 0x7e, 0x23,
+	0x38, 0x04, 0x7c, 0x01, 0x4d, 0x4b, 0x54, 0x38, 0xbd, 0xcc, 0x3a, 0xf0,
+	0x63, 0x23, 0x20, 0xc6, 0x4b, 0x4b, 0xfb, 0xff, 0xbd, 0x42, 0x33, 0x75,
+	0x5f, 0xff, 0x20, 0xe5, 0x40, 0x6d, 0x89, 0x6f, 0xf6, 0x43, 0x77, 0xf8,
+	0xf4, 0x1f, 0x1e, 0x04, 0x87, 0xba, 0x00, 0xe4, 0x21, 0x6e, 0x90, 0xf1,
+	0x46, 0xfd, 0xfd, 0x02, 0x47, 0x05, 0x2a, 0x17, 0x9e, 0x5f, 0xd9, 0x80,
+	0x78, 0x69, 0x83, 0x0a, 0x73, 0x67, 0xd2, 0x82, 0x9c, 0x0b, 0x03, 0xe3,
+	0xc0, 0xf4, 0x9d, 0x33, 0x74, 0xf1, 0x9f, 0x58, 0x1a, 0x8e, 0x02, 0x27,
+	0x78, 0x51, 0xb6, 0xeb, 0x45, 0x10, 0x6d, 0x4a, 0xad, 0xfe, 0x90, 0x66,
+	0xc1, 0xe1, 0xe6, 0xbf, 0x01, 0x9d, 0x9f, 0x30, 0xe8, 0xe4, 0x1a, 0xdc,
+	0x28, 0xb7, 0x40, 0xd7, 0xe3, 0x78, 0x2c, 0xcb, 0x8c, 0x01, 0x96, 0x34,
+	0x26, 0x51, 0xcb, 0x32, 0xab, 0x0a, 0x18, 0x14, 0x3f, 0x03, 0xad, 0x2e,
+	0x12, 0x58, 0x57, 0xd6, 0x7b, 0x4d, 0xda, 0x20, 0xc6, 0xee, 0xf2, 0x4f,
+	0xe2, 0x32, 0xe1, 0x2f, 0x21, 0x7a, 0x79, 0x04, 0x23, 0x65, 0x59, 0xc3,
+	0x27, 0x19, 0xa5, 0x14, 0x3f, 0x4e, 0x2f, 0x73, 0xa9, 0xe6, 0x5d, 0x22,
+	0x07, 0xc5, 0x1d, 0xbf, 0x1e, 0xb3, 0xd0, 0x2e, 0x12, 0x0a, 0x33, 0x3b,
+	0x66, 0x66, 0x47, 0xe7, 0x7d, 0xa4, 0x3b, 0xbd, 0x19, 0x43, 0xbd, 0xe0,
+	0x5b, 0x02, 0x14, 0x4c, 0x10, 0x96, 0xd5, 0xe4, 0x05, 0x23, 0x57, 0x10,
+	0x8a, 0x7b, 0xea, 0xda, 0x70, 0x66, 0x51, 0x22, 0xc7, 0x7a, 0xbd, 0x57,
+	0x66, 0xed, 0xdb, 0x6a, 0x81, 0x37, 0x07, 0x40, 0x35, 0x68, 0x62, 0xe3,
+	0x54, 0x33, 0x55, 0x93, 0x89, 0x99, 0x15, 0x43, 0x3d, 0x77, 0x50, 0x7e,
+	0xe9, 0x2c, 0x42, 0x6c, 0x4f, 0x63, 0xce, 0x48, 0x4a, 0x99, 0x3a, 0x57,
+	0x1a, 0x56, 0x1f, 0x79, 0xf9, 0xb5, 0xab, 0xc9, 0x2e, 0x6c, 0xcc, 0x04,
+	0xcb, 0x99, 0x3e, 0x50, 0x0d, 0x19, 0x4c, 0x1e, 0x4d, 0x32, 0x50, 0xb0,
+	0xb7, 0x68, 0xd7, 0x76, 0xcb, 0xb2, 0x4e, 0x60, 0x87, 0x73, 0xa0, 0xa3,
+	0xf3, 0x34, 0x81, 0x8a, 0x59, 0xe1, 0x21, 0x3f, 0x7c, 0x10, 0x2d, 0x2d,
+	0xac, 0xdc, 0x16, 0xfb, 0xac, 0xc8, 0x10, 0xea, 0x12, 0x24, 0x18, 0xf6,
+	0x21, 0xb5, 0xeb, 0x01, 0xb2, 0xc0, 0xd3, 0x78, 0x2b, 0xa5, 0x86, 0x17,
+	0x0c, 0xb3, 0xc8, 0xbf, 0x61, 0x67, 0x27, 0x5b, 0x97, 0x3e, 0xe7, 0xfe,
+	0x21, 0x60, 0x61, 0x67, 0x6a, 0xbb, 0xa8, 0x8b, 0x92, 0xa7, 0x3a, 0x79,
+	0x9d, 0xea, 0x70, 0x5e, 0x2a, 0x9d, 0x68, 0x86, 0x02, 0x2e, 0x8d, 0x58,
+	0x56, 0xa5, 0x74, 0xbf, 0x7d, 0xe4, 0x76, 0xaa, 0xe3, 0x56, 0xfe, 0xbb,
+	0x5c, 0xd8, 0x9b, 0xad, 0x5d, 0xbb, 0x9f, 0x2d, 0x9d, 0xb4, 0x55, 0x18,
+	0x49, 0xa2, 0x3d, 0x19, 0x63, 0x4f, 0x27, 0xd5, 0x60, 0xcf, 0x83, 0xbc,
+	0xfb, 0xef, 0x79, 0x62, 0x24, 0x1a, 0xa2, 0xbc, 0x41, 0x04, 0x77, 0x53,
+	0xbc, 0x79, 0xd3, 0x8b, 0x1a, 0x4a, 0xb5, 0xc0, 0xfb, 0x9e, 0x02, 0x48,
+	0xf4, 0x45, 0x35, 0xea, 0x56, 0x5d, 0x70, 0x93, 0x5f, 0xa7, 0xd4, 0xfe,
+	0x3a, 0x6f, 0xd6, 0x7b, 0x03, 0x22, 0x1e, 0x25, 0x0e, 0xc8, 0x2a, 0x24,
+	0x66, 0x52, 0x55, 0x5b, 0x5a, 0x52, 0xf3, 0xe7, 0x51, 0xad, 0x58, 0xe5,
+	0x24, 0x31, 0xe9, 0x7d, 0xf1, 0x75, 0x81, 0x98, 0x58, 0xd1, 0x52, 0x11,
+	0x6a, 0xa4, 0xbb, 0xa8, 0x95, 0x30, 0x62, 0x3a, 0x49, 0xa3, 0x37, 0x86,
+	0x76, 0xa8, 0xef, 0xec, 0x9c, 0xfe, 0xaa, 0x63, 0xe5, 0x43, 0x64, 0xb9,
+	0x93, 0x2c, 0xf2, 0x7c, 0xab, 0x20, 0x64, 0x61, 0x39, 0xd2, 0x0e, 0xc1,
+	0xe2, 0x4f, 0xd6, 0xb3, 0xac, 0xae, 0x85, 0xf4, 0xdf, 0x98, 0x7d, 0xbe,
+	0x61, 0x59, 0xa7, 0x5c, 0xd0, 0x9a, 0xc3, 0x95, 0xd8, 0x17, 0x78, 0x82,
+	0xf8, 0x40, 0x0f, 0x74, 0x6a, 0x49, 0x2e, 0x8a, 0x07, 0xab, 0x5d, 0xde,
+	0x8b, 0xb7, 0x36, 0xbb, 0x00, 0x0b, 0x73, 0x33, 0x8f, 0xff, 0x7b, 0x70,
+	0x58, 0x13, 0x8c, 0xf8, 0x2c, 0xed, 0x54, 0x89, 0xcb, 0x67, 0x95, 0x0f,
+	0x7f, 0xd1, 0x21, 0xaa, 0x97, 0xaa, 0xc1, 0x12, 0xef, 0xcf, 0xb7, 0xec,
+	0xe6, 0xa0, 0x55, 0x4c, 0x13, 0x54, 0x34, 0xa7, 0xb9, 0x76, 0x1c, 0x16,
+	0x69, 0x76, 0x12, 0xfb, 0xe5, 0x6c, 0xce, 0xd2, 0x60, 0x6b, 0x07, 0x4f,
+	0x70, 0x0a, 0x44, 0xd8, 0xf2, 0x66, 0x72, 0x90, 0x36, 0x15, 0xe2, 0xc2,
+	0x03, 0x94, 0x04, 0x4c, 0x8d, 0x06, 0xff, 0x14, 0xf7, 0xaa, 0x3a, 0xcb,
+	0x97, 0x4d, 0x67, 0xb0, 0x35, 0x03, 0xe1, 0x18, 0xef, 0x35, 0x83, 0x33,
+	0xee, 0x0f, 0x99, 0x21, 0x69, 0xfa, 0xde, 0x39, 0x9e, 0x9f, 0x7c, 0x17,
+	0x67, 0x95, 0x68, 0xea, 0x07, 0xd3, 0xa3, 0x5b, 0xe7, 0x04, 0x7b, 0x42,
+	0x58, 0xff, 0x48, 0xea, 0x24, 0x4f, 0xe7, 0x61, 0xe5, 0xc7, 0x45, 0x2b,
+	0xe2, 0xef, 0xf7, 0xf5, 0x2a, 0xe2, 0x80, 0x9c, 0x89, 0x9a, 0x8b, 0xb0,
+	0xa1, 0xc9, 0x17, 0x27, 0xab, 0x8a, 0x12, 0xad, 0x97, 0x80, 0xfa, 0x24,
+	0x5b, 0xc2, 0x0b, 0x46, 0x13, 0xa0, 0x22, 0x97, 0xea, 0x26, 0x8b, 0xc4,
+	0x10, 0x33, 0xe1, 0x43, 0xf6, 0x0c, 0x54, 0x88, 0xa7, 0x39, 0x03, 0xed,
+	0x6c, 0x55, 0x86, 0xa6, 0x18, 0x3c, 0x38, 0x3d, 0xb3, 0x2a, 0x27, 0x34,
+	0x99, 0xfb, 0x1b, 0x69, 0xb8, 0x8c, 0x4b, 0x2e, 0xfd, 0xbd, 0x38, 0x01,
+	0xfe, 0x83, 0x23, 0x60, 0xb3, 0x07, 0x7c, 0x2e, 0xa5, 0x83, 0x62, 0x55,
+	0x58, 0xa7, 0xb7, 0x76, 0x69, 0x7c, 0x4a, 0xa6, 0x5f, 0x28, 0x6c, 0x18,
+	0x1a, 0x5a, 0x98, 0xa8, 0x9d, 0x32, 0xd5, 0x15, 0x27, 0x27, 0x63, 0x94,
+	0x86, 0xb0, 0x4d, 0x49, 0xdf, 0xf7, 0x2a, 0xfc, 0xf8, 0xfb, 0xbd, 0xd2,
+	0x79, 0x42, 0x5e, 0xc8, 0x9e, 0x41, 0x65, 0xf6, 0xce, 0xd2, 0x93, 0xc1,
+	0x37, 0xe5, 0x66, 0x0f, 0xf9, 0xc3, 0xff, 0x05, 0x0f, 0xbb, 0x00, 0x96,
+	0xe1, 0xa5, 0xfd, 0x23, 0x03, 0x0c, 0xc8, 0x11, 0x2a, 0x9f, 0x4c, 0xd2,
+	0x7b, 0xc3, 0xe5, 0xc8, 0x89, 0x4c, 0xde, 0xa9, 0xcd, 0xe0, 0xca, 0xc1,
+	0x3c, 0x50, 0xcf, 0x6c, 0x4b, 0xcf, 0xd0, 0xe9, 0x8d, 0x29, 0x4f, 0x4f,
+	0x7c, 0xf7, 0x58, 0xf5, 0xff, 0x83, 0xd1, 0xfc, 0xb4, 0x55, 0x20, 0xd3,
+	0x88, 0xf5, 0x43, 0x0d, 0x04, 0x00, 0x04, 0xec, 0x1f, 0x05, 0x00, 0x04,
+	0xec, 0x1f, 0x06, 0x00, 0x04, 0xec, 0x1f, 0x07, 0x00, 0x04, 0xec, 0x1f,
+	0x08, 0x00, 0x08, 0xec, 0x1f, 0x09, 0x00, 0x04, 0xec, 0x1f, 0x0a, 0x00,
+	0x04, 0xec, 0x1f, 0x0b, 0x00, 0x04, 0xec, 0x1f, 0x0c, 0x00, 0x0c, 0xec,
+	0x1f, 0x0d, 0x00, 0x04, 0xec, 0x1f, 0x0e, 0x00, 0x04, 0xec, 0x1f, 0x0f,
+	0x00, 0x04, 0xec, 0x1f, 0x10, 0x00, 0x04, 0xec, 0x1f, 0x11, 0x00, 0x04,
+	0xec, 0x1f, 0x12, 0x00, 0x04, 0xec, 0x1f, 0x13, 0x00, 0x04, 0xec, 0x1f,
+	0x14, 0x00, 0x04, 0xec, 0x1f, 0x15, 0x00, 0x04, 0xec, 0x1f, 0x16, 0x00,
+	0x04, 0xec, 0x1f, 0x17, 0x00, 0x04, 0xec, 0x1f, 0x18, 0x00, 0x04, 0xec,
+	0x1f, 0x19, 0x00, 0x04, 0xec, 0x1f, 0x1a, 0x00, 0x04, 0xec, 0x1f, 0x1b,
+	0x00, 0x04, 0xec, 0x1f, 0x1c, 0x00, 0x04, 0xec, 0x1f, 0x1d, 0x00, 0x04,
+	0xec, 0x1f, 0x1e, 0x00, 0x04, 0xec, 0x1f, 0x1f, 0x00, 0x04, 0xec, 0x1f,
+	0x20, 0x00, 0x04, 0xec, 0x1f, 0x21, 0x00, 0x04, 0xec, 0x1f, 0x22, 0x00,
+	0x04, 0xec, 0x1f, 0x23, 0x00, 0x04, 0xec, 0x1f, 0x24, 0x00, 0x04, 0xec,
+	0x1f, 0x25, 0x00, 0x04, 0xec, 0x1f, 0x26, 0x00, 0x04, 0xec, 0x1f, 0x27,
+	0x00, 0x04, 0xec, 0x1f, 0x28, 0x00, 0x04, 0xec, 0x1f, 0x29, 0x00, 0x04,
+	0xec, 0x1f, 0x2a, 0x00, 0x04, 0xec, 0x1f, 0x2b, 0x00, 0x04, 0xec, 0x1f,
+	0x2c, 0x00, 0x04, 0xec, 0x1f, 0x2d, 0x00, 0x04, 0xec, 0x1f, 0x2e, 0x00,
+	0x04, 0xec, 0x1f, 0x2f, 0x00, 0x04, 0xec, 0x1f, 0x30, 0x00, 0x04, 0xec,
+	0x1f, 0x31, 0x00, 0x04, 0xec, 0x1f, 0x32, 0x00, 0x04, 0xec, 0x1f, 0x33,
+	0x00, 0x04, 0xec, 0x1f, 0x34, 0x00, 0x04, 0xec, 0x1f, 0x35, 0x00, 0x04,
+	0xec, 0x1f, 0x36, 0x00, 0x04, 0xec, 0x1f, 0x37, 0x00, 0x04, 0xec, 0x1f,
+	0x38, 0x00, 0x04, 0xec, 0x1f, 0x39, 0x00, 0x04, 0xec, 0x1f, 0x3a, 0x00,
+	0x04, 0xec, 0x1f, 0x3b, 0x00, 0x04, 0xec, 0x1f, 0x3c, 0x00, 0x04, 0xec,
+	0x1f, 0x3d, 0x00, 0x04, 0xec, 0x1f, 0x3e, 0x00, 0x04, 0xec, 0x1f, 0x3f,
+	0x00, 0x04, 0xec, 0x1f, 0x40, 0x00, 0x04, 0xec, 0x1f, 0x41, 0x00, 0x04,
+	0xec, 0x1f, 0x42, 0x00, 0x04, 0xec, 0x1f, 0x43, 0x00, 0x04, 0xec, 0x1f,
+	0x44, 0x00, 0x04, 0xec, 0x1f, 0x45, 0x00, 0x04, 0xec, 0x1f, 0x46, 0x00,
+	0x04, 0xec, 0x1f, 0x47, 0x00, 0x04, 0xec, 0x1f, 0x48, 0x00, 0x04, 0xec,
+	0x1f, 0x49, 0x00, 0x04, 0xec, 0x1f, 0x4a, 0x00, 0x04, 0xec, 0x1f, 0x4b,
+	0x00, 0x04, 0xec, 0x1f, 0x4c, 0x00, 0x04, 0xec, 0x1f, 0x4d, 0x00, 0x04,
+	0xec, 0x1f, 0x4e, 0x00, 0x04, 0xec, 0x1f, 0x4f, 0x00, 0x04, 0xec, 0x1f,
+	0x50, 0x00, 0x04, 0xec, 0x1f, 0x51, 0x00, 0x04, 0xec, 0x1f, 0x52, 0x00,
+	0x04, 0xec, 0x1f, 0x53, 0x00, 0x04, 0xec, 0x1f, 0x54, 0x00, 0x04, 0xec,
+	0x1f, 0x55, 0x00, 0x04, 0xec, 0x1f, 0x56, 0x00, 0x04, 0xec, 0x1f, 0x57,
+	0x00, 0x04, 0xec, 0x1f, 0x58, 0x00, 0x04, 0xec, 0x1f, 0x59, 0x00, 0x04,
+	0xec, 0x1f, 0x5a, 0x00, 0x04, 0xec, 0x1f, 0x5b, 0x00, 0x04, 0xec, 0x1f,
+	0x5c, 0x00, 0x04, 0xec, 0x1f, 0x5d, 0x00, 0x04, 0xec, 0x1f, 0x5e, 0x00,
+	0x04, 0xec, 0x1f, 0x5f, 0x00, 0x04, 0xec, 0x1f, 0x60, 0x00, 0x04, 0xec,
+	0x1f, 0x61, 0x00, 0x04, 0xec, 0x1f, 0x62, 0x00, 0x04, 0xec, 0x1f, 0x63,
+	0x00, 0x04, 0xec, 0x1f, 0x64, 0x00, 0x04, 0xec, 0x1f, 0x65, 0x00, 0x04,
+	0xec, 0x1f, 0x66, 0x00, 0x04, 0xec, 0x1f, 0x67, 0x00, 0x04, 0xec, 0x1f,
+	0x68, 0x00, 0x04, 0xec, 0x1f, 0x69, 0x00, 0x04, 0xec, 0x1f, 0x6a, 0x00,
+	0x04, 0xec, 0x1f, 0x6b, 0x00, 0x04, 0xec, 0x1f, 0x6c, 0x00, 0x04, 0xec,
+	0x1f, 0x6d, 0x00, 0x04, 0xec, 0x1f, 0x6e, 0x00, 0x04, 0xec, 0x1f, 0x6f,
+	0x00, 0x04, 0xec, 0x1f, 0x70, 0x00, 0x04, 0xec, 0x1f, 0x71, 0x00, 0x04,
+	0xec, 0x1f, 0x72, 0x00, 0x04, 0xec, 0x1f, 0x73, 0x00, 0x04, 0xec, 0x1f,
+	0x74, 0x00, 0x04, 0xec, 0x1f, 0x75, 0x00, 0x04, 0xec, 0x1f, 0x76, 0x00,
+	0x04, 0xec, 0x1f, 0x77, 0x00, 0x04, 0xec, 0x1f, 0x78, 0x00, 0x04, 0xec,
+	0x1f, 0x79, 0x00, 0x04, 0xec, 0x1f, 0x7a, 0x00, 0x04, 0xec, 0x1f, 0x7b,
+	0x00, 0x04, 0xec, 0x1f, 0x7c, 0x00, 0x04, 0xec, 0x1f, 0x7d, 0x00, 0x04,
+	0xec, 0x1f, 0x7e, 0x00, 0x04, 0xec, 0x1f, 0x7f, 0x00, 0x04, 0xec, 0x1f,
+	0x80, 0x00, 0x04, 0xec, 0x1f, 0x81, 0x00, 0x04, 0xec, 0x1f, 0x82, 0x00,
+	0x04, 0xec, 0x1f, 0x83, 0x00, 0x04, 0xec, 0x1f, 0x84, 0x00, 0x04, 0xec,
+	0x1f, 0x85, 0x00, 0x04, 0xec, 0x1f, 0x86, 0x00, 0x04, 0xec, 0x1f, 0x87,
+	0x00, 0x04, 0xec, 0x1f, 0x88, 0x00, 0x04, 0xec, 0x1f, 0x89, 0x00, 0x04,
+	0xec, 0x1f, 0x8a, 0x00, 0x04, 0xec, 0x1f, 0x8b, 0x00, 0x04, 0xec, 0x1f,
+	0x8c, 0x00, 0x04, 0xec, 0x1f, 0x8d, 0x00, 0x04, 0xec, 0x1f, 0x8e, 0x00,
+	0x04, 0xec, 0x1f, 0x8f, 0x00, 0x04, 0xec, 0x1f, 0x90, 0x00, 0x04, 0xec,
+	0x1f, 0x91, 0x00, 0x04, 0xec, 0x1f, 0x92, 0x00, 0x04, 0xec, 0x1f, 0x93,
+	0x00, 0x04, 0xec, 0x1f, 0x94, 0x00, 0x04, 0xec, 0x1f, 0x95, 0x00, 0x04,
+	0xec, 0x1f, 0x96, 0x00, 0x04, 0xec, 0x1f, 0x97, 0x00, 0x04, 0xec, 0x1f,
+	0x98, 0x00, 0x04, 0xec, 0x1f, 0x99, 0x00, 0x04, 0xec, 0x1f, 0x9a, 0x00,
+	0x04, 0xec, 0x1f, 0x9b, 0x00, 0x04, 0xec, 0x1f, 0x9c, 0x00, 0x04, 0xec,
+	0x1f, 0x9d, 0x00, 0x04, 0xec, 0x1f, 0x9e, 0x00, 0x04, 0xec, 0x1f, 0x9f,
+	0x00, 0x04, 0xec, 0x1f, 0xa0, 0x00, 0x04, 0xec, 0x1f, 0xa1, 0x00, 0x04,
+	0xec, 0x1f, 0xa2, 0x00, 0x04, 0xec, 0x1f, 0xa3, 0x00, 0x04, 0xec, 0x1f,
+	0xa4, 0x00, 0x04, 0xec, 0x1f, 0xa5, 0x00, 0x04, 0xec, 0x1f, 0xa6, 0x00,
+	0x04, 0xec, 0x1f, 0xa7, 0x00, 0x04, 0xec, 0x1f, 0xa8, 0x00, 0x04, 0xec,
+	0x1f, 0xa9, 0x00, 0x04, 0xec, 0x1f, 0xaa, 0x00, 0x04, 0xec, 0x1f, 0xab,
+	0x00, 0x04, 0xec, 0x1f, 0xac, 0x00, 0x04, 0xec, 0x1f, 0xad, 0x00, 0x04,
+	0xec, 0x1f, 0xae, 0x00, 0x04, 0xec, 0x1f, 0xaf, 0x00, 0x04, 0xec, 0x1f,
+	0xb0, 0x00, 0x04, 0xec, 0x1f, 0xb1, 0x00, 0x04, 0xec, 0x1f, 0xb2, 0x00,
+	0x04, 0xec, 0x1f, 0xb3, 0x00, 0x04, 0xec, 0x1f, 0xb4, 0x00, 0x04, 0xec,
+	0x1f, 0xb5, 0x00, 0x04, 0xec, 0x1f, 0xb6, 0x00, 0x04, 0xec, 0x1f, 0xb7,
+	0x00, 0x04, 0xec, 0x1f, 0xb8, 0x00, 0x04, 0xec, 0x1f, 0xb9, 0x00, 0x04,
+	0xec, 0x1f, 0xba, 0x00, 0x04, 0xec, 0x1f, 0xbb, 0x00, 0x04, 0xec, 0x1f,
+	0xbc, 0x00, 0x04, 0xec, 0x1f, 0xbd, 0x00, 0x04, 0xec, 0x1f, 0xbe, 0x00,
+	0x04, 0xec, 0x1f, 0xbf, 0x00, 0x04, 0xec, 0x1f, 0xc0, 0x00, 0x04, 0xec,
+	0x1f, 0xc1, 0x00, 0x04, 0xec, 0x1f, 0xc2, 0x00, 0x04, 0xec, 0x1f, 0xc3,
+	0x00, 0x04, 0xec, 0x1f, 0xc4, 0x00, 0x04, 0xec, 0x1f, 0xc5, 0x00, 0x04,
+	0xec, 0x1f, 0xc6, 0x00, 0x04, 0xec, 0x1f, 0xc7, 0x00, 0x04, 0xec, 0x1f,
+	0xc8, 0x00, 0x04, 0xec, 0x1f, 0xc9, 0x00, 0x04, 0xec, 0x1f, 0xca, 0x00,
+	0x04, 0xec, 0x1f, 0xcb, 0x00, 0x04, 0xec, 0x1f, 0xcc, 0x00, 0x04, 0xec,
+	0x1f, 0xcd, 0x00, 0x04, 0xec, 0x1f, 0xce, 0x00, 0x04, 0xec, 0x1f, 0xcf,
+	0x00, 0x04, 0xec, 0x1f, 0xd0, 0x00, 0x04, 0xec, 0x1f, 0xd1, 0x00, 0x04,
+	0xec, 0x1f, 0xd2, 0x00, 0x04, 0xec, 0x1f, 0xd3, 0x00, 0x04, 0xec, 0x1f,
+	0xd4, 0x00, 0x04, 0xec, 0x1f, 0xd5, 0x00, 0x04, 0xec, 0x1f, 0xd6, 0x00,
+	0x04, 0xec, 0x1f, 0xd7, 0x00, 0x04, 0xec, 0x1f, 0xd8, 0x00, 0x04, 0xec,
+	0x1f, 0xd9, 0x00, 0x04, 0xec, 0x1f, 0xda, 0x00, 0x04, 0xec, 0x1f, 0xdb,
+	0x00, 0x04, 0xec, 0x1f, 0xdc, 0x00, 0x04, 0xec, 0x1f, 0xdd, 0x00, 0x04,
+	0xec, 0x1f, 0xde, 0x00, 0x04, 0xec, 0x1f, 0xdf, 0x00, 0x04, 0xec, 0x1f,
+	0xe0, 0x00, 0x04, 0xec, 0x1f, 0xe1, 0x00, 0x04, 0xec, 0x1f, 0xe2, 0x00,
+	0x04, 0xec, 0x1f, 0xe3, 0x00, 0x04, 0xec, 0x1f, 0xe4, 0x00, 0x04, 0xec,
+	0x1f, 0xe5, 0x00, 0x04, 0xec, 0x1f, 0xe6, 0x00, 0x04, 0xec, 0x1f, 0xe7,
+	0x00, 0x04, 0xec, 0x1f, 0xe8, 0x00, 0x04, 0xec, 0x1f, 0xe9, 0x00, 0x04,
+	0xec, 0x1f, 0xea, 0x00, 0x04, 0xec, 0x1f, 0xeb, 0x00, 0x04, 0xec, 0x1f,
+	0xec, 0x00, 0x04, 0xec, 0x1f, 0xed, 0x00, 0x04, 0xec, 0x1f, 0xee, 0x00,
+	0x04, 0xec, 0x1f, 0xef, 0x00, 0x04, 0xec, 0x1f, 0xf0, 0x00, 0x04, 0xec,
+	0x1f, 0xf1, 0x00, 0x04, 0xec, 0x1f, 0xf2, 0x00, 0x04, 0xec, 0x1f, 0xf3,
+	0x00, 0x04, 0xec, 0x1f, 0xf4, 0x00, 0x04, 0xec, 0x1f, 0xf5, 0x00, 0x04,
+	0xec, 0x1f, 0xf6, 0x00, 0x04, 0xec, 0x1f, 0xf7, 0x00, 0x04, 0xec, 0x1f,
+	0xf8, 0x00, 0x04, 0xec, 0x1f, 0xf9, 0x00, 0x04, 0xec, 0x1f, 0xfa, 0x00,
+	0x04, 0xec, 0x1f, 0xfb, 0x00, 0x04, 0xec, 0x1f, 0xfc, 0x00, 0x04, 0xec,
+	0x1f, 0xfd, 0x00, 0x04, 0xec, 0x1f, 0xfe, 0x00, 0x04, 0xec, 0x1f, 0xff,
+	0x00, 0x04, 0xe7, 0x50, 0xd3, 0x88, 0xf5, 0x43, 0x0d, 0x67, 0x27, 0x28,
+	0xfc, 0xa2, 0x01, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x04, 0xec, 0x1f, 0x01,
+	0x00, 0x04, 0xec, 0x1f, 0x02, 0x00, 0x04, 0xec, 0x1f, 0x03, 0x00, 0x04,
+	0xec, 0x1f, 0x04, 0x00, 0x04, 0xec, 0x1f, 0x05, 0x00, 0x04, 0xec, 0x1f,
+	0x06, 0x00, 0x04, 0xec, 0x1f, 0x07, 0x00, 0x04, 0xec, 0x1f, 0x08, 0x00,
+	0x04, 0xec, 0x1f, 0x09, 0x00, 0x04, 0xec, 0x1f, 0x0a, 0x00, 0x04, 0xec,
+	0x1f, 0x0b, 0x00, 0x04, 0xec, 0xff, 0xf2, 0x0c, 0x7a, 0xa0, 0x7e, 0xe1,
+	0xea, 0xf2, 0x3d, 0xc7, 0x39, 0x6d, 0x0d, 0xa6, 0x78, 0x16, 0x80, 0x05,
+	0x12, 0x3a, 0xa7, 0x4e, 0xde, 0x9f, 0x78, 0x9c, 0x70, 0x63, 0x00, 0x0b,
+	0xe6, 0xc8, 0x25, 0x21, 0x3d, 0xad, 0x22, 0xbc, 0x70, 0xb3, 0x85, 0xda,
+	0x21, 0x23, 0x63, 0x36, 0x17, 0x7b, 0xc3, 0x79, 0xfd, 0x62, 0x6c, 0xf9,
+	0x66, 0x43, 0xf1, 0x1f, 0xbd, 0x61, 0x63, 0xbd, 0x7c, 0x99, 0x90, 0x67,
+	0xf3, 0xd1, 0x98, 0xf0, 0x8c, 0x88, 0xd3, 0x90, 0x34, 0x3f, 0x14, 0xd1,
+	0xaa, 0xff, 0x72, 0x48, 0x27, 0x35, 0xf9, 0xde, 0x34, 0x4e, 0xb0, 0x4a,
+	0x10, 0xd8, 0xd5, 0x83, 0x7e, 0x10, 0xa4, 0x57, 0x4d, 0xd7, 0x31, 0x39,
+	0x3c, 0x26, 0x9f, 0x56, 0x69, 0x48, 0x3b, 0x0d, 0x32, 0x34, 0xa7, 0x0c,
+	0x79, 0x3d, 0x1a, 0x24, 0x37, 0xbf, 0xc2, 0x8b, 0xd2, 0x16, 0x20, 0xcf,
+	0x84, 0x7c, 0xbe, 0xc6, 0xba, 0xbb, 0xf4, 0x77, 0x3f, 0x32, 0x89, 0xc9,
+	0xbb, 0xae, 0xed, 0x0b, 0x7d, 0x14, 0xa7, 0x1e, 0xe0, 0xed, 0x3c, 0x0f,
+	0x8f, 0x3e, 0xb7, 0x78, 0xb6, 0x7e, 0x23, 0x38, 0x04, 0x7c, 0x01, 0x4d,
+	0x4b, 0x54, 0x38, 0xbd, 0xcc, 0x3a, 0xf0, 0x63, 0x23, 0x20, 0xc6, 0x4b,
+	0x4b, 0xfb, 0xff, 0xbd, 0x42, 0x33, 0x75, 0x5f, 0xff, 0x20, 0xe5, 0x40,
+	0x6d, 0x89, 0x6f, 0xf6, 0x43, 0x77, 0xf8, 0xf4, 0x1f, 0x1e, 0x04, 0x87,
+	0xba, 0x00, 0xe4, 0x21, 0x6e, 0x90, 0xf1, 0x46, 0xfd, 0xfd, 0x02, 0x47,
+	0x05, 0x2a, 0x17, 0x9e, 0x5f, 0xd9, 0x80, 0x78, 0x69, 0x83, 0x0a, 0x73,
+	0x67, 0xd2, 0x82, 0x9c, 0x0b, 0x03, 0xe3, 0xc0, 0xf4, 0x9d, 0x33, 0x74,
+	0xf1, 0x9f, 0x58, 0x1a, 0x8e, 0x02, 0x27, 0x78, 0x51, 0xb6, 0xeb, 0x45,
+	0x10, 0x6d, 0x4a, 0xad, 0xfe, 0x90, 0x66, 0xc1, 0xe1, 0xe6, 0xbf, 0x0d,
+	0x00, 0x04, 0xec, 0x1f, 0x0e, 0x00, 0x04, 0xec, 0x1f, 0x0f, 0x00, 0x04,
+	0xec, 0x1f, 0x10, 0x00, 0x04, 0xec, 0x1f, 0x11, 0x00, 0x04, 0xec, 0x1f,
+	0x12, 0x00, 0x04, 0xec, 0x1f, 0x13, 0x00, 0x04, 0xec, 0x1f, 0x14, 0x00,
+	0x04, 0xec, 0x1f, 0x15, 0x00, 0x04, 0xec, 0x1f, 0x16, 0x00, 0x04, 0xec,
+	0x1f, 0x17, 0x00, 0x04, 0xec, 0x1f, 0x18, 0x00, 0x04, 0xec, 0x1f, 0x19,
+	0x00, 0x04, 0xec, 0x1f, 0x1a, 0x00, 0x04, 0xec, 0x1f, 0x1b, 0x00, 0x04,
+	0xec, 0x1f, 0x1c, 0x00, 0x04, 0xec, 0x1f, 0x1d, 0x00, 0x04, 0xec, 0x1f,
+	0x1e, 0x00, 0x04, 0xec, 0x1f, 0x1f, 0x00, 0x04, 0xe7, 0x50, 0xd3, 0x88,
+	0xf5, 0x43, 0x0d, 0x91, 0xc1, 0x99, 0x7e, 0x00, 0x00, 0x00, 0x00, 0x28,
+	0x45, 0xa9, 0x7c,
+};
+
+static const UINT8 frame_uncompressed[] = {
+	0x04, 0x22, 0x4d, 0x18, 0x6c, 0x40, 0x2c, 0x01, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x54, 0x2c, 0x01, 0x00, 0x80, 0xeb, 0x6f, 0x47, 0xc9, 0x27,
+	0x10, 0x9f, 0xf1, 0x05, 0x5d, 0x58, 0x4c, 0x9a, 0xdb, 0x36, 0xe3, 0x60,
+	0xeb, 0x2b, 0x5c, 0x82, 0x93, 0xde, 0xbb, 0xfe, 0x88, 0x82, 0x6a, 0x4e,
+	0x00, 0xcb, 0x8b, 0x71, 0xfd, 0xad, 0x44, 0x53, 0x25, 0xd2, 0xd7, 0x93,
+	0xbd, 0x76, 0x50, 0x06, 0x1c, 0xaf, 0x73, 0x14, 0x65, 0x04, 0x2a, 0xe7,
+	0x78, 0xb2, 0x33, 0x4c, 0x79, 0x0f, 0xdd, 0x51, 0x69, 0x79, 0x36, 0x16,
+	0x38, 0x2b, 0xcc, 0xdb, 0xac, 0xec, 0xa3, 0x4b, 0x26, 0xd7, 0xc5, 0xa0,
+	0x42, 0xbc, 0x45, 0x38, 0x05, 0x4f, 0x62, 0xe8, 0x3e, 0x7e, 0xd3, 0x94,
+	0xc0, 0x66, 0xec, 0x42, 0xa7, 0xb6, 0xd7, 0xdb, 0xb4, 0x81, 0xef, 0xa4,
+	0xc0, 0xd2, 0x05, 0xf0, 0xb2, 0xb1, 0xd1, 0xf2, 0x7f, 0xb4, 0x5b, 0x59,
+	0x64, 0x04, 0x96, 0x12, 0x0b, 0xa8, 0x6d, 0x1e, 0x3a, 0xa3, 0xc4, 0xce,
+	0x6f, 0x6e, 0x91, 0xbb, 0x21, 0xd7, 0x0d, 0x12, 0x63, 0x4c, 0x0d, 0x19,
+	0x36, 0xc0, 0xdb, 0x90, 0xf9, 0xbb, 0x1d, 0xbe, 0x67, 0x79, 0xbd, 0x09,
+	0x10, 0xbf, 0x32, 0x54, 0xa1, 0x2e, 0x70, 0xe7, 0x63, 0x18, 0xbd, 0xdd,
+	0x2d, 0xe5, 0x75, 0x87, 0xe1, 0x41, 0xa9, 0x33, 0xf6, 0x67, 0xc6, 0x91,
+	0xdc, 0xd9, 0xc5, 0xde, 0xac, 0x56, 0x8e, 0x18, 0xc0, 0x4e, 0xd9, 0x93,
+	0x56, 0xd4, 0xc4, 0xf0, 0x38, 0x14, 0xd8, 0xda, 0xb6, 0xa3, 0x34, 0x76,
+	0xee, 0xc1, 0x00, 0x5f, 0xe3, 0x32, 0x2e, 0x8f, 0x2b, 0xf3, 0x37, 0xb3,
+	0x6d, 0x00, 0x3b, 0xf0, 0x1d, 0x5e, 0x3b, 0xab, 0x39, 0xc8, 0x06, 0x90,
+	0x76, 0x14, 0xa4, 0x87, 0x88, 0xbf, 0x16, 0xbe, 0xc7, 0xf3, 0x17, 0xb5,
+	0x78, 0x78, 0x93, 0x95, 0xd8, 0xdc, 0xfb, 0x3c, 0x9e, 0x29, 0x8d, 0x09,
+	0xf6, 0x22, 0x4d, 0x0d, 0xfa, 0x6d, 0x66, 0x5e, 0x39, 0x0d, 0xdd, 0xee,
+	0x59, 0x26, 0xd1, 0xd4, 0xf9, 0xd3, 0x85, 0x0e, 0x8b, 0xef, 0xca, 0x1f,
+	0x0e, 0x62, 0xa0, 0xb7, 0x84, 0x5f, 0x23, 0x80, 0xa4, 0xa9, 0x0f, 0xb0,
+	0xdc, 0xce, 0xeb, 0x5b, 0x40, 0xa2, 0x89, 0xa8, 0xd5, 0x70, 0xac, 0x27,
+	0xf6, 0x0e, 0x23, 0xac, 0x57, 0xcc, 0x44, 0x00, 0x00, 0x00, 0x00, 0x5a,
+	0xdc, 0xce, 0xdb,
+};
+
+static const UINT8 frame_skippable[] = {
+	0x5a, 0x2a, 0x4d, 0x18, 0x06, 0x00, 0x00, 0x00, 0x72, 0x65, 0x73, 0x65,
+	0x6e, 0x64,
+};
+
+#endif	/* _LZ4_FRAMES_H_ */
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Decodes the LZ4 frames of lz4_frames.h, made by the lz4 command line
+ * tool, through common/lz4: linked and independent blocks, block and
+ * content checksums, uncompressed blocks, skippable frames and frames
+ * concatenated in one stream. Each stream is fed whole, one byte at a
+ * time and split in two at every offset. Corrupted checksums and
+ * truncated streams must be reported.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <efi.h>
+#include <efilib.h>
+#include <lz4.h>
+#include "lz4_frames.h"
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define CONTENT_SIZE	(72 * 1024)
+#define RANDOM_SIZE	300
+#define BLOCK_MAX	(64 * 1024)
+#define STREAM_MAX	(16 * 1024)
+#define OUTPUT_MAX	(4 * CONTENT_SIZE)
+
+static UINT8 content[CONTENT_SIZE], random_data[RANDOM_SIZE];
+
+static const struct {
+	const char *name;
+	const UINT8 *frame;
+	UINTN size;
+	const UINT8 *content;
+	UINTN content_size;
+} frames[] = {
+	{ "linked", frame_linked, sizeof(frame_linked), content, CONTENT_SIZE },
+	{ "independent", frame_independent, sizeof(frame_independent), content, CONTENT_SIZE },
+	{ "linked with checksums", frame_linked_checksums, sizeof(frame_linked_checksums),
+	  content, CONTENT_SIZE },
+	{ "uncompressed", frame_uncompressed, sizeof(frame_uncompressed), random_data,
+	  RANDOM_SIZE },
+	{ "skippable", frame_skippable, sizeof(frame_skippable), NULL, 0 },
+};
+
+/* Concatenated stream: frames in this order */
+static const UINTN concat[] = { 4, 0, 3, 1, 4, 2 };
+
+static struct {
+	UINT8 buf[OUTPUT_MAX];
+	UINTN len;
+	UINTN calls;
+	BOOLEAN overflow;
+} output;
+
+static UINT8 stream[STREAM_MAX], expected[OUTPUT_MAX], corrupt[STREAM_MAX];
+static unsigned int failures;
+
+#define fail(fmt, ...) do {						\
+		fprintf(stderr, "FAIL %s: " fmt "\n", name, __VA_ARGS__); \
+		failures++;						\
+	} while (0)
+
+static UINT32 xorshift32(UINT32 *x)
+{
+	*x ^= *x << 13;
+	*x ^= *x >> 17;
+	*x ^= *x << 5;
+	return *x;
+}
+
+/* A random 1KB pattern repeated, every 256th byte a counter; then
+ * random bytes from the same sequence */
+static void gen_content(void)
+{
+	UINT32 x = 2463534242U;
+	UINT8 base[1024];
+	UINTN i;
+
+	for (i = 0; i < sizeof(base); i++)
+		base[i] = xorshift32(&x);
+	for (i = 0; i < CONTENT_SIZE; i++)
+		content[i] = i % 256 ? base[i % sizeof(base)] : i >> 8;
+	for (i = 0; i < RANDOM_SIZE; i++)
+		random_data[i] = xorshift32(&x);
+}
+
+static EFI_STATUS output_block(VOID *ctx, VOID *data, UINTN size)
+{
+	output.calls++;
+	if (size > BLOCK_MAX || size > OUTPUT_MAX - output.len) {
+		output.overflow = TRUE;
+		return EFI_BUFFER_TOO_SMALL;
+	}
+	memcpy(output.buf + output.len, data, size);
+	output.len += size;
+	return EFI_SUCCESS;
+}
+
+/* Decode @size bytes of @data, fed in slices of @slice bytes after a
+ * first one of @first bytes */
+static EFI_STATUS decode(const UINT8 *data, UINTN size, UINTN first, UINTN slice)
+{
+	struct lz4_stream ls;
+	EFI_STATUS ret;
+	UINTN len;
+
+	output.len = output.calls = 0;
+	output.overflow = FALSE;
+
+	lz4_stream_init(&ls, output_block, NULL);
+	len = first;
+	ret = EFI_SUCCESS;
+	while (size && !EFI_ERROR(ret)) {
+		if (len > size)
+			len = size;
+		ret = lz4_stream_write(&ls, data, len);
+		data += len;
+		size -= len;
+		len = slice;
+	}
+	if (!EFI_ERROR(ret))
+		ret = lz4_stream_end(&ls);
+	lz4_stream_free(&ls);
+	return ret;
+}
+
+static void check_decode(const char *name, const UINT8 *data, UINTN size,
+			 const UINT8 *exp, UINTN exp_size)
+{
+	EFI_STATUS ret;
+	UINTN split;
+
+	ret = decode(data, size, size, size);
+	if (EFI_ERROR(ret) || output.len != exp_size || memcmp(output.buf, exp, exp_size))
+		fail("whole stream: status %lx, %lu bytes, expected %lu", (unsigned long)ret,
+		     output.len, exp_size);
+
+	ret = decode(data, size, 1, 1);
+	if (EFI_ERROR(ret) || output.len != exp_size || memcmp(output.buf, exp, exp_size))
+		fail("one byte at a time: status %lx, %lu bytes", (unsigned long)ret,
+		     output.len);
+
+	for (split = 1; split < size; split++) {
+		ret = decode(data, size, split, size);
+		if (EFI_ERROR(ret) || output.len != exp_size ||
+		    memcmp(output.buf, exp, exp_size)) {
+			fail("split at %lu: status %lx, %lu bytes", split, (unsigned long)ret,
+			     output.len);
+			return;
+		}
+	}
+}
+
+static void check_frames(void)
+{
+	UINTN i;
+
+	/* the skippable frame only goes in the concatenated stream */
+	for (i = 0; i < ARRAY_SIZE(frames) - 1; i++) {
+		const char *name = frames[i].name;
+
+		if (!is_lz4_frame(frames[i].frame, frames[i].size))
+			fail("%s", "not taken for an LZ4 frame");
+		check_decode(name, frames[i].frame, frames[i].size, frames[i].content,
+			     frames[i].content_size);
+	}
+}
+
+static void check_concatenated(void)
+{
+	const char *name = "concatenated";
+	UINTN i, size = 0, exp_size = 0;
+
+	for (i = 0; i < ARRAY_SIZE(concat); i++) {
+		memcpy(stream + size, frames[concat[i]].frame, frames[concat[i]].size);
+		size += frames[concat[i]].size;
+		if (frames[concat[i]].content_size)
+			memcpy(expected + exp_size, frames[concat[i]].content,
+			       frames[concat[i]].content_size);
+		exp_size += frames[concat[i]].content_size;
+	}
+	check_decode(name, stream, size, expected, exp_size);
+
+	/* a skippable frame alone is no image */
+	if (decode(frame_skippable, sizeof(frame_skippable), 64, 64) != EFI_INVALID_PARAMETER)
+		fail("%s", "skippable frame alone accepted");
+}
+
+/* Flip a bit of byte @at of frame @f: decoding must fail with @status */
+static void check_corrupt(const char *name, UINTN f, UINTN at, EFI_STATUS status)
+{
+	EFI_STATUS ret;
+
+	memcpy(corrupt, frames[f].frame, frames[f].size);
+	corrupt[at] ^= 0x10;
+	ret = decode(corrupt, frames[f].size, frames[f].size, frames[f].size);
+	if (ret != status)
+		fail("status %lx, expected %lx", (unsigned long)ret, (unsigned long)status);
+}
+
+static void check_errors(void)
+{
+	const char *name = "truncated";
+	UINT32 block_size;
+	UINTN i, f;
+
+	/* FLG BD HC, then the first block size */
+	check_corrupt("header checksum", 1, 6, EFI_CRC_ERROR);
+	memcpy(&block_size, frame_independent + 7, sizeof(block_size));
+	block_size &= ~0x80000000U;
+	check_corrupt("block checksum", 1, 11 + block_size, EFI_CRC_ERROR);
+	check_corrupt("content checksum", 1, sizeof(frame_independent) - 1, EFI_CRC_ERROR);
+	/* the content checksum catches what the block decoder cannot */
+	check_corrupt("uncompressed data", 3, 20, EFI_CRC_ERROR);
+
+	for (f = 0; f < ARRAY_SIZE(frames); f++)
+		for (i = 0; i < frames[f].size; i++)
+			if (!EFI_ERROR(decode(frames[f].frame, i, i, i))) {
+				fail("%s cut at %lu accepted", frames[f].name, i);
+				break;
+			}
+}
+
+int main(void)
+{
+	gen_content();
+
+	check_frames();
+	check_concatenated();
+	check_errors();
+
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+	return failures ? 1 : 0;
+}
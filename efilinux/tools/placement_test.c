@@ -0,0 +1,443 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Drives placement_plan() the way bootimg.c plans a boot: kernel,
+ * ramdisk, boot parameters, command line and GDT, over memory maps
+ * shaped like the firmware ones (unsorted entries, adjacent ranges to
+ * merge, descriptors larger than the structure) and a fragmented one.
+ * Every plan is checked for alignment, bounds, overlaps, memory type
+ * and free memory accounting, and the arena must be left as it was.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <efi.h>
+#include <efilib.h>
+#include <arena.h>
+#include <placement.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define KB (1024ULL)
+#define MB (1024 * KB)
+
+/* What firmwares report, larger than EFI_MEMORY_DESCRIPTOR */
+#define DESC_SIZE 48
+#define MAX_REGIONS 160
+
+/* As in bootimg.c */
+#define LOW_MEMORY_END	(1 << 20)
+#define BOOT_PARAMS_MAX	0x3fffffff
+#define CMDLINE_MAX	0xA0000
+
+enum { KERNEL, RAMDISK, BOOT_PARAMS, CMDLINE, GDT, COUNT };
+
+static const char *names[COUNT] = { "kernel", "ramdisk", "boot params", "cmdline", "gdt" };
+
+struct region {
+	UINT32 type;
+	EFI_PHYSICAL_ADDRESS start;
+	UINT64 size;
+};
+
+/* 2GB tablet, in firmware order: not quite sorted, some conventional
+ * ranges split in adjacent descriptors */
+static const struct region tablet[] = {
+	{ EfiBootServicesCode, 0x0, 0x1000 },
+	{ EfiConventionalMemory, 0x1000, 0x9E000 },
+	{ EfiReservedMemoryType, 0x9F000, 0x61000 },
+	{ EfiLoaderCode, 0x100000, 0x100000 },
+	{ EfiConventionalMemory, 0x200000, 0xE00000 },
+	{ EfiConventionalMemory, 0x1000000, 0x1F000000 },
+	{ EfiLoaderData, 0x20000000, 0x800000 },
+	{ EfiConventionalMemory, 0x3A000000, 0x3F000000 },
+	{ EfiConventionalMemory, 0x20800000, 0x17800000 },
+	{ EfiBootServicesData, 0x38000000, 0x2000000 },
+	{ EfiACPIReclaimMemory, 0x79000000, 0x100000 },
+	{ EfiRuntimeServicesData, 0x79100000, 0x6F00000 },
+	{ EfiMemoryMappedIO, 0xE0000000, 0x10000000 },
+};
+
+struct map {
+	UINT8 buf[MAX_REGIONS * DESC_SIZE];
+	UINTN size;
+	UINTN desc_size;
+	struct region regions[MAX_REGIONS];
+	UINTN count;
+};
+
+static unsigned int failures;
+static const char *test_name;
+
+#define fail(fmt, ...) do {						\
+		fprintf(stderr, "FAIL %s: " fmt "\n", test_name, __VA_ARGS__); \
+		failures++;						\
+	} while (0)
+
+static void map_add(struct map *map, UINT32 type, EFI_PHYSICAL_ADDRESS start, UINT64 size)
+{
+	EFI_MEMORY_DESCRIPTOR *d;
+
+	d = (EFI_MEMORY_DESCRIPTOR *)(map->buf + map->count * map->desc_size);
+	memset(d, 0xEE, map->desc_size);
+	d->Type = type;
+	d->PhysicalStart = start;
+	d->VirtualStart = 0;
+	d->NumberOfPages = size >> EFI_PAGE_SHIFT;
+	d->Attribute = 0;
+
+	map->regions[map->count].type = type;
+	map->regions[map->count].start = start;
+	map->regions[map->count].size = size;
+	map->count++;
+	map->size = map->count * map->desc_size;
+}
+
+static void map_init(struct map *map, const struct region *regions, UINTN count,
+		     UINTN desc_size)
+{
+	UINTN i;
+
+	map->count = 0;
+	map->desc_size = desc_size;
+	for (i = 0; i < count; i++)
+		map_add(map, regions[i].type, regions[i].start, regions[i].size);
+}
+
+/* 1MB ranges separated by one page of boot services data, above a 64MB
+ * range and the low memory */
+static void map_fragmented(struct map *map)
+{
+	EFI_PHYSICAL_ADDRESS addr = 16 * MB;
+	UINTN i;
+
+	map->count = 0;
+	map->desc_size = DESC_SIZE;
+	map_add(map, EfiConventionalMemory, 0x1000, 0x9E000);
+	for (i = 0; i < 64; i++) {
+		map_add(map, EfiConventionalMemory, addr, MB - EFI_PAGE_SIZE);
+		map_add(map, EfiBootServicesData, addr + MB - EFI_PAGE_SIZE, EFI_PAGE_SIZE);
+		addr += MB;
+	}
+	map_add(map, EfiConventionalMemory, 256 * MB, 64 * MB);
+}
+
+static UINT64 conventional_size(struct map *map)
+{
+	UINT64 size = 0;
+	UINTN i;
+
+	for (i = 0; i < map->count; i++)
+		if (map->regions[i].type == EfiConventionalMemory)
+			size += map->regions[i].size;
+	return size;
+}
+
+/* [start, end) is entirely conventional memory */
+static BOOLEAN is_free(struct map *map, EFI_PHYSICAL_ADDRESS start, EFI_PHYSICAL_ADDRESS end)
+{
+	UINTN i;
+
+	while (start < end) {
+		for (i = 0; i < map->count; i++) {
+			struct region *r = &map->regions[i];
+
+			if (r->type == EfiConventionalMemory &&
+			    r->start <= start && start < r->start + r->size)
+				break;
+		}
+		if (i == map->count)
+			return FALSE;
+		start = map->regions[i].start + map->regions[i].size;
+	}
+	return TRUE;
+}
+
+/* The payloads as plan_boot() describes them */
+static void boot_plan(struct placement *p, UINT64 kernel_size, UINT64 kernel_align,
+		      EFI_PHYSICAL_ADDRESS pref, BOOLEAN relocatable,
+		      UINT64 ramdisk_size, UINT64 initrd_addr_max)
+{
+	memset(p, 0, COUNT * sizeof(*p));
+
+	p[KERNEL].size = kernel_size;
+	p[KERNEL].align = kernel_align;
+	p[KERNEL].min = LOW_MEMORY_END;
+	p[KERNEL].max = (UINT64)-1;
+	p[KERNEL].pref = pref;
+	p[KERNEL].fixed = !relocatable;
+
+	p[RAMDISK].size = ramdisk_size;
+	p[RAMDISK].min = LOW_MEMORY_END;
+	p[RAMDISK].max = initrd_addr_max + 1;
+	p[RAMDISK].top_down = TRUE;
+
+	p[BOOT_PARAMS].size = 16 * KB;
+	p[BOOT_PARAMS].max = (UINT64)BOOT_PARAMS_MAX + 1;
+	p[BOOT_PARAMS].top_down = TRUE;
+
+	p[CMDLINE].size = 512 + 1024 + 100;
+	p[CMDLINE].min = EFI_PAGE_SIZE;
+	p[CMDLINE].max = CMDLINE_MAX;
+	p[CMDLINE].top_down = TRUE;
+
+	p[GDT].size = 0x30;
+	p[GDT].min = LOW_MEMORY_END;
+	p[GDT].max = (UINT64)-1;
+}
+
+/* Run the plan and check what holds for any plan */
+static EFI_STATUS plan(struct arena *arena, struct map *map, struct placement *p,
+		       struct placement_stats *stats)
+{
+	struct arena_mark mark = arena_save(arena);
+	UINT64 placed = 0;
+	EFI_STATUS ret;
+	UINTN i, j;
+
+	ret = placement_plan(arena, (EFI_MEMORY_DESCRIPTOR *)map->buf, map->size,
+			     map->desc_size, p, COUNT, stats);
+
+	if (arena->used != mark.used || arena->chunks != mark.chunks)
+		fail("%s", "arena not restored");
+
+	for (i = 0; i < COUNT; i++) {
+		if (!p[i].addr) {
+			if (ret == EFI_SUCCESS && p[i].size)
+				fail("%s not placed but success returned", names[i]);
+			continue;
+		}
+		if (p[i].size % EFI_PAGE_SIZE || p[i].align < EFI_PAGE_SIZE)
+			fail("%s size 0x%llx align 0x%llx not in pages", names[i],
+			     (unsigned long long)p[i].size, (unsigned long long)p[i].align);
+		if (p[i].addr & (p[i].align - 1) && p[i].addr != p[i].pref)
+			fail("%s at 0x%llx not aligned", names[i], (unsigned long long)p[i].addr);
+		if (p[i].addr < p[i].min || p[i].addr + p[i].size > p[i].max)
+			fail("%s at 0x%llx out of bounds", names[i], (unsigned long long)p[i].addr);
+		if (!is_free(map, p[i].addr, p[i].addr + p[i].size))
+			fail("%s at 0x%llx not in conventional memory", names[i],
+			     (unsigned long long)p[i].addr);
+		for (j = 0; j < i; j++)
+			if (p[j].addr && p[j].addr < p[i].addr + p[i].size &&
+			    p[i].addr < p[j].addr + p[j].size)
+				fail("%s overlaps %s", names[i], names[j]);
+		placed += p[i].size;
+	}
+
+	if (stats && stats->free_size != conventional_size(map) - placed)
+		fail("0x%llx bytes left free, expected 0x%llx",
+		     (unsigned long long)stats->free_size,
+		     (unsigned long long)(conventional_size(map) - placed));
+	return ret;
+}
+
+static void expect(struct placement *p, UINTN item, EFI_PHYSICAL_ADDRESS addr)
+{
+	if (p[item].addr != addr)
+		fail("%s at 0x%llx, expected 0x%llx", names[item],
+		     (unsigned long long)p[item].addr, (unsigned long long)addr);
+}
+
+static void expect_status(EFI_STATUS ret, EFI_STATUS expected)
+{
+	if (ret != expected)
+		fail("status 0x%lx, expected 0x%lx", (unsigned long)ret, (unsigned long)expected);
+}
+
+static void test_relocatable(struct arena *arena)
+{
+	struct placement p[COUNT];
+	struct map map;
+
+	map_init(&map, tablet, ARRAY_SIZE(tablet), DESC_SIZE);
+
+	test_name = "relocatable kernel at its preferred address";
+	boot_plan(p, 24 * MB, 16 * MB, 16 * MB, TRUE, 16 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, KERNEL, 16 * MB);
+	expect(p, RAMDISK, 0x38000000 - 16 * MB);
+	expect(p, BOOT_PARAMS, 0x40000000 - 16 * KB);
+	expect(p, CMDLINE, 0x9F000 - EFI_PAGE_SIZE);
+	expect(p, GDT, 0x200000);
+
+	test_name = "relocatable kernel, preferred address taken";
+	boot_plan(p, 24 * MB, 16 * MB, 0x20000000, TRUE, 16 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, KERNEL, 16 * MB);
+
+	test_name = "relocatable kernel, preferred address across a hole";
+	boot_plan(p, 24 * MB, 2 * MB, 0x1F000000, TRUE, 16 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, KERNEL, 0x200000);
+}
+
+static void test_fixed(struct arena *arena)
+{
+	struct placement p[COUNT];
+	struct map map;
+
+	map_init(&map, tablet, ARRAY_SIZE(tablet), DESC_SIZE);
+
+	test_name = "fixed kernel";
+	boot_plan(p, 24 * MB, 16 * MB, 0x40000000, FALSE, 16 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, KERNEL, 0x40000000);
+
+	/* the others are placed anyway */
+	test_name = "fixed kernel, address taken";
+	boot_plan(p, 24 * MB, 16 * MB, 0x20000000, FALSE, 16 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_OUT_OF_RESOURCES);
+	expect(p, KERNEL, 0);
+	expect(p, RAMDISK, 0x38000000 - 16 * MB);
+	expect(p, GDT, 0x200000);
+}
+
+static void test_initrd_addr_max(struct arena *arena)
+{
+	struct placement p[COUNT];
+	struct map map;
+
+	map_init(&map, tablet, ARRAY_SIZE(tablet), DESC_SIZE);
+
+	/* only the range below the kernel's 472MB is large enough */
+	test_name = "large ramdisk below initrd_addr_max";
+	boot_plan(p, 24 * MB, 16 * MB, 16 * MB, TRUE, 400 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, RAMDISK, 0x20000000 - 400 * MB);
+
+	test_name = "ramdisk too large for initrd_addr_max";
+	boot_plan(p, 24 * MB, 16 * MB, 16 * MB, TRUE, 300 * MB, 0x0FFFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_OUT_OF_RESOURCES);
+	expect(p, RAMDISK, 0);
+	expect(p, KERNEL, 16 * MB);
+
+	test_name = "initrd_addr_max of a 64 bits kernel";
+	boot_plan(p, 24 * MB, 16 * MB, 16 * MB, TRUE, 16 * MB, 0x7FFFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, RAMDISK, 0x79000000 - 16 * MB);
+
+	test_name = "ramdisk ending at initrd_addr_max";
+	boot_plan(p, 24 * MB, 16 * MB, 16 * MB, TRUE, 16 * MB, 0x2FFFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, RAMDISK, 0x30000000 - 16 * MB);
+
+	test_name = "unaligned initrd_addr_max";
+	boot_plan(p, 24 * MB, 16 * MB, 16 * MB, TRUE, 10 * KB, 0x2FFFFFFE);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, RAMDISK, 0x30000000 - 4 * EFI_PAGE_SIZE);
+}
+
+static void test_fragmented(struct arena *arena)
+{
+	struct placement p[COUNT];
+	struct placement_stats stats;
+	struct map map;
+
+	map_fragmented(&map);
+
+	/* the kernel does not fit at its preferred address anymore */
+	test_name = "fragmented map";
+	boot_plan(p, 24 * MB, 2 * MB, 16 * MB, TRUE, 2 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, &stats), EFI_SUCCESS);
+	expect(p, KERNEL, 256 * MB);
+	expect(p, RAMDISK, 320 * MB - 2 * MB);
+	expect(p, BOOT_PARAMS, 320 * MB - 2 * MB - 16 * KB);
+	expect(p, GDT, 16 * MB);
+	if (stats.free_ranges != 1 + 64 + 1)
+		fail("%lu free ranges", (unsigned long)stats.free_ranges);
+	if (stats.largest != 64 * MB - 24 * MB - 2 * MB - 16 * KB)
+		fail("largest free range 0x%llx", (unsigned long long)stats.largest);
+	if (placement_fragmentation(&stats) != 100 - stats.largest * 100 / stats.free_size)
+		fail("%lu%% fragmented", (unsigned long)placement_fragmentation(&stats));
+
+	test_name = "fragmented map, fixed kernel across the holes";
+	boot_plan(p, 24 * MB, 2 * MB, 16 * MB, FALSE, 2 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, &stats), EFI_OUT_OF_RESOURCES);
+	expect(p, KERNEL, 0);
+
+	/* 1MB ranges minus a page: too small for 1MB aligned payloads */
+	test_name = "fragmented map, ramdisk below the large range";
+	boot_plan(p, 24 * MB, 2 * MB, 16 * MB, TRUE, 512 * KB, 0x0FFFFFFF);
+	expect_status(plan(arena, &map, p, &stats), EFI_SUCCESS);
+	expect(p, RAMDISK, 80 * MB - EFI_PAGE_SIZE - 512 * KB);
+}
+
+static void test_descriptor_size(struct arena *arena)
+{
+	struct placement p[COUNT];
+	struct map map;
+
+	test_name = "descriptors of the structure size";
+	map_init(&map, tablet, ARRAY_SIZE(tablet), sizeof(EFI_MEMORY_DESCRIPTOR));
+	boot_plan(p, 24 * MB, 16 * MB, 16 * MB, TRUE, 16 * MB, 0x37FFFFFF);
+	expect_status(plan(arena, &map, p, NULL), EFI_SUCCESS);
+	expect(p, KERNEL, 16 * MB);
+	expect(p, RAMDISK, 0x38000000 - 16 * MB);
+}
+
+static void run(struct arena *arena)
+{
+	test_relocatable(arena);
+	test_fixed(arena);
+	test_initrd_addr_max(arena);
+	test_fragmented(arena);
+	test_descriptor_size(arena);
+}
+
+int main(void)
+{
+	static UINT8 block[64 * KB] __attribute__((aligned(ARENA_ALIGN)));
+	struct arena arena;
+	UINTN i;
+
+	/* working memory from the arena block */
+	memset(&arena, 0, sizeof(arena));
+	arena.base = block;
+	arena.size = sizeof(block);
+	run(&arena);
+
+	/* an arena too small, falling back to the pool */
+	arena.size = 64;
+	run(&arena);
+	test_name = "pool fallback alignment";
+	for (i = 1; i < 100; i += 7)
+		if ((UINTN)arena_alloc(&arena, i) & (ARENA_ALIGN - 1))
+			fail("%lu bytes allocation not aligned", (unsigned long)i);
+	arena_reset(&arena);
+
+	/* nested in a scope of the caller */
+	arena.size = sizeof(block);
+	arena_alloc(&arena, 100);
+	run(&arena);
+	arena_reset(&arena);
+
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+	return failures ? 1 : 0;
+}
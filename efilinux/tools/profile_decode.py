@@ -0,0 +1,178 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2014, Intel Corporation
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions
+# are met:
+#
+#    * Redistributions of source code must retain the above copyright
+#      notice, this list of conditions and the following disclaimer.
+#    * Redistributions in binary form must reproduce the above copyright
+#      notice, this list of conditions and the following disclaimer
+#      in the documentation and/or other materials provided with the
+#      distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+# FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+# COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+# INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+# HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+# STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+# OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+
+"""Decode the efilinux function profiler trace.
+
+The trace is written by efilinux/profiling.c either to
+\\efilinux_profile.bin on the ESP or to the EfilinuxProfile EFI
+variable (efivarfs files are accepted as is). Function offsets are
+resolved against the unstripped efilinux ELF image the .efi was
+generated from.
+
+  profile_decode.py trace.bin efilinux.so            per function times
+  profile_decode.py -f trace.bin efilinux.so > out   folded stacks for
+                                                     flamegraph.pl
+"""
+
+import argparse
+import bisect
+import collections
+import struct
+import subprocess
+import sys
+
+MAGIC = 0x52504645
+VERSION = 1
+EXIT = 0x80000000
+
+HEADER = struct.Struct('<IHHQQIIQ')
+EVENT = struct.Struct('<QII')
+
+
+def read_trace(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    # efivarfs prepends the 4 bytes variable attributes
+    for skip in (0, 4):
+        if len(data) >= skip + HEADER.size and \
+           struct.unpack_from('<I', data, skip)[0] == MAGIC:
+            data = data[skip:]
+            break
+    else:
+        sys.exit('%s: not an efilinux profile trace' % path)
+
+    (magic, version, event_size, image_base, tsc_khz,
+     capacity, head, total) = HEADER.unpack_from(data)
+    if version != VERSION or event_size != EVENT.size:
+        sys.exit('%s: unsupported trace version %d' % (path, version))
+
+    events = [EVENT.unpack_from(data, HEADER.size + i * EVENT.size)
+              for i in range(capacity)]
+    events = events[head:] + events[:head]
+    if total > capacity:
+        sys.stderr.write('warning: ring wrapped, %d oldest events lost\n' %
+                         (total - capacity))
+    return tsc_khz, events
+
+
+class Symbols(object):
+    def __init__(self, image, nm):
+        out = subprocess.check_output([nm, '-n', '--defined-only', image])
+        self.addrs = []
+        self.names = []
+        for line in out.decode().splitlines():
+            fields = line.split()
+            if len(fields) != 3 or fields[1] not in 'tTwW':
+                continue
+            self.addrs.append(int(fields[0], 16))
+            self.names.append(fields[2])
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i < 0:
+            return '0x%x' % addr
+        if self.addrs[i] == addr:
+            return self.names[i]
+        return '%s+0x%x' % (self.names[i], addr - self.addrs[i])
+
+
+def replay(events, symbols):
+    """Walk the trace, yield (stack, ticks) for each interval and
+    collect inclusive/exclusive ticks and call counts per function."""
+    inclusive = collections.Counter()
+    exclusive = collections.Counter()
+    calls = collections.Counter()
+    stack = []          # [name, enter tsc, children ticks]
+    folded = collections.Counter()
+    last = None
+
+    for tsc, func, caller in events:
+        if last is not None and stack:
+            folded[';'.join(f[0] for f in stack)] += tsc - last
+        last = tsc
+
+        name = symbols.lookup(func & ~EXIT)
+        if not func & EXIT:
+            stack.append([name, tsc, 0])
+            calls[name] += 1
+            continue
+
+        # Unmatched exits happen when the ring wrapped, skip them
+        if not any(f[0] == name for f in stack):
+            continue
+        while stack:
+            frame_name, start, children = stack.pop()
+            elapsed = tsc - start
+            if frame_name not in (f[0] for f in stack):
+                inclusive[frame_name] += elapsed
+            exclusive[frame_name] += elapsed - children
+            if stack:
+                stack[-1][2] += elapsed
+            if frame_name == name:
+                break
+
+    return inclusive, exclusive, calls, folded
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('trace', help='profile dump from the target')
+    parser.add_argument('image', help='unstripped efilinux ELF image')
+    parser.add_argument('-f', '--folded', action='store_true',
+                        help='print folded stacks for flamegraph.pl')
+    parser.add_argument('-n', '--limit', type=int, default=50,
+                        help='number of functions to report')
+    parser.add_argument('--nm', default='nm', help='nm binary to use')
+    args = parser.parse_args()
+
+    tsc_khz, events = read_trace(args.trace)
+    symbols = Symbols(args.image, args.nm)
+    inclusive, exclusive, calls, folded = replay(events, symbols)
+
+    def us(ticks):
+        return ticks * 1000.0 / tsc_khz if tsc_khz else float(ticks)
+
+    if args.folded:
+        for stack, ticks in sorted(folded.items()):
+            print('%s %d' % (stack, round(us(ticks))))
+        return
+
+    unit = 'us' if tsc_khz else 'ticks'
+    print('%-40s %8s %14s %14s' % ('function', 'calls',
+                                   'incl (%s)' % unit, 'excl (%s)' % unit))
+    for name, ticks in exclusive.most_common(args.limit):
+        print('%-40s %8d %14.1f %14.1f' % (name, calls[name],
+                                           us(inclusive[name]), us(ticks)))
+
+
+if __name__ == '__main__':
+    main()
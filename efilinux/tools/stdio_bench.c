@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * snprintf() and the ASCII/UCS-2 conversions against the code they
+ * replaced: the format widened into a pool buffer, VSPrint() into a
+ * second pool buffer, the result narrowed back, with the character
+ * loops the conversions used to be.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <efi.h>
+#include <efilib.h>
+
+/* Built with the efi_ prefix, see the Makefile */
+int efi_snprintf(char *str, UINTN size, const char *format, ...);
+
+/* From uefi_utils.h, which clashes with the C library headers */
+EFI_STATUS str_to_stra(CHAR8 *dst, CHAR16 *src, UINTN len);
+EFI_STATUS stra_to_str_buf(CHAR16 *dst, UINTN size, CHAR8 *src);
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define ITERATIONS 200000
+#define MAX_LEN 4096
+
+static EFI_STATUS old_str_to_stra(CHAR8 *dst, CHAR16 *src, UINTN len)
+{
+	UINTN i;
+
+	for (i = 0; i < len; i++) {
+		if (src[i] > 0x7F)
+			return EFI_INVALID_PARAMETER;
+		dst[i] = (CHAR8)src[i];
+		if (!src[i])
+			break;
+	}
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS old_stra_to_str_buf(CHAR16 *dst, CHAR8 *src, UINTN len)
+{
+	UINTN i;
+
+	for (i = 0; i <= len; i++) {
+		if (src[i] > 0x7F)
+			return EFI_INVALID_PARAMETER;
+		dst[i] = (CHAR16)src[i];
+		if (!src[i])
+			break;
+	}
+	return EFI_SUCCESS;
+}
+
+static CHAR16 *old_stra_to_str(CHAR8 *src)
+{
+	UINTN len = strlena(src);
+	CHAR16 *dst;
+
+	dst = AllocatePool((len + 1) * sizeof(CHAR16));
+	if (dst && EFI_ERROR(old_stra_to_str_buf(dst, src, len))) {
+		FreePool(dst);
+		return NULL;
+	}
+	return dst;
+}
+
+static int old_snprintf(char *str, UINTN size, const char *format, ...)
+{
+	va_list args;
+	UINTN len;
+	int ret = -1;
+	CHAR16 *format16, *str16;
+
+	format16 = old_stra_to_str((CHAR8 *)format);
+	if (!format16)
+		return -1;
+
+	str16 = AllocatePool(size * sizeof(CHAR16));
+	if (!str16)
+		goto free_format16;
+
+	va_start(args, format);
+	len = VSPrint(str16, size * sizeof(CHAR16), format16, args);
+	va_end(args);
+
+	if (old_str_to_stra((CHAR8 *)str, str16, len) == EFI_SUCCESS) {
+		ret = 0;
+		str[len] = '\0';
+	}
+
+	FreePool(str16);
+free_format16:
+	FreePool(format16);
+	return ret;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+#define TIME(ns, call) do {						\
+		double start = now();					\
+		for (i = 0; i < ITERATIONS; i++) {			\
+			call;						\
+			asm volatile("" : : : "memory");		\
+		}							\
+		ns = (now() - start) * 1e9 / ITERATIONS;		\
+	} while (0)
+
+/* Formats as sent by fastboot */
+#define BENCH_FORMAT(...) do {						\
+		char old[64], new[64];					\
+		double old_ns, new_ns;					\
+									\
+		old_snprintf(old, sizeof(old), __VA_ARGS__);		\
+		efi_snprintf(new, sizeof(new), __VA_ARGS__);		\
+		if (strcmp(old, new))					\
+			printf("output differs: \"%s\" \"%s\"\n", old, new); \
+		TIME(old_ns, old_snprintf(old, sizeof(old), __VA_ARGS__)); \
+		TIME(new_ns, efi_snprintf(new, sizeof(new), __VA_ARGS__)); \
+		printf("%8.1f %8.1f %7.1fx  %s\n", old_ns, new_ns,	\
+		       old_ns / new_ns, #__VA_ARGS__);			\
+	} while (0)
+
+int main(void)
+{
+	static const UINTN lengths[] = { 4, 16, 64, 256, 1024, MAX_LEN };
+	static CHAR8 a[MAX_LEN + 1];
+	static CHAR16 w[MAX_LEN + 1];
+	double old_ns, new_ns;
+	UINTN i, l, len;
+
+	printf("snprintf, ns per call\n VSPrint   native  speedup  format\n");
+	BENCH_FORMAT("%a%a", "OKAY", "");
+	BENCH_FORMAT("%a%a", "INFO", "partition-type:system");
+	BENCH_FORMAT("DATA%08x", 0x10000000);
+	BENCH_FORMAT("0x%lX", (UINT64)0x40000000);
+	BENCH_FORMAT("partition-size:%s", L"system");
+	BENCH_FORMAT("Flash failure: %r", EFI_NOT_FOUND);
+	BENCH_FORMAT("%a:%d:%lx", "extent", 42, (UINT64)0x123456789);
+
+	printf("\nconversions, ns per character\n    loop     word  speedup  length\n");
+	for (i = 0; i < MAX_LEN; i++)
+		a[i] = 'a' + i % 26;
+
+	for (l = 0; l < ARRAY_SIZE(lengths); l++) {
+		len = lengths[l];
+		a[len] = 0;
+
+		TIME(old_ns, old_stra_to_str_buf(w, a, MAX_LEN));
+		TIME(new_ns, stra_to_str_buf(w, MAX_LEN + 1, a));
+		printf("%8.2f %8.2f %7.1fx  widen %lu\n",
+		       old_ns / len, new_ns / len, old_ns / new_ns, len);
+
+		TIME(old_ns, old_str_to_stra(a, w, MAX_LEN + 1));
+		TIME(new_ns, str_to_stra(a, w, MAX_LEN + 1));
+		printf("%8.2f %8.2f %7.1fx  narrow %lu\n",
+		       old_ns / len, new_ns / len, old_ns / new_ns, len);
+
+		a[len] = 'a' + len % 26;
+	}
+	return 0;
+}
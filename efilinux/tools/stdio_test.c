@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks the CHAR8 formatter of common/posix/stdio.c against the output
+ * of the gnu-efi VSPrint() path it replaced, for the formats used in
+ * the tree, and the ASCII/UCS-2 conversions of common/uefi_utils.c
+ * against plain character loops, including strings ending right before
+ * an unmapped page.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <efi.h>
+#include <efilib.h>
+
+/* Built with the efi_ prefix, see the Makefile */
+int efi_sprintf(char *str, const char *format, ...);
+int efi_snprintf(char *str, UINTN size, const char *format, ...);
+
+/* From uefi_utils.h, which clashes with the C library headers */
+EFI_STATUS str_to_stra(CHAR8 *dst, CHAR16 *src, UINTN len);
+EFI_STATUS stra_to_str_buf(CHAR16 *dst, UINTN size, CHAR8 *src);
+CHAR16 *stra_to_str(CHAR8 *src);
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+#define PAGE_SIZE 4096
+
+static unsigned int failures;
+
+#define fail(fmt, ...) do {					\
+		fprintf(stderr, "FAIL " fmt "\n", __VA_ARGS__);	\
+		failures++;					\
+	} while (0)
+
+/* Expected strings are the gnu-efi VSPrint() output */
+#define check_format(expected, ...) do {					\
+		char buf[128];							\
+		int ret = efi_snprintf(buf, sizeof(buf), __VA_ARGS__);		\
+		if (strcmp(buf, expected) || ret != (int)strlen(expected))	\
+			fail("%s: \"%s\" (%d), expected \"%s\"", #__VA_ARGS__,	\
+			     buf, ret, expected);				\
+	} while (0)
+
+static void check_formats(void)
+{
+	EFI_GUID guid = { 0x8be4df61, 0x93ca, 0x11d2, { 0xaa, 0x0d, 0x00, 0xe0, 0x98, 0x03, 0x2b, 0x8c } };
+	EFI_TIME time = { .Year = 2014, .Month = 7, .Day = 4, .Hour = 15, .Minute = 5 };
+	char buf[16];
+	int ret;
+
+	/* fastboot responses and variables */
+	check_format("OKAYhello", "%a%a", "OKAY", "hello");
+	check_format("DATA0000ABCD", "DATA%08x", 0xabcd);
+	check_format("0x0000000000400000", "0x%lX", (UINT64)0x400000);
+	check_format("0x0000ABCD", "0x%X", 0xabcd);
+	check_format("0x7F", "0x%lx", (UINT64)0x7f);
+	check_format("partition-size:boot", "partition-size:%s", L"boot");
+	check_format("Flash failure: Not Found", "Flash failure: %r", EFI_NOT_FOUND);
+
+	/* numbers */
+	check_format("-42 42 18446744073709551615", "%d %u %lu", -42, 42u, (UINT64)-1);
+	check_format("-9223372036854775808", "%ld", (INT64)1 << 63);
+	check_format("4294967295", "%u", 0xffffffffu);
+	check_format("1,234,567", "%,d", 1234567);
+	check_format("-1,000", "%,d", -1000);
+	check_format("0", "%x", 0);
+	check_format("FFFFFFFF", "%X", 0xffffffffu);
+
+	/* padding and precision */
+	check_format("   ab|ab   |000AB", "%5a|%-5a|%05x", "ab", "ab", 0xab);
+	check_format("hel", "%.3a", "hello");
+	check_format("   hi", "%*a", (UINTN)5, "hi");
+	check_format("  wide", "%6s", L"wide");
+
+	/* the others */
+	check_format("x%y", "x%%y");
+	check_format("(null)", "%a", (char *)NULL);
+	check_format("(null)", "%s", (CHAR16 *)NULL);
+	check_format("c=Z", "c=%c", 'Z');
+	check_format("8BE4DF61-93CA-11D2-AA0D-00E098032B8C", "%g", &guid);
+	check_format("07/04/14  03:05p", "%t", &time);
+
+	/* truncated to the buffer, the return value is what was written */
+	ret = efi_snprintf(buf, 4, "%a", "hello");
+	if (strcmp(buf, "hel") || ret != 3)
+		fail("truncation: \"%s\" (%d)", buf, ret);
+
+	/* only ASCII characters make it to a CHAR8 string */
+	if (efi_snprintf(buf, sizeof(buf), "%s", L"a\x0100") != -1)
+		fail("%s", "non ASCII %s accepted");
+
+	ret = efi_sprintf(buf, "%a-%d", "abc", 12);
+	if (strcmp(buf, "abc-12") || ret != 6)
+		fail("sprintf: \"%s\" (%d)", buf, ret);
+}
+
+static void check_conversions(UINT8 *page)
+{
+	CHAR8 a[128], back[128];
+	CHAR16 w[128], *p;
+	UINTN len, off, i;
+
+	for (len = 0; len < 64; len++) {
+		for (off = 0; off < 8; off++) {
+			CHAR8 *s = a + off;
+			CHAR16 *d = w + off;
+
+			for (i = 0; i < len; i++)
+				s[i] = 'A' + (i * 7 + off) % 58;
+			s[len] = 0;
+
+			memset(w, 0x55, sizeof(w));
+			if (stra_to_str_buf(d, 64, s))
+				fail("widen length %lu offset %lu", len, off);
+			for (i = 0; i <= len; i++)
+				if (d[i] != s[i])
+					break;
+			if (i <= len)
+				fail("widen length %lu offset %lu at %lu", len, off, i);
+			if (w[off + len + 1] != 0x5555)
+				fail("widen length %lu wrote past the NUL", len);
+
+			memset(back, 0x55, sizeof(back));
+			if (str_to_stra(back + off, d, 64) || strcmp((char *)back + off, (char *)s))
+				fail("narrow length %lu offset %lu", len, off);
+
+			if (stra_to_str_buf(d, len, s) != EFI_BUFFER_TOO_SMALL)
+				fail("widen into %lu characters", len);
+
+			for (i = 0; i < len; i++) {
+				s[i] = 0x80;
+				if (stra_to_str_buf(d, 64, s) != EFI_INVALID_PARAMETER)
+					fail("widen non ASCII at %lu of %lu", i, len);
+				s[i] = 'x';
+				stra_to_str_buf(d, 64, s);
+				d[i] = 0x100;
+				if (str_to_stra(back, d, 64) != EFI_INVALID_PARAMETER)
+					fail("narrow non ASCII at %lu of %lu", i, len);
+			}
+		}
+	}
+
+	p = stra_to_str((CHAR8 *)"hello world");
+	if (!p || p[10] != 'd' || p[11])
+		fail("%s", "stra_to_str");
+	FreePool(p);
+
+	/* strings ending at the end of the page, followed by an unmapped one */
+	for (len = 0; len < 32; len++) {
+		CHAR8 *s = (CHAR8 *)page + PAGE_SIZE - len - 1;
+		CHAR16 *ws = (CHAR16 *)(page + PAGE_SIZE) - len - 1;
+
+		memset(s, 'q', len);
+		s[len] = 0;
+		if (stra_to_str_buf(w, 64, s) || w[len] || (len && w[len - 1] != 'q'))
+			fail("widen at the page end, length %lu", len);
+
+		for (i = 0; i < len; i++)
+			ws[i] = 'r';
+		ws[len] = 0;
+		if (str_to_stra(back, ws, 64) || strlen((char *)back) != len)
+			fail("narrow at the page end, length %lu", len);
+	}
+}
+
+int main(void)
+{
+	UINT8 *map;
+
+	map = mmap(NULL, 2 * PAGE_SIZE, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED || mprotect(map + PAGE_SIZE, PAGE_SIZE, PROT_NONE)) {
+		perror("mmap");
+		return 1;
+	}
+
+	check_formats();
+	check_conversions(map);
+
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Copy and fill throughput of the common/posix/string.c variants from
+ * 16 bytes to 64MB, against the gnu-efi byte loops they replace
+ * (CopyMem(), SetMem()) and the host C library.
+ */
+
+#include "../../common/posix/string.c"
+
+#undef memcpy
+#undef memset
+#undef memcmp
+#undef memchr
+#undef strlen
+#undef strstr
+#undef strcmp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define MIN_SIZE 16
+#define MAX_SIZE (64 * 1024 * 1024)
+/* Bytes moved per measurement, whatever the size */
+#define VOLUME (256ULL * 1024 * 1024)
+
+static void *copymem(void *dst, const void *src, UINTN n)
+{
+	CopyMem(dst, src, n);
+	return dst;
+}
+
+static void *setmem(void *dst, int c, UINTN n)
+{
+	SetMem(dst, n, c);
+	return dst;
+}
+
+static void *libc_memcpy(void *dst, const void *src, UINTN n)
+{
+	return memcpy(dst, src, n);
+}
+
+static void *libc_memset(void *dst, int c, UINTN n)
+{
+	return memset(dst, c, n);
+}
+
+static const struct {
+	const char *name;
+	void *(*memcpy)(void *, const void *, UINTN);
+	void *(*memset)(void *, int, UINTN);
+} variants[] = {
+	{ "gnu-efi", copymem, setmem },
+	{ "generic", memcpy_generic, memset_generic },
+	{ "sse2", memcpy_sse2, memset_sse2 },
+	{ "erms", memcpy_erms, memset_erms },
+	{ "libc", libc_memcpy, libc_memset },
+};
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* GB/s */
+static double bench(unsigned int v, BOOLEAN copy, UINT8 *dst, UINT8 *src, UINTN size)
+{
+	UINT64 i, count = VOLUME / size;
+	double start;
+
+	/* the byte loops would take minutes on the large sizes */
+	if (v == 0)
+		count = count / 16 + 1;
+
+	start = now();
+	for (i = 0; i < count; i++) {
+		if (copy)
+			variants[v].memcpy(dst, src, size);
+		else
+			variants[v].memset(dst, i, size);
+		asm volatile("" : : "r" (dst) : "memory");
+	}
+	return (double)count * size / (now() - start) / 1e9;
+}
+
+int main(void)
+{
+	UINT8 *src, *dst;
+	UINTN size;
+	unsigned int v;
+	int copy;
+
+	src = malloc(MAX_SIZE);
+	dst = malloc(MAX_SIZE);
+	if (!src || !dst) {
+		perror("malloc");
+		return 1;
+	}
+	memset(src, 0x5A, MAX_SIZE);
+	memset(dst, 0, MAX_SIZE);
+
+	for (copy = 1; copy >= 0; copy--) {
+		printf("%s, GB/s\n%10s", copy ? "memcpy" : "memset", "size");
+		for (v = 0; v < ARRAY_SIZE(variants); v++)
+			printf("%10s", variants[v].name);
+		printf("\n");
+
+		for (size = MIN_SIZE; size <= MAX_SIZE; size *= 4) {
+			printf("%10lu", size);
+			for (v = 0; v < ARRAY_SIZE(variants); v++)
+				printf("%10.2f", bench(v, copy, dst, src, size));
+			printf("\n");
+		}
+		printf("\n");
+	}
+
+	free(src);
+	free(dst);
+	return 0;
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks every memcpy/memset/memcmp/memchr/strlen variant of
+ * common/posix/string.c against the C library: all sizes up to a few
+ * vector widths and a sample of large ones, every source and
+ * destination alignment within a cache line, and buffers ending right
+ * before an unmapped page so that any read past the end faults.
+ */
+
+#include "../../common/posix/string.c"
+
+#undef memcpy
+#undef memset
+#undef memcmp
+#undef memchr
+#undef strlen
+#undef strstr
+#undef strcmp
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+#define PAGE_SIZE 4096
+#define MAX_SIZE (256 * 1024)
+#define SLACK 128
+
+static const struct {
+	const char *name;
+	void *(*memcpy)(void *, const void *, UINTN);
+	void *(*memset)(void *, int, UINTN);
+	int (*memcmp)(const void *, const void *, UINTN);
+	void *(*memchr)(const void *, int, UINTN);
+	UINTN (*strlen)(const char *);
+} variants[] = {
+	{ "generic", memcpy_generic, memset_generic, memcmp_generic, memchr_generic, strlen_generic },
+	{ "sse2", memcpy_sse2, memset_sse2, memcmp_sse2, memchr_sse2, strlen_sse2 },
+	{ "erms", memcpy_erms, memset_erms, memcmp_sse2, memchr_sse2, strlen_sse2 },
+	{ "dispatch", posix_memcpy, posix_memset, posix_memcmp, posix_memchr, posix_strlen },
+};
+
+static UINT8 src[MAX_SIZE + SLACK], dst[MAX_SIZE + SLACK], ref[MAX_SIZE + SLACK];
+static unsigned int failures;
+
+#define fail(fmt, ...) do {						\
+		fprintf(stderr, "FAIL %s: " fmt "\n", name, __VA_ARGS__); \
+		failures++;						\
+	} while (0)
+
+static int sign(int x)
+{
+	return (x > 0) - (x < 0);
+}
+
+static void random_fill(UINT8 *buf, UINTN size)
+{
+	UINTN i;
+
+	for (i = 0; i < size; i++)
+		buf[i] = rand();
+}
+
+static void check_sizes(const char *name, int v, UINTN n, UINTN soff, UINTN doff)
+{
+	UINT8 *p, *q;
+	int c;
+
+	/* memcpy: nothing written outside [dst + doff, dst + doff + n) */
+	memset(dst, 0xA5, n + SLACK);
+	memset(ref, 0xA5, n + SLACK);
+	variants[v].memcpy(dst + doff, src + soff, n);
+	memcpy(ref + doff, src + soff, n);
+	if (memcmp(dst, ref, n + SLACK))
+		fail("memcpy size %lu src +%lu dst +%lu", n, soff, doff);
+
+	c = rand() & 0xFF;
+	variants[v].memset(dst + doff, c, n);
+	memset(ref + doff, c, n);
+	if (memcmp(dst, ref, n + SLACK))
+		fail("memset size %lu dst +%lu", n, doff);
+
+	/* memcmp: equal, then one bit flipped anywhere */
+	memcpy(dst + doff, src + soff, n);
+	if (variants[v].memcmp(dst + doff, src + soff, n))
+		fail("memcmp equal size %lu", n);
+	if (n) {
+		p = dst + doff + rand() % n;
+		*p ^= 1 << (rand() % 8);
+		if (sign(variants[v].memcmp(dst + doff, src + soff, n)) !=
+		    sign(memcmp(dst + doff, src + soff, n)))
+			fail("memcmp size %lu at %ld", n, (long)(p - dst - doff));
+	}
+
+	/* memchr: a present byte and a byte placed after the end */
+	if (n) {
+		c = src[soff + rand() % n];
+		p = variants[v].memchr(src + soff, c, n);
+		q = memchr(src + soff, c, n);
+		if (p != q)
+			fail("memchr size %lu", n);
+	}
+	memset(dst + doff, 1, n);
+	dst[doff + n] = 2;
+	if (variants[v].memchr(dst + doff, 2, n))
+		fail("memchr past the end, size %lu", n);
+
+	/* strlen */
+	memset(dst + doff, 'x', n);
+	dst[doff + n] = 0;
+	if (variants[v].strlen((char *)dst + doff) != n)
+		fail("strlen %lu", n);
+}
+
+/* Buffers ending at the end of a page followed by an unmapped page */
+static void check_page_tails(const char *name, int v, UINT8 *page)
+{
+	UINT8 *end = page + PAGE_SIZE, *s, *d;
+	UINTN n;
+
+	for (n = 0; n < 3 * 64; n++) {
+		s = end - n;
+		memset(s, 'y', n);
+		if (n && variants[v].memchr(s, 'z', n))
+			fail("memchr page tail %lu", n);
+		if (n && variants[v].memcmp(s, s, n))
+			fail("memcmp page tail %lu", n);
+
+		d = page;
+		variants[v].memcpy(d, s, n);
+		variants[v].memset(end - n, 'y', n);
+
+		if (n) {
+			s[n - 1] = 0;
+			if (variants[v].strlen((char *)s) != n - 1)
+				fail("strlen page tail %lu", n);
+		}
+	}
+}
+
+static void check_strstr(void)
+{
+	const char *name = "strstr";
+	const char *h = "abcabcabd xyz abd";
+
+	if (posix_strstr(h, "abd") != h + 6)
+		fail("%s", "abd");
+	if (posix_strstr(h, "xyz") != h + 10)
+		fail("%s", "xyz");
+	if (posix_strstr(h, "abdx"))
+		fail("%s", "abdx");
+	if (posix_strstr(h, h) != h)
+		fail("%s", "whole string");
+	if (posix_strstr("ab", "abc"))
+		fail("%s", "needle longer than haystack");
+	if (posix_strstr(h, ""))
+		fail("%s", "empty needle");
+}
+
+int main(void)
+{
+	static const UINTN large[] = { 511, 512, 513, 4095, 4096, 65537, MAX_SIZE - 64 };
+	UINT8 *map;
+	UINTN n, soff, doff, i;
+	unsigned int v;
+
+	srand(1);
+	random_fill(src, sizeof(src));
+
+	map = mmap(NULL, 2 * PAGE_SIZE, PROT_READ | PROT_WRITE,
+		   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (map == MAP_FAILED || mprotect(map + PAGE_SIZE, PAGE_SIZE, PROT_NONE)) {
+		perror("mmap");
+		return 1;
+	}
+
+	for (v = 0; v < ARRAY_SIZE(variants); v++) {
+		const char *name = variants[v].name;
+
+		for (n = 0; n <= 3 * 64; n++)
+			for (soff = 0; soff < 64; soff += n < 64 ? 1 : 7)
+				for (doff = 0; doff < 64; doff += n < 64 ? 1 : 7)
+					check_sizes(name, v, n, soff, doff);
+		for (i = 0; i < ARRAY_SIZE(large); i++)
+			for (soff = 0; soff < 64; soff += 13)
+				check_sizes(name, v, large[i], soff, 63 - soff);
+		check_page_tails(name, v, map);
+	}
+	check_strstr();
+
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2014, Intel Corporation
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *    * Redistributions of source code must retain the above copyright
+ *      notice, this list of conditions and the following disclaimer.
+ *    * Redistributions in binary form must reproduce the above copyright
+ *      notice, this list of conditions and the following disclaimer
+ *      in the documentation and/or other materials provided with the
+ *      distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Checks the TSC frequency detection and the ticks to microseconds
+ * conversion of common/time against mocked CPUID and MSR values. The
+ * sources are included so that the CPU accesses can be redirected and
+ * the static helpers reached.
+ */
+
+#include <efi.h>
+#include <efilib.h>
+#include <cpu.h>
+
+#define x86_identify_cpu mock_identify_cpu
+#define x86_cpuid_max_leaf mock_cpuid_max_leaf
+#define x86_cpuid mock_cpuid
+#define rdtsc mock_rdtsc
+#define rdmsr mock_rdmsr
+
+static enum cpu_id mock_identify_cpu(void);
+static UINT32 mock_cpuid_max_leaf(void);
+static void mock_cpuid(UINT32 leaf, UINT32 subleaf, UINT32 reg[4]);
+static UINT64 mock_rdtsc(void);
+static UINT64 mock_rdmsr(unsigned int msr);
+
+#include "../../common/time/time.c"
+#include "../../common/time/time_silvermont.c"
+
+#include <stdio.h>
+#include <string.h>
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof(*(a)))
+
+static enum cpu_id cpu;
+static UINT32 max_leaf;
+static UINT32 leaf_15[4], leaf_16[4];
+static UINT64 platform_info, fsb_freq;
+static UINT64 tsc, stall_khz;
+
+static enum cpu_id mock_identify_cpu(void)
+{
+	return cpu;
+}
+
+static UINT32 mock_cpuid_max_leaf(void)
+{
+	return max_leaf;
+}
+
+static void mock_cpuid(UINT32 leaf, UINT32 subleaf, UINT32 reg[4])
+{
+	if (leaf > max_leaf) {
+		fprintf(stderr, "CPUID leaf 0x%x above the maximum\n", leaf);
+		memset(reg, 0xAA, 4 * sizeof(*reg));
+		return;
+	}
+	memset(reg, 0, 4 * sizeof(*reg));
+	if (leaf == 0x15)
+		memcpy(reg, leaf_15, sizeof(leaf_15));
+	if (leaf == 0x16)
+		memcpy(reg, leaf_16, sizeof(leaf_16));
+}
+
+static UINT64 mock_rdtsc(void)
+{
+	return tsc;
+}
+
+static UINT64 mock_rdmsr(unsigned int msr)
+{
+	switch (msr) {
+	case MSR_PLATFORM_INFO:
+		return platform_info;
+	case MSR_FSB_FREQ:
+		return fsb_freq;
+	default:
+		fprintf(stderr, "unexpected MSR 0x%x\n", msr);
+		return 0;
+	}
+}
+
+/* The TSC runs at @stall_khz while the firmware waits */
+static EFI_STATUS mock_stall(UINTN us)
+{
+	tsc += stall_khz * us / 1000;
+	return EFI_SUCCESS;
+}
+
+static unsigned int failures;
+
+#define fail(fmt, ...) do {						\
+		fprintf(stderr, "FAIL " fmt "\n", __VA_ARGS__);		\
+		failures++;						\
+	} while (0)
+
+static void mock_reset(void)
+{
+	cpu = CPU_UNKNOWN;
+	max_leaf = 0;
+	memset(leaf_15, 0, sizeof(leaf_15));
+	memset(leaf_16, 0, sizeof(leaf_16));
+	platform_info = fsb_freq = 0;
+	tsc = 0;
+	stall_khz = 0;
+	initialized = FALSE;
+}
+
+struct cpuid_case {
+	const char *name;
+	UINT32 max_leaf;
+	UINT32 leaf_15[4];
+	UINT32 leaf_16[4];
+	UINT64 khz;
+};
+
+static const struct cpuid_case cpuid_cases[] = {
+	{ "crystal enumerated", 0x16,
+	  { 2, 125, 19200000, 0 }, { 1200, 2400, 100, 0 }, 1200000 },
+	{ "crystal enumerated, no leaf 0x16", 0x15,
+	  { 2, 125, 19200000, 0 }, { 0 }, 1200000 },
+	{ "24MHz crystal", 0x16,
+	  { 2, 176, 24000000, 0 }, { 2100, 3800, 100, 0 }, 2112000 },
+	{ "25MHz crystal, kHz truncated", 0x15,
+	  { 3, 250, 25000000, 0 }, { 0 }, 2083333 },
+	{ "crystal not enumerated", 0x16,
+	  { 2, 226, 0, 0 }, { 2700, 3500, 100, 0 }, 2700000 },
+	{ "ratio not enumerated", 0x16,
+	  { 0, 0, 24000000, 0 }, { 1600, 2600, 100, 0 }, 1600000 },
+	{ "zero denominator", 0x16,
+	  { 0, 226, 24000000, 0 }, { 1600, 2600, 100, 0 }, 1600000 },
+	{ "no frequency enumerated", 0x16,
+	  { 2, 226, 0, 0 }, { 0 }, 0 },
+	{ "leaf 0x15 only, crystal not enumerated", 0x15,
+	  { 2, 226, 0, 0 }, { 2700, 0, 0, 0 }, 0 },
+	{ "leaves above the maximum ignored", 0x14,
+	  { 2, 125, 19200000, 0 }, { 1200, 0, 0, 0 }, 0 },
+	{ "leaf 0x16 above the maximum ignored", 0x15,
+	  { 0 }, { 1200, 0, 0, 0 }, 0 },
+};
+
+static void test_cpuid_tsc_khz(void)
+{
+	const struct cpuid_case *c;
+	UINT64 khz;
+	UINTN i;
+
+	for (i = 0; i < ARRAY_SIZE(cpuid_cases); i++) {
+		c = &cpuid_cases[i];
+		khz = cpuid_tsc_khz(c->max_leaf, c->leaf_15, c->leaf_16);
+		if (khz != c->khz)
+			fail("%s: %llu kHz, expected %llu", c->name,
+			     (unsigned long long)khz, (unsigned long long)c->khz);
+	}
+}
+
+static void test_silvermont_tsc_khz(void)
+{
+	static const UINT64 bclk_khz[] = { 83333, 100000, 133333, 116666 };
+	UINT64 khz, ratio;
+	UINTN i;
+
+	for (ratio = 8; ratio <= 0x20; ratio += 4)
+		for (i = 0; i < ARRAY_SIZE(bclk_khz); i++) {
+			/* only the bus ratio and the two low FSB bits count */
+			khz = silvermont_tsc_khz(0xFFFF0000FFFF00FFULL | ratio << 8,
+						 0xFFFFFFF0 | i);
+			if (khz != bclk_khz[i] * ratio)
+				fail("Silvermont ratio %llu FSB %lu: %llu kHz",
+				     (unsigned long long)ratio, (unsigned long)i,
+				     (unsigned long long)khz);
+		}
+}
+
+static void test_detect(void)
+{
+	static const enum cpu_id atoms[] = { CPU_SILVERMONT, CPU_AIRMONT };
+	UINTN i;
+
+	mock_reset();
+	cpu = CPU_SILVERMONT;
+	max_leaf = 0x16;
+	memcpy(leaf_15, cpuid_cases[0].leaf_15, sizeof(leaf_15));
+	if (get_tsc_khz() != 1200000)
+		fail("leaf 0x15 before the MSR: %llu kHz", (unsigned long long)get_tsc_khz());
+
+	for (i = 0; i < ARRAY_SIZE(atoms); i++) {
+		mock_reset();
+		cpu = atoms[i];
+		max_leaf = 0xB;
+		platform_info = 0x10 << 8;
+		fsb_freq = 2;
+		if (get_tsc_khz() != 16 * 133333)
+			fail("CPU 0x%x: %llu kHz from the MSRs", atoms[i],
+			     (unsigned long long)get_tsc_khz());
+	}
+
+	/* neither enumerated nor known: measured against Stall() */
+	mock_reset();
+	max_leaf = 0x16;
+	leaf_15[0] = 2;
+	leaf_15[1] = 226;
+	stall_khz = 1866000;
+	tsc = 1ULL << 40;
+	if (get_tsc_khz() != stall_khz)
+		fail("calibration: %llu kHz", (unsigned long long)get_tsc_khz());
+
+	/* the time starts at the first use */
+	tsc += stall_khz;
+	if (get_current_time_us() != 1000)
+		fail("1000 us elapsed, %llu measured", (unsigned long long)get_current_time_us());
+}
+
+static void test_tsc_mult_us(void)
+{
+	static const UINT64 khz[] = { 1001, 19200, 83333, 1200000, 1333332,
+				      1866000, 2083333, 2700000, 5000000 };
+	static const UINT64 ticks[] = { 0, 1, 999, 1ULL << 31, 1ULL << 32,
+					(1ULL << 32) + 1, 1ULL << 40,
+					0x123456789ABCDEFULL, 1ULL << 63,
+					0xFFFFFFFF00000000ULL, ~0ULL };
+	UINT64 got, exact, slack, us;
+	UINT32 mult, shift;
+	UINTN i, j;
+
+	if (tsc_mult_us(0, &shift) || tsc_mult_us(1000, &shift))
+		fail("%s", "multiplier of a TSC at 1MHz or below");
+
+	for (i = 0; i < ARRAY_SIZE(khz); i++) {
+		mult = tsc_mult_us(khz[i], &shift);
+		if (mult < 0x80000000U || shift < 32 ||
+		    mult != (((unsigned __int128)1000 << shift) * 2 / khz[i] + 1) / 2)
+			fail("%llu kHz: multiplier %u shift %u",
+			     (unsigned long long)khz[i], mult, shift);
+
+		/* the rounded multiplier is off by 2^-32 at most, the
+		 * result truncated: no overflow up to the last tick */
+		for (j = 0; j < ARRAY_SIZE(ticks); j++) {
+			got = mul_shift(ticks[j], mult, shift);
+			exact = (unsigned __int128)ticks[j] * 1000 / khz[i];
+			slack = exact / (1ULL << 32) + 1;
+			if (got > exact + slack || exact > got + slack)
+				fail("%llu kHz, %llu ticks: %llu us, expected %llu",
+				     (unsigned long long)khz[i], (unsigned long long)ticks[j],
+				     (unsigned long long)got, (unsigned long long)exact);
+		}
+
+		/* within 20us after a day of uptime */
+		for (us = 1; us <= 86400ULL * 1000000; us = us * 7 + 3) {
+			got = mul_shift(us * khz[i] / 1000, mult, shift);
+			if (got + 1 + us / (1ULL << 32) < us || got > us + us / (1ULL << 32))
+				fail("%llu kHz: %llu us measured as %llu",
+				     (unsigned long long)khz[i], (unsigned long long)us,
+				     (unsigned long long)got);
+		}
+	}
+}
+
+int main(void)
+{
+	EFI_BOOT_SERVICES bs;
+
+	memset(&bs, 0, sizeof(bs));
+	bs.Stall = mock_stall;
+	BS = &bs;
+
+	test_cpuid_tsc_khz();
+	test_silvermont_tsc_khz();
+	test_detect();
+	test_tsc_mult_us();
+
+	BS = NULL;
+	printf("%s: %u failures\n", failures ? "FAIL" : "PASS", failures);
+	return failures ? 1 : 0;
+}
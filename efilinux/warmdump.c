@@ -29,6 +29,7 @@
 
 #include <efi.h>
 #include <efilib.h>
+#include <string.h>
 #include "bootlogic.h"
 #include "acpi.h"
 #include "uefi_utils.h"
@@ -172,7 +173,7 @@ static EFI_STATUS inject_file_ram(EFI_FILE_IO_INTERFACE *io, CHAR16 *filename,
 	}
 
 	// Copy to ram
-	uefi_call_wrapper(BS->CopyMem, 3, addr, buf, read_size);
+	memcpy(addr, buf, read_size);
 
 	FreePool(buf);
 
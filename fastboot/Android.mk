@@ -14,10 +14,13 @@ FASTBOOT_CFLAGS +=  -DFASTBOOT_VERSION_STRING='"$(FASTBOOT_VERSION_STRING)"'
 FASTBOOT_CFLAGS +=  -DFASTBOOT_VERSION_DATE='"$(FASTBOOT_VERSION_DATE)"'
 FASTBOOT_CFLAGS +=  -DFASTBOOT_BUILD_STRING='"$(BUILD_NUMBER) $(PRODUCT_NAME)"'
 FASTBOOT_CFLAGS +=  -DCONFIG_LOG_TAG='L"FASTBOOT"'
+ifneq ($(BOARD_FASTBOOT_DOWNLOAD_HEADROOM),)
+FASTBOOT_CFLAGS +=  -DCONFIG_DOWNLOAD_HEADROOM=$(BOARD_FASTBOOT_DOWNLOAD_HEADROOM)
+endif
 
 FASTBOOT_DEBUG_CFFLAGS := -DCONFIG_LOG_LEVEL=LEVEL_DEBUG -DCONFIG_LOG_TIMESTAMP
 
-FASTBOOT_LIBRARIES := libuefi_log libuefi_utils libuefi_profiling_stub libuefi_stack_chk libuefi_gpt libuefi_bootimg libuefi_posix libuefi_watchdog
+FASTBOOT_LIBRARIES := libuefi_log libuefi_utils libuefi_profiling_stub libuefi_stack_chk libuefi_gpt libuefi_bootimg libuefi_posix libuefi_watchdog libuefi_crc32 libuefi_lz4 libuefi_arena
 
 ################################################################################
 
@@ -26,7 +29,8 @@ include $(CLEAR_VARS)
 LOCAL_MODULE := fastboot-user
 LOCAL_MODULE_TAGS := optional
 LOCAL_MODULE_PATH := $(PRODUCT_OUT)
-LOCAL_CFLAGS += $(FASTBOOT_CFLAGS) -DCONFIG_LOG_LEVEL=LEVEL_ERROR
+LOCAL_CFLAGS += $(FASTBOOT_CFLAGS) -DCONFIG_LOG_LEVEL=LEVEL_ERROR \
+	-DCONFIG_LOG_COMPILE_LEVEL=LEVEL_ERROR
 LOCAL_SRC_FILES := $(FASTBOOT_SRC_FILES)
 LOCAL_C_INCLUDES := $(FASTBOOT_C_INCLUDES)
 LOCAL_STATIC_LIBRARIES := $(FASTBOOT_LIBRARIES)
@@ -36,13 +36,24 @@
 #include <bootimg.h>
 #include <tco_reset.h>
 #include <gpt.h>
+#include <lz4.h>
+#include <arena.h>
 
 #include "fastboot_usb.h"
 #include "flash.h"
 
 #define MAGIC_LENGTH 64
-#define MAX_DOWNLOAD_SIZE 500*1024*1024
+/* Partition labels: GPT partition names are up to 36 characters */
+#define LABEL_LENGTH (36 + 1)
+#define MAX_DOWNLOAD_SIZE 0x80000000
+/* Part of the largest free memory range left to other allocations
+ * (pool, LZ4 buffers, GPT cache, ...) when the download buffer is
+ * reserved: CONFIG_DOWNLOAD_HEADROOM bytes if set, otherwise a
+ * quarter of the range and at least DOWNLOAD_HEADROOM_MIN. */
+#define DOWNLOAD_HEADROOM_MIN (64 * 1024 * 1024)
 #define MAX_VARIABLE_LENGTH 128
+#define DIGEST_EXTENT_SIZE (1024 * 1024)
+#define DIGESTS_PER_LINE 6
 
 struct fastboot_cmd {
 	struct fastboot_cmd *next;
@@ -63,6 +74,8 @@ enum fastboot_states {
 	STATE_COMPLETE,
 	STATE_DOWNLOAD,
 	STATE_GETVAR,
+	STATE_FLASH_INFO,
+	STATE_DIGESTS,
 	STATE_ERROR,
 };
 
@@ -73,6 +86,21 @@ static char command_buffer[MAGIC_LENGTH];
 static struct fastboot_var *varlist;
 static enum fastboot_states fastboot_state = STATE_OFFLINE;
 
+static struct {
+	BOOLEAN armed;		/* next download goes straight to flash */
+	BOOLEAN active;		/* streamed download in progress */
+	BOOLEAN done;		/* streamed download waiting for its flash command */
+	char label[LABEL_LENGTH];
+	unsigned received;
+	EFI_STATUS status;
+} stream;
+
+static UINT64 digests_left;
+
+static void *download_buffer;
+static unsigned download_max;
+static unsigned download_received;
+
 void fastboot_register(const char *prefix,
 		       void (*handle) (char *arg, void **addr, unsigned *sz))
 {
@@ -178,56 +206,112 @@ void fastboot_okay(const char *fmt, ...)
 	fastboot_state = STATE_COMPLETE;
 }
 
+/* Report the progress of a multi-part sparse image before the final
+ * OKAY, which is sent once the INFO line is out. */
+static void flash_okay(void)
+{
+	UINT32 accounted, total;
+
+	if (!flash_session_progress(&accounted, &total)) {
+		fastboot_okay("");
+		return;
+	}
+
+	fastboot_info("%d/%d blocks%a", accounted, total,
+		      accounted == total ? ", image complete" : "");
+	if (fastboot_state != STATE_ERROR)
+		fastboot_state = STATE_FLASH_INFO;
+}
+
 static void cmd_flash(char *arg, void **addr, unsigned *sz)
 {
 	EFI_STATUS ret;
-	CHAR16 *label = stra_to_str((CHAR8*)arg);
-	if (!label) {
+	CHAR16 label[LABEL_LENGTH];
+
+	if (stream.done) {
+		/* data was already written while it was received */
+		stream.done = FALSE;
+		if (strcmp(arg, stream.label))
+			fastboot_fail("Data was streamed to %a", stream.label);
+		else
+			flash_okay();
+		return;
+	}
+
+	ret = stra_to_str_buf(label, ARRAY_SIZE(label), (CHAR8 *)arg);
+	if (EFI_ERROR(ret)) {
 		error(L"Failed to get label %a\n", arg);
-		fastboot_fail("Allocation error");
+		fastboot_fail("Invalid label");
 		return;
 	}
 
 	ret = flash(*addr, *sz, label);
-	FreePool(label);
 	if (EFI_ERROR(ret))
 		fastboot_fail("Flash failure: %r", ret);
 	else
-		fastboot_okay("");
+		flash_okay();
 }
 
 static void cmd_erase(char *arg, void **addr, unsigned *sz)
 {
 	EFI_STATUS ret;
-	CHAR16 *label = stra_to_str((CHAR8*)arg);
-	if (!label) {
+	CHAR16 label[LABEL_LENGTH];
+
+	ret = stra_to_str_buf(label, ARRAY_SIZE(label), (CHAR8 *)arg);
+	if (EFI_ERROR(ret)) {
 		error(L"Failed to get label %a\n", arg);
-		fastboot_fail("Allocation error");
+		fastboot_fail("Invalid label");
 		return;
 	}
 
 	ret = erase_by_label(label);
-	FreePool(label);
 	if (EFI_ERROR(ret))
 		fastboot_fail("Flash failure: %r", ret);
 	else
 		fastboot_okay("");
 }
+/* The kernel owns the disks from now on: stop the background scan
+ * and release the partition cache */
 static void boot_ok(void)
 {
+	gpt_free_cache();
 	fastboot_okay("");
 }
 
 static void cmd_boot(char *arg, void **addr, unsigned *sz)
 {
 	struct bootimg_hooks hooks;
+	void *image = *addr;
+	UINTN offset, len;
 	EFI_STATUS ret;
 
+	if (!*addr) {
+		fastboot_fail("No image downloaded");
+		return;
+	}
+
+	/* A compressed boot image is decompressed in the rest of the
+	 * download buffer */
+	if (is_lz4_frame(*addr, *sz)) {
+		offset = ALIGN_UP(*sz, EFI_PAGE_SIZE);
+		if (offset >= download_max) {
+			fastboot_fail("No room to decompress image");
+			return;
+		}
+		image = (char *)download_buffer + offset;
+		ret = lz4_decompress(*addr, *sz, image, download_max - offset, &len);
+		if (EFI_ERROR(ret)) {
+			fastboot_fail("Failed to decompress image: %r", ret);
+			return;
+		}
+		debug(L"Boot image decompressed, %d bytes\n", len);
+	}
+
 	hooks.before_exit = boot_ok;
 	hooks.watchdog = tco_start_watchdog;
 	hooks.before_jump = NULL;
 
-	ret = android_image_start_buffer(*addr, NULL, &hooks);
+	ret = android_image_start_buffer(image, NULL, &hooks);
 
 	fastboot_fail("boot failure: %r", ret);
 }
@@ -245,9 +329,13 @@ static void worker_getvar_all(struct fastboot_var *start)
 		fastboot_okay("");
 }
 
+static void publish_partsize(void);
+static BOOLEAN getvar_partition(char *name);
+
 static void cmd_getvar(char *arg, void **addr, unsigned *sz)
 {
 	if (!strcmp(arg, "all")) {
+		publish_partsize();
 		fastboot_state = STATE_GETVAR;
 		worker_getvar_all(varlist);
 	} else {
@@ -255,7 +343,7 @@ static void cmd_getvar(char *arg, void **addr, unsigned *sz)
 		value = fastboot_getvar(arg);
 		if (value) {
 			fastboot_okay("%a", value);
-		} else {
+		} else if (!getvar_partition(arg)) {
 			fastboot_okay("");
 		}
 	}
@@ -271,14 +359,169 @@ static void fastboot_read_command(void)
 	usb_read(command_buffer, sizeof(command_buffer));
 }
 
+static void cmd_oem_stream_flash(char *arg, void **addr, unsigned *sz)
+{
+	if (!*arg || strlen(arg) >= sizeof(stream.label)) {
+		fastboot_fail("Invalid partition name");
+		return;
+	}
+
+	CopyMem(stream.label, arg, strlen(arg) + 1);
+	stream.armed = TRUE;
+	stream.done = FALSE;
+	fastboot_okay("");
+}
+
+/* Extent digests are sent as INFO lines of DIGESTS_PER_LINE
+ * hexadecimal CRC32 values, in partition order, then OKAY. A line is
+ * computed each time the previous one is out. */
+static void worker_digests(void)
+{
+	static const char hex[] = "0123456789abcdef";
+	char line[MAGIC_LENGTH];
+	UINTN len = 0;
+	UINT32 crc;
+	EFI_STATUS ret;
+	int i, j;
+
+	if (!digests_left) {
+		flash_digest_end();
+		fastboot_okay("");
+		return;
+	}
+
+	for (i = 0; i < DIGESTS_PER_LINE && digests_left; i++, digests_left--) {
+		ret = flash_digest_next(&crc);
+		if (EFI_ERROR(ret)) {
+			flash_digest_end();
+			fastboot_fail("Failed to read partition: %r", ret);
+			return;
+		}
+		if (len)
+			line[len++] = ' ';
+		for (j = 28; j >= 0; j -= 4)
+			line[len++] = hex[(crc >> j) & 0xf];
+	}
+	line[len] = '\0';
+	fastboot_info("%a", line);
+}
+
+static void cmd_oem_extent_digests(char *arg, void **addr, unsigned *sz)
+{
+	UINT64 extent_size = DIGEST_EXTENT_SIZE;
+	CHAR16 label[LABEL_LENGTH];
+	char *sep;
+	EFI_STATUS ret;
+
+	for (sep = arg; *sep && *sep != ':'; sep++)
+		;
+	if (*sep) {
+		*sep = '\0';
+		extent_size = strtoul(sep + 1, NULL, 16);
+	}
+
+	ret = stra_to_str_buf(label, ARRAY_SIZE(label), (CHAR8 *)arg);
+	if (EFI_ERROR(ret)) {
+		fastboot_fail("Invalid label");
+		return;
+	}
+	ret = flash_digest_start(label, extent_size, &digests_left);
+	if (EFI_ERROR(ret)) {
+		fastboot_fail("Failed to start digests: %r", ret);
+		return;
+	}
+
+	fastboot_info("0x%lx extents of 0x%lx bytes", digests_left, extent_size);
+	if (fastboot_state != STATE_ERROR)
+		fastboot_state = STATE_DIGESTS;
+}
+
+static void cmd_oem_write_extents(char *arg, void **addr, unsigned *sz)
+{
+	CHAR16 label[LABEL_LENGTH];
+	EFI_STATUS ret;
+
+	if (!*addr) {
+		fastboot_fail("No extent list downloaded");
+		return;
+	}
+
+	ret = stra_to_str_buf(label, ARRAY_SIZE(label), (CHAR8 *)arg);
+	if (EFI_ERROR(ret)) {
+		fastboot_fail("Invalid label");
+		return;
+	}
+	ret = flash_extents(*addr, *sz, label);
+	if (EFI_ERROR(ret))
+		fastboot_fail("Failed to write extents: %r", ret);
+	else
+		fastboot_okay("");
+}
+
+static EFI_STATUS stream_download_prepare(void)
+{
+	EFI_STATUS ret;
+	CHAR16 label[LABEL_LENGTH];
+
+	stream.armed = FALSE;
+	ret = stra_to_str_buf(label, ARRAY_SIZE(label), (CHAR8 *)stream.label);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	ret = flash_stream_start(label);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	stream.received = 0;
+	stream.status = EFI_SUCCESS;
+	return EFI_SUCCESS;
+}
+
+static void stream_process_rx(void *buf, unsigned len, unsigned download_size)
+{
+	stream.received += len;
+
+	/* After a failure, the remaining data is still drained so the
+	 * host gets its answer once the transfer is complete. */
+	if (!EFI_ERROR(stream.status))
+		stream.status = flash_stream_write(buf, len);
+
+	if (stream.received < download_size)
+		return;
+
+	stream.active = FALSE;
+	fastboot_state = STATE_COMMAND;
+	if (!EFI_ERROR(stream.status))
+		stream.status = flash_stream_end();
+
+	if (EFI_ERROR(stream.status)) {
+		fastboot_fail("Flash failure: %r", stream.status);
+		return;
+	}
+	stream.done = TRUE;
+	fastboot_okay("");
+}
+
 static void cmd_download(char *arg, void **addr, unsigned *sz)
 {
 	char response[MAGIC_LENGTH];
+	BOOLEAN streamed = stream.armed;
+	EFI_STATUS ret;
 
 	*sz = strtoul(arg, NULL, 16);
 	debug(L"Receiving %d bytes\n", *sz);
 
-	if (*sz > MAX_DOWNLOAD_SIZE) {
+	if (streamed) {
+		*addr = NULL;
+		ret = stream_download_prepare();
+		if (EFI_ERROR(ret)) {
+			fastboot_fail("Failed to start streaming: %r", ret);
+			return;
+		}
+	} else if (!download_buffer) {
+		fastboot_fail("No download buffer");
+		return;
+	} else if (*sz > download_max) {
 		fastboot_fail("data too large");
 		return;
 	}
@@ -289,14 +532,13 @@ static void cmd_download(char *arg, void **addr, unsigned *sz)
 		return;
 	}
 
-	*addr = AllocatePool(*sz);
-	if (!*addr) {
-		error(L"Failed to allocate download buffer (0x%x bytes)\n", *sz);
-		fastboot_fail("Memory allocation failure");
-		return;
-	}
+	if (!streamed)
+		*addr = download_buffer;
 
-	if (usb_read(*addr, *sz)) {
+	download_received = 0;
+	stream.active = streamed;
+	if (usb_read_stream(*addr, *sz)) {
+		stream.active = FALSE;
 		error(L"Failed to receive %d bytes\n", *sz);
 		fastboot_fail("Usb receive failed");
 		return;
@@ -304,12 +546,29 @@ static void cmd_download(char *arg, void **addr, unsigned *sz)
 	fastboot_state = STATE_DOWNLOAD;
 }
 
+/* A receive buffer could not be queued again, the download cannot
+ * complete: give up on it and wait for the next command. */
+static void fastboot_rx_error(void)
+{
+	if (stream.active) {
+		stream.active = FALSE;
+		flash_stream_abort();
+	}
+	fastboot_fail("Usb receive failed");
+}
+
 static void fastboot_process_tx(void *buf, unsigned len)
 {
 	switch (fastboot_state) {
 	case STATE_GETVAR:
 		worker_getvar_all(NULL);
 		break;
+	case STATE_FLASH_INFO:
+		fastboot_okay("");
+		break;
+	case STATE_DIGESTS:
+		worker_digests();
+		break;
 	case STATE_COMPLETE:
 		fastboot_read_command();
 		break;
@@ -327,19 +586,29 @@ static void fastboot_process_rx(void *buf, unsigned len)
 
 	switch (fastboot_state) {
 	case STATE_DOWNLOAD:
+		if (stream.active) {
+			stream_process_rx(buf, len, download_size);
+			break;
+		}
+		download_received += len;
+		if (download_received < download_size)
+			break;
+
 		fastboot_state = STATE_COMMAND;
-		if (len == download_size)
+		if (download_received == download_size)
 			fastboot_okay("");
 		else {
-			fastboot_fail("Received 0x%x bytes on 0x%x\n", len, download_size);
+			fastboot_fail("Received 0x%x bytes on 0x%x\n", download_received, download_size);
 			download_size = 0;
-			FreePool(addr);
 		}
 		break;
 	case STATE_COMPLETE:
 		((char *)buf)[len] = 0;
 		debug(L"fastboot got command: %a\n", (char *)buf);
 
+		/* The previous command is done with its scratch memory */
+		arena_reset(&scratch_arena);
+
 		fastboot_state = STATE_COMMAND;
 		for (cmd = cmdlist; cmd; cmd = cmd->next) {
 			if (memcmp(buf, cmd->prefix, cmd->prefix_len))
@@ -368,46 +637,145 @@ static void fastboot_start_callback(void)
 	fastboot_read_command();
 }
 
+static UINT64 partition_size(struct gpt_partition_interface *gparti)
+{
+	return gparti->bio->Media->BlockSize * (gparti->part.ending_lba + 1 - gparti->part.starting_lba);
+}
+
+static const char *partition_type(struct gpt_partition_interface *gparti)
+{
+	return CompareGuid(&gparti->part.type, &guid_linux_data) ? "none" : "ext4";
+}
+
+#define PARTITION_SIZE_VAR "partition-size:"
+#define PARTITION_TYPE_VAR "partition-type:"
+
+/* Answer partition-size:<label> and partition-type:<label> straight
+ * from the GPT index, so that only the disks up to the one holding
+ * the partition get parsed. */
+static BOOLEAN getvar_partition(char *name)
+{
+	struct gpt_partition_interface *gparti;
+	BOOLEAN size;
+	CHAR16 label[LABEL_LENGTH];
+	EFI_STATUS ret;
+
+	size = !memcmp(name, PARTITION_SIZE_VAR, sizeof(PARTITION_SIZE_VAR) - 1);
+	if (!size && memcmp(name, PARTITION_TYPE_VAR, sizeof(PARTITION_TYPE_VAR) - 1))
+		return FALSE;
+
+	ret = stra_to_str_buf(label, ARRAY_SIZE(label),
+			      (CHAR8 *)name + sizeof(PARTITION_SIZE_VAR) - 1);
+	if (EFI_ERROR(ret))
+		return FALSE;
+
+	ret = gpt_find_partition_by_label(label, &gparti);
+	if (EFI_ERROR(ret))
+		return FALSE;
+
+	if (size)
+		fastboot_okay("0x%lX", partition_size(gparti));
+	else
+		fastboot_okay("%a", partition_type(gparti));
+	return TRUE;
+}
+
+/* Publishing the partition variables requires all the disks to be
+ * parsed, it is done on the first "getvar:all" only. */
 static void publish_partsize(void)
 {
+	static BOOLEAN published;
 	struct gpt_partition_interface *gparti;
 	UINTN part_count;
 	UINTN i;
 
-	gpt_list_partition(&gparti, &part_count);
+	if (published)
+		return;
+
+	if (EFI_ERROR(gpt_list_partition(&gparti, &part_count)))
+		return;
+	published = TRUE;
 
 	for (i = 0; i < part_count; i++) {
 		char fastboot_var[MAX_VARIABLE_LENGTH];
 		char partsize[MAX_VARIABLE_LENGTH];
-		UINT64 size;
-
-		size = gparti[i].bio->Media->BlockSize * (gparti[i].part.ending_lba + 1 - gparti[i].part.starting_lba);
 
-		if (snprintf(fastboot_var, sizeof(fastboot_var), "partition-size:%s", gparti[i].part.name) < 0)
+		if (snprintf(fastboot_var, sizeof(fastboot_var), PARTITION_SIZE_VAR "%s", gparti[i].part.name) < 0)
 			continue;
-		if (snprintf(partsize, sizeof(partsize), "0x%lX", size) < 0)
+		if (snprintf(partsize, sizeof(partsize), "0x%lX", partition_size(&gparti[i])) < 0)
 			continue;
 
 		fastboot_publish(fastboot_var, partsize);
 
-		if (snprintf(fastboot_var, sizeof(fastboot_var), "partition-type:%s", gparti[i].part.name) < 0)
+		if (snprintf(fastboot_var, sizeof(fastboot_var), PARTITION_TYPE_VAR "%s", gparti[i].part.name) < 0)
 			continue;
 
-		if (!CompareGuid(&gparti[i].part.type, &guid_linux_data))
-			fastboot_publish(fastboot_var, "ext4");
-		else
-			fastboot_publish(fastboot_var, "none");
+		fastboot_publish(fastboot_var, partition_type(&gparti[i]));
+	}
+	FreePool(gparti);
+}
+
+/* Reserve the download buffer once, at the top of the largest free
+ * memory range below 4GB, and reuse it for every transfer.
+ */
+static EFI_STATUS download_buffer_init(void)
+{
+	EFI_PHYSICAL_ADDRESS start, addr;
+	UINT64 nr_pages, size, headroom;
+	EFI_STATUS ret;
+
+	ret = largest_free_range(USB_DMA_MAX_ADDR, &start, &nr_pages);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to find memory for the download buffer: %r\n", ret);
+		return ret;
+	}
+
+	size = nr_pages << EFI_PAGE_SHIFT;
+#ifdef CONFIG_DOWNLOAD_HEADROOM
+	headroom = CONFIG_DOWNLOAD_HEADROOM;
+#else
+	headroom = size / 4;
+	if (headroom < DOWNLOAD_HEADROOM_MIN)
+		headroom = DOWNLOAD_HEADROOM_MIN;
+#endif
+	if (size <= headroom) {
+		error(L"Largest free memory range too small: 0x%lx bytes\n", size);
+		return EFI_OUT_OF_RESOURCES;
+	}
+	size -= headroom;
+	if (size > MAX_DOWNLOAD_SIZE)
+		size = MAX_DOWNLOAD_SIZE;
+
+	addr = start + (nr_pages << EFI_PAGE_SHIFT) - size;
+	ret = allocate_pages(AllocateAddress, EfiLoaderData,
+			     EFI_SIZE_TO_PAGES(size), &addr);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to allocate download buffer: %r\n", ret);
+		return ret;
 	}
+
+	download_buffer = (void *)(UINTN)addr;
+	/* keep one page for the last usb transfer rounded up to the
+	 * endpoint max packet size */
+	download_max = size - EFI_PAGE_SIZE;
+	debug(L"Download buffer 0x%lx bytes at 0x%lx\n", size, addr);
+
+	return EFI_SUCCESS;
 }
 
 int fastboot_start()
 {
 	char download_max_str[30];
 
-	if (snprintf(download_max_str, sizeof(download_max_str), "0x%lX", MAX_DOWNLOAD_SIZE))
-		warning(L"Failed to set download_max_str string\n");
-	else
-		fastboot_publish("max-download-size", download_max_str);
+	arena_init(&scratch_arena, SCRATCH_ARENA_SIZE);
+
+	if (!EFI_ERROR(download_buffer_init())) {
+		if (snprintf(download_max_str, sizeof(download_max_str), "0x%lX", (UINT64)download_max) < 0)
+			warning(L"Failed to set download_max_str string\n");
+		else
+			fastboot_publish("max-download-size", download_max_str);
+	}
+	fastboot_publish("lz4-support", "yes");
 
 	fastboot_register("reboot", cmd_reboot);
 	fastboot_register("flash:", cmd_flash);
@@ -415,9 +783,16 @@ int fastboot_start()
 	fastboot_register("download:", cmd_download);
 	fastboot_register("boot", cmd_boot);
 	fastboot_register("erase:", cmd_erase);
-	publish_partsize();
+	fastboot_register("oem stream-flash:", cmd_oem_stream_flash);
+	fastboot_register("oem extent-digests:", cmd_oem_extent_digests);
+	fastboot_register("oem write-extents:", cmd_oem_write_extents);
+
+	/* Do not hold USB enumeration on the disks, parse them in the
+	 * background and on demand. */
+	gpt_scan_background();
 
-	fastboot_usb_start(fastboot_start_callback, fastboot_process_rx, fastboot_process_tx);
+	fastboot_usb_start(fastboot_start_callback, fastboot_process_rx, fastboot_process_tx,
+			   fastboot_rx_error);
 
 	return 0;
 }
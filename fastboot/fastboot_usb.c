@@ -29,6 +29,7 @@
 
 #include <log.h>
 #include <protocol.h>
+#include <uefi_utils.h>
 #include "fastboot_usb.h"
 #include "UsbDeviceModeProtocol.h"
 
@@ -45,9 +46,22 @@
 #define PRODUCT_ID		0x0A65
 #define BCD_DEVICE		0x0100
 
+/* Bulk OUT receive ring: up to RX_RING_COUNT requests are kept queued
+ * on the OUT endpoint during a stream, so the controller always has a
+ * buffer to fill while the previous one is being processed.
+ * RX_RING_SIZE must be a multiple of USB_BULK_EP_PKT_SIZE_MAX.
+ */
+#ifndef RX_RING_COUNT
+#define RX_RING_COUNT		4
+#endif
+#ifndef RX_RING_SIZE
+#define RX_RING_SIZE		(512 * 1024)
+#endif
+
 static data_callback_t		rx_callback  = NULL;
 static data_callback_t		tx_callback  = NULL;
 static start_callback_t		start_callback = NULL;
+static error_callback_t		rx_error_callback = NULL;
 static USB_DEVICE_OBJ		gDevObj;
 static USB_DEVICE_CONFIG_OBJ	device_configs[CONFIG_COUNT];
 static USB_DEVICE_INTERFACE_OBJ gInterfaceObjs[INTERFACE_COUNT];
@@ -56,6 +70,16 @@ static USB_DEVICE_ENDPOINT_OBJ	gEndpointObjs[ENDPOINT_COUNT];
 EFI_GUID gEfiUsbDeviceModeProtocolGuid = EFI_USB_DEVICE_MODE_PROTOCOL_GUID;
 static EFI_USB_DEVICE_MODE_PROTOCOL *usb_device;
 
+static struct {
+	BOOLEAN active;
+	CHAR8 *dest;		/* caller buffer, or NULL to use the ring */
+	unsigned len;
+	unsigned posted;
+	unsigned received;
+	unsigned pending;	/* requests queued on the OUT endpoint */
+	EFI_PHYSICAL_ADDRESS ring;
+} rx_stream;
+
 /* String descriptor table indexes */
 typedef enum {
 	STR_TBL_LANG,
@@ -189,6 +213,80 @@ int usb_read(void *buf, unsigned len)
 	return EFI_ERROR(ret);
 }
 
+static int rx_stream_post(void *ring_buf)
+{
+	unsigned len = rx_stream.len - rx_stream.posted;
+	void *buf;
+
+	if (len > RX_RING_SIZE)
+		len = RX_RING_SIZE;
+	buf = rx_stream.dest ? rx_stream.dest + rx_stream.posted : ring_buf;
+	rx_stream.posted += len;
+
+	if (usb_read(buf, len))
+		return -1;
+	rx_stream.pending++;
+	return 0;
+}
+
+/* Receive @len bytes as a sequence of chunks, each one delivered to the
+ * rx callback as soon as it completes. With @buf, data is received in
+ * place at successive offsets; its size must be rounded up to the
+ * endpoint max packet size. Without @buf, chunks land in the ring
+ * buffers and are only valid for the duration of the callback.
+ */
+int usb_read_stream(void *buf, unsigned len)
+{
+	EFI_STATUS ret;
+	unsigned i;
+
+	if (!buf && !rx_stream.ring) {
+		rx_stream.ring = USB_DMA_MAX_ADDR;
+		ret = allocate_pages(AllocateMaxAddress, EfiBootServicesData,
+				     EFI_SIZE_TO_PAGES(RX_RING_COUNT * RX_RING_SIZE),
+				     &rx_stream.ring);
+		if (EFI_ERROR(ret)) {
+			error(L"Failed to allocate rx ring: %r\n", ret);
+			rx_stream.ring = 0;
+			return -1;
+		}
+	}
+
+	rx_stream.dest = buf;
+	rx_stream.len = len;
+	rx_stream.posted = 0;
+	rx_stream.received = 0;
+	rx_stream.active = TRUE;
+
+	for (i = 0; i < RX_RING_COUNT && rx_stream.posted < len; i++)
+		if (rx_stream_post((CHAR8 *)(UINTN)rx_stream.ring + i * RX_RING_SIZE)) {
+			rx_stream.active = FALSE;
+			return -1;
+		}
+
+	return 0;
+}
+
+static void rx_stream_complete(void *buf, unsigned len)
+{
+	rx_stream.pending--;
+	rx_stream.received += len;
+	if (rx_stream.received >= rx_stream.len)
+		rx_stream.active = FALSE;
+
+	if (rx_callback)
+		rx_callback(buf, len);
+
+	/* buffer is consumed, recycle it for the next chunk */
+	if (rx_stream.active && rx_stream.posted < rx_stream.len
+	    && rx_stream_post(buf)) {
+		error(L"Rx stream aborted after 0x%x bytes\n", rx_stream.received);
+		rx_stream.active = FALSE;
+		if (rx_error_callback)
+			rx_error_callback();
+	}
+}
+
 static EFIAPI EFI_STATUS setup_handler(EFI_USB_DEVICE_REQUEST *CtrlRequest, USB_DEVICE_IO_INFO *IoInfo)
 {
 
@@ -217,7 +315,13 @@ EFIAPI EFI_STATUS data_handler(EFI_USB_DEVICE_XFER_INFO *XferInfo)
 {
 	/* if we are receiving a command or data, call the processing routine */
 	if (XferInfo->EndpointDir == USB_ENDPOINT_DIR_OUT) {
-		if (rx_callback)
+		if (rx_stream.active)
+			rx_stream_complete(XferInfo->Buffer, XferInfo->Length);
+		else if (rx_stream.pending)
+			/* left over request of an aborted stream, it
+			 * completes before any later command read */
+			rx_stream.pending--;
+		else if (rx_callback)
 			rx_callback(XferInfo->Buffer, XferInfo->Length);
 	} else
 		if (tx_callback)
@@ -283,13 +387,15 @@ static int fastboot_usb_init(void)
 
 int fastboot_usb_start(start_callback_t start_cb,
 		       data_callback_t rx_cb,
-		       data_callback_t tx_cb)
+		       data_callback_t tx_cb,
+		       error_callback_t rx_error_cb)
 {
 	EFI_STATUS ret;
 
 	start_callback = start_cb;
 	rx_callback = rx_cb;
 	tx_callback = tx_cb;
+	rx_error_callback = rx_error_cb;
 
 	ret = fastboot_usb_init();
 	if (EFI_ERROR(ret))
@@ -30,13 +30,20 @@
 #ifndef _FASTBOOT_USB_H_
 #define _FASTBOOT_USB_H_
 
+/* Highest address the USB controller can reach: buffers received into
+ * must lie below 4GB */
+#define USB_DMA_MAX_ADDR 0xFFFFFFFFULL
+
 typedef void (*data_callback_t)(void *buf, unsigned len);
 typedef void (*start_callback_t)(void);
+typedef void (*error_callback_t)(void);
 
 int usb_write(void *buf, unsigned len);
 int usb_read(void *buf, unsigned len);
+int usb_read_stream(void *buf, unsigned len);
 int fastboot_usb_start(start_callback_t start_cb,
 		       data_callback_t rx_cb,
-		       data_callback_t tx_cb);
+		       data_callback_t tx_cb,
+		       error_callback_t rx_error_cb);
 
 #endif	/* _FASTBOOT_USB_H_ */
@@ -32,20 +32,400 @@
 #include <uefi_utils.h>
 #include <log.h>
 #include <gpt.h>
+#include <lz4.h>
+#include <crc32.h>
+#include <arena.h>
 #include "flash.h"
 #include "SdHostIo.h"
 #include "Mmc.h"
 #include "sparse.h"
 
-static struct gpt_partition_interface gparti;
+static struct gpt_partition_interface *gparti;
 static UINT64 cur_offset;
 
-#define part_start (gparti.part.starting_lba * gparti.bio->Media->BlockSize)
-#define part_end ((gparti.part.ending_lba + 1) * gparti.bio->Media->BlockSize)
+/* A sparse image larger than max-download-size is split by the host
+ * into several sparse images, each one covering the whole partition
+ * with DONT_CARE chunks around its own data. A session follows these
+ * parts as a single write: it keeps a bitmap of the blocks accounted
+ * for and the offset where the previous part stopped writing. Sessions
+ * are kept per partition, so that the parts of images flashed to
+ * different partitions can be interleaved.
+ *
+ * Written blocks are accounted for, and so are holes followed by data
+ * in the same part. A hole preceding the first data of a part is only
+ * accounted for from the resume offset, the beginning of it belongs to
+ * the previous parts. A trailing hole is never accounted for: it is
+ * indistinguishable from the room left for the next parts.
+ */
+#define FLASH_SESSIONS	4
+
+struct flash_session {
+	CHAR16 label[ARRAY_SIZE(gparti->part.name)];
+	BOOLEAN active;		/* a sparse image is being flashed */
+	UINT32 blk_sz;
+	UINT32 total_blks;
+	UINT32 accounted;
+	UINT32 resume;		/* block following the last data of the previous part */
+	UINT32 part_resume;
+	UINT8 *bitmap;
+	UINT64 run_start;	/* current data run, in bytes from partition start */
+	UINT64 run_end;
+	BOOLEAN run;
+	UINT64 hole_start;	/* pending hole, in bytes from partition start */
+	UINT64 hole_end;
+	BOOLEAN hole;
+	UINTN parts;
+	UINTN last_use;
+};
+
+static struct flash_session sessions[FLASH_SESSIONS];
+static struct flash_session *session;	/* of the partition being flashed */
+static UINTN session_uses;
+
+static struct {
+	BOOLEAN started;
+	BOOLEAN sparse;
+	BOOLEAN lz4;
+	UINT64 received;
+	struct sparse_parser sp;
+	struct lz4_stream lz;
+} stream;
+
+#define part_start (gparti->part.starting_lba * gparti->bio->Media->BlockSize)
+#define part_end ((gparti->part.ending_lba + 1) * gparti->bio->Media->BlockSize)
 
 #define is_inside_partition(off, sz) \
 		(off >= part_start && off + sz <= part_end)
 
+/* Write-combining staging buffer: sparse images are mostly made of
+ * small RAW chunks, which would each end up in a small, unaligned
+ * WriteDisk. Adjacent writes are gathered here and flushed in large
+ * writes ending on an erase group (or block) boundary. A gap in the
+ * data or the end of the image flushes everything.
+ */
+#ifndef STAGING_SIZE
+#define STAGING_SIZE (4 * 1024 * 1024)
+#endif
+
+static struct {
+	CHAR8 *buf;
+	UINTN size;
+	UINTN align;		/* flush boundary, in bytes */
+	UINT64 offset;		/* disk offset of buf[0] */
+	UINTN len;
+	UINTN requests;
+	UINTN writes;
+} staging;
+
+/* FILL chunks are written from a single pattern buffer, reused all
+ * over the region and only rebuilt when the pattern changes.
+ */
+#define FILL_BUFFER_SIZE (2 * 1024 * 1024)
+
+static struct {
+	VOID *buf;
+	UINT32 pattern;
+	BOOLEAN valid;
+} fill;
+
+/* eMMC parameters, read once from the EXT_CSD */
+static struct {
+	BOOLEAN valid;
+	UINTN erase_grp_size;	/* in 512 bytes sectors */
+	UINTN timeout;
+	BOOLEAN erased_zero;	/* erased blocks read as zeros */
+} mmc;
+
+/* CMD38 arguments */
+#define ERASE_ARG_ERASE		0x00000000
+#define ERASE_ARG_SECURE	0x80000000
+
+static EFI_STATUS erase_range(EFI_BLOCK_IO *bio, UINT64 start, UINT64 end, UINT32 arg);
+
+/* Erase group boundaries around block @lba, the group size is not
+ * necessarily a power of two */
+static UINT64 group_down(UINT64 lba, UINTN grp)
+{
+	return lba - lba % grp;
+}
+
+static UINT64 group_up(UINT64 lba, UINTN grp)
+{
+	return group_down(lba + grp - 1, grp);
+}
+
+static void session_account(UINT64 start, UINT64 end)
+{
+	UINT32 blk, last;
+
+	blk = start / session->blk_sz;
+	last = end / session->blk_sz;
+	if (last > session->total_blks)
+		last = session->total_blks;
+
+	for (; blk < last; blk++) {
+		if (!(blk & 7) && blk + 8 <= last && session->bitmap[blk / 8] == 0) {
+			session->bitmap[blk / 8] = 0xFF;
+			session->accounted += 8;
+			blk += 7;
+			continue;
+		}
+		if (session->bitmap[blk / 8] & (1 << (blk & 7)))
+			continue;
+		session->bitmap[blk / 8] |= 1 << (blk & 7);
+		session->accounted++;
+	}
+}
+
+/* The data run ends: following parts resume after it */
+static void session_run_end(void)
+{
+	UINT32 end = session->run_end / session->blk_sz;
+
+	session_account(session->run_start, session->run_end);
+	session->resume = max(session->resume, end);
+	session->run = FALSE;
+}
+
+/* Called once @size bytes at disk @offset are written */
+static void session_data(UINT64 offset, UINT64 size)
+{
+	UINT64 resume;
+
+	if (!session || !session->active)
+		return;
+
+	offset -= part_start;
+
+	if (session->hole) {
+		resume = (UINT64)session->part_resume * session->blk_sz;
+		session_account(max(session->hole_start, resume), session->hole_end);
+		session->hole = FALSE;
+	}
+	if (!session->run || session->run_end != offset) {
+		if (session->run)
+			session_account(session->run_start, session->run_end);
+		session->run = TRUE;
+		session->run_start = offset;
+	}
+	session->run_end = offset + size;
+}
+
+static void session_skip(UINT64 size)
+{
+	UINT64 offset = cur_offset - part_start;
+
+	if (!session || !session->active)
+		return;
+
+	if (session->run)
+		session_run_end();
+	if (!session->hole || session->hole_end != offset) {
+		session->hole = TRUE;
+		session->hole_start = offset;
+	}
+	session->hole_end = offset + size;
+}
+
+static struct flash_session *session_find(const CHAR16 *label)
+{
+	UINTN i;
+
+	for (i = 0; i < FLASH_SESSIONS; i++)
+		if (sessions[i].bitmap && !StrCmp(sessions[i].label, label))
+			return &sessions[i];
+	return NULL;
+}
+
+static void session_free(struct flash_session *s)
+{
+	if (!s)
+		return;
+
+	if (s->bitmap)
+		FreePool(s->bitmap);
+	ZeroMem(s, sizeof(*s));
+	if (s == session)
+		session = NULL;
+}
+
+/* A free session, or the least recently used one */
+static struct flash_session *session_slot(void)
+{
+	struct flash_session *lru = &sessions[0];
+	UINTN i;
+
+	for (i = 0; i < FLASH_SESSIONS; i++) {
+		if (!sessions[i].bitmap)
+			return &sessions[i];
+		if (sessions[i].last_use < lru->last_use)
+			lru = &sessions[i];
+	}
+
+	debug(L"Dropping the flashing session of %s\n", lru->label);
+	session_free(lru);
+	return lru;
+}
+
+/* The partition being flashed is written raw or erased */
+static void session_close(void)
+{
+	session_free(session);
+}
+
+EFI_STATUS flash_session_start(UINT32 blk_sz, UINT32 total_blks)
+{
+	if (!blk_sz)
+		return EFI_INVALID_PARAMETER;
+
+	if (session && session->blk_sz == blk_sz && session->total_blks == total_blks &&
+	    session->accounted < total_blks) {
+		session->parts++;
+		debug(L"Sparse part %d, resuming at block %d\n", session->parts, session->resume);
+	} else {
+		session_close();
+		session = session_slot();
+		session->bitmap = AllocateZeroPool(total_blks / 8 + 1);
+		if (!session->bitmap) {
+			session = NULL;
+			return EFI_OUT_OF_RESOURCES;
+		}
+		StrNCpy(session->label, gparti->part.name, ARRAY_SIZE(session->label) - 1);
+		session->label[ARRAY_SIZE(session->label) - 1] = 0;
+		session->blk_sz = blk_sz;
+		session->total_blks = total_blks;
+		session->parts = 1;
+	}
+
+	session->last_use = ++session_uses;
+	session->part_resume = session->resume;
+	session->run = FALSE;
+	session->hole = FALSE;
+	session->active = TRUE;
+	return EFI_SUCCESS;
+}
+
+void flash_session_end(void)
+{
+	if (!session || !session->active)
+		return;
+
+	if (session->run)
+		session_run_end();
+	session->hole = FALSE;
+	session->active = FALSE;
+
+	debug(L"Sparse part %d done, %d/%d blocks accounted for\n",
+	      session->parts, session->accounted, session->total_blks);
+}
+
+BOOLEAN flash_session_progress(UINT32 *accounted, UINT32 *total)
+{
+	if (!session)
+		return FALSE;
+
+	*accounted = session->accounted;
+	*total = session->total_blks;
+	return TRUE;
+}
+
+/* Partition lookup, along with its flashing session if any */
+static EFI_STATUS flash_open(CHAR16 *label)
+{
+	EFI_STATUS ret;
+
+	/* drop anything left over by an aborted operation */
+	staging.len = 0;
+
+	session = NULL;
+	ret = gpt_find_partition_by_label(label, &gparti);
+	if (EFI_ERROR(ret)) {
+		error(L"Failed to get partition %s, error %r\n", label, ret);
+		return ret;
+	}
+
+	session = session_find(label);
+	cur_offset = part_start;
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS staging_init(void)
+{
+	EFI_SD_HOST_IO_PROTOCOL *sdio;
+	UINTN erase_grp_size, timeout;
+	EFI_STATUS ret;
+
+	if (staging.buf)
+		return EFI_SUCCESS;
+
+	staging.align = gparti->bio->Media->BlockSize;
+	ret = LibLocateProtocol(&gEfiSdHostIoProtocolGuid, (void **)&sdio);
+	if (!EFI_ERROR(ret) && !EFI_ERROR(get_mmc_info(sdio, &erase_grp_size, &timeout)) && erase_grp_size)
+		staging.align = erase_grp_size * 512;
+
+	staging.size = STAGING_SIZE;
+	if (staging.size < 2 * staging.align)
+		staging.size = 2 * staging.align;
+	staging.size -= staging.size % staging.align;
+
+	staging.buf = AllocatePool(staging.size);
+	if (!staging.buf) {
+		error(L"Failed to allocate staging buffer\n");
+		return EFI_OUT_OF_RESOURCES;
+	}
+	debug(L"Staging buffer of %d bytes, flushed on %d bytes boundaries\n",
+	      staging.size, staging.align);
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS disk_write(UINT64 offset, UINTN size, VOID *data)
+{
+	EFI_STATUS ret;
+
+	ret = uefi_call_wrapper(gparti->dio->WriteDisk, 5, gparti->dio, gparti->media_id, offset, size, data);
+	if (EFI_ERROR(ret))
+		error(L"Failed to write bytes: %r\n", ret);
+	else
+		session_data(offset, size);
+	staging.writes++;
+	return ret;
+}
+
+/* With @partial, data after the last alignment boundary is kept in the
+ * buffer, waiting for the next writes to complete it.
+ */
+static EFI_STATUS staging_flush(BOOLEAN partial)
+{
+	UINTN len = staging.len;
+	EFI_STATUS ret;
+
+	if (partial) {
+		len -= (staging.offset + staging.len) % staging.align;
+		if (len == 0 || len > staging.len)
+			len = staging.len;
+	}
+	if (!len)
+		return EFI_SUCCESS;
+
+	ret = disk_write(staging.offset, len, staging.buf);
+	CopyMem(staging.buf, staging.buf + len, staging.len - len);
+	staging.offset += len;
+	staging.len -= len;
+	return ret;
+}
+
+static EFI_STATUS flash_complete(EFI_STATUS ret)
+{
+	EFI_STATUS flush_ret;
+
+	flush_ret = staging_flush(FALSE);
+	debug(L"%d writes coalesced into %d disk writes\n", staging.requests, staging.writes);
+	staging.requests = 0;
+	staging.writes = 0;
+
+	return EFI_ERROR(ret) ? ret : flush_ret;
+}
+
 EFI_STATUS flash_skip(UINT64 size)
 {
 	if (!is_inside_partition(cur_offset, size)) {
@@ -53,15 +433,23 @@ EFI_STATUS flash_skip(UINT64 size)
 				part_start, part_end, cur_offset, cur_offset + size);
 		return EFI_INVALID_PARAMETER;
 	}
+	if (staging.len) {
+		EFI_STATUS ret = staging_flush(FALSE);
+		if (EFI_ERROR(ret))
+			return ret;
+	}
+	session_skip(size);
 	cur_offset += size;
 	return EFI_SUCCESS;
 }
 
 EFI_STATUS flash_write(VOID *data, UINTN size)
 {
+	CHAR8 *s = data;
+	UINTN len;
 	EFI_STATUS ret;
 
-	if (!gparti.bio)
+	if (!gparti)
 		return EFI_INVALID_PARAMETER;
 
 	if (!is_inside_partition(cur_offset, size)) {
@@ -69,57 +457,325 @@ EFI_STATUS flash_write(VOID *data, UINTN size)
 				part_start, part_end, cur_offset, cur_offset + size);
 		return EFI_INVALID_PARAMETER;
 	}
-	ret = uefi_call_wrapper(gparti.dio->WriteDisk, 5, gparti.dio, gparti.bio->Media->MediaId, cur_offset, size, data);
+
+	ret = staging_init();
 	if (EFI_ERROR(ret))
-		error(L"Failed to write bytes: %r\n", ret);
+		return ret;
 
-	cur_offset += size;
+	staging.requests++;
+
+	if (staging.len && cur_offset != staging.offset + staging.len) {
+		ret = staging_flush(FALSE);
+		if (EFI_ERROR(ret))
+			return ret;
+	}
+
+	while (size) {
+		if (!staging.len && size >= staging.size) {
+			/* large aligned write, no need to gather it */
+			len = size - (cur_offset + size) % staging.align;
+			if (len > size)
+				len = size;
+			ret = disk_write(cur_offset, len, s);
+		} else {
+			if (!staging.len)
+				staging.offset = cur_offset;
+			len = staging.size - staging.len;
+			if (len > size)
+				len = size;
+			CopyMem(staging.buf + staging.len, s, len);
+			staging.len += len;
+			if (staging.len == staging.size)
+				ret = staging_flush(TRUE);
+		}
+		s += len;
+		size -= len;
+		cur_offset += len;
+		if (EFI_ERROR(ret))
+			return ret;
+	}
+	return EFI_SUCCESS;
+}
+
+static void fill_pattern(VOID *buf, UINT32 pattern, UINTN size)
+{
+	UINTN count;
+#ifdef CONFIG_X86_64
+	UINT64 value = pattern | ((UINT64)pattern << 32);
+
+	count = size / sizeof(UINT64);
+	asm volatile("rep stosq" : "+D" (buf), "+c" (count) : "a" (value) : "memory");
+#else
+	count = size / sizeof(UINT32);
+	asm volatile("rep stosl" : "+D" (buf), "+c" (count) : "a" (pattern) : "memory");
+#endif
+}
+
+/* Zeros spanning at least one erase group are cheaper to erase than to
+ * write, provided erased blocks read back as zeros. A plain erase is
+ * used: a secure erase may be much slower than writing the zeros.
+ * Returns EFI_UNSUPPORTED when the zeros have to be written instead.
+ */
+static EFI_STATUS fill_by_erase(UINT64 size)
+{
+	UINT32 bsize = gparti->bio->Media->BlockSize;
+	UINT64 start, end;
+	EFI_STATUS ret;
+
+	if (!mmc.valid || !mmc.erased_zero || bsize != 512 || !mmc.erase_grp_size)
+		return EFI_UNSUPPORTED;
+	if (cur_offset % bsize || size % bsize)
+		return EFI_UNSUPPORTED;
+
+	/* at least one whole aligned erase group */
+	start = cur_offset / bsize;
+	end = (cur_offset + size) / bsize;
+	if (group_up(start, mmc.erase_grp_size) + mmc.erase_grp_size >
+	    group_down(end, mmc.erase_grp_size))
+		return EFI_UNSUPPORTED;
+
+	ret = erase_range(gparti->bio, start, end - 1, ERASE_ARG_ERASE);
+	if (EFI_ERROR(ret)) {
+		debug(L"Erase failed, writing the zeros instead\n");
+		return EFI_UNSUPPORTED;
+	}
+	session_data(cur_offset, size);
 	return ret;
 }
 
-EFI_STATUS flash_fill(UINT32 pattern, UINTN size)
+EFI_STATUS flash_fill(UINT32 pattern, UINT64 size)
 {
-	UINT32 *buf;
-	UINTN i;
+	UINTN len;
 	EFI_STATUS ret;
 
-	buf = AllocatePool(size);
-	if (!buf)
-		return EFI_OUT_OF_RESOURCES;
+	if (!gparti)
+		return EFI_INVALID_PARAMETER;
 
-	for (i = 0; i < size / sizeof(UINTN); i++)
-		buf[i] = pattern;
+	if (!is_inside_partition(cur_offset, size)) {
+		error(L"Attempt to fill outside of partition [%ld %ld] [%ld %ld]\n",
+				part_start, part_end, cur_offset, cur_offset + size);
+		return EFI_INVALID_PARAMETER;
+	}
+
+	ret = staging_init();
+	if (EFI_ERROR(ret))
+		return ret;
+	ret = staging_flush(FALSE);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	if (!pattern) {
+		ret = fill_by_erase(size);
+		if (ret != EFI_UNSUPPORTED) {
+			cur_offset += size;
+			return ret;
+		}
+	}
+
+	if (!fill.buf) {
+		fill.buf = AllocatePool(FILL_BUFFER_SIZE);
+		if (!fill.buf)
+			return EFI_OUT_OF_RESOURCES;
+	}
+	if (!fill.valid || fill.pattern != pattern) {
+		fill_pattern(fill.buf, pattern, FILL_BUFFER_SIZE);
+		fill.pattern = pattern;
+		fill.valid = TRUE;
+	}
+
+	while (size) {
+		len = size > FILL_BUFFER_SIZE ? FILL_BUFFER_SIZE : size;
+		ret = disk_write(cur_offset, len, fill.buf);
+		if (EFI_ERROR(ret))
+			return ret;
+		cur_offset += len;
+		size -= len;
+	}
+	return EFI_SUCCESS;
+}
+
+/* Sparse parser sink writing the expanded image to the partition */
+static EFI_STATUS sink_start(VOID *ctx, struct sparse_header *sph)
+{
+	return flash_session_start(sph->blk_sz, sph->total_blks);
+}
 
-	ret = flash_write(buf, size);
-	FreePool(buf);
+static EFI_STATUS sink_write(VOID *ctx, VOID *data, UINTN size)
+{
+	return flash_write(data, size);
+}
+
+static EFI_STATUS sink_skip(VOID *ctx, UINT64 size)
+{
+	return flash_skip(size);
+}
+
+static EFI_STATUS sink_fill(VOID *ctx, UINT32 pattern, UINT64 size)
+{
+	return flash_fill(pattern, size);
+}
+
+static EFI_STATUS sink_crc(VOID *ctx, UINT32 expected, UINT32 crc)
+{
+	if (expected != crc) {
+		error(L"sparse image CRC mismatch: 0x%08x, expected 0x%08x\n", crc, expected);
+		return EFI_CRC_ERROR;
+	}
+	debug(L"sparse image CRC 0x%08x verified\n", crc);
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS sink_end(VOID *ctx)
+{
+	EFI_STATUS ret;
+
+	/* staged data is only accounted for once it is on disk */
+	ret = staging_flush(FALSE);
+	flash_session_end();
 	return ret;
 }
 
+static const struct sparse_sink flash_sink = {
+	.start = sink_start,
+	.write = sink_write,
+	.skip = sink_skip,
+	.fill = sink_fill,
+	.crc = sink_crc,
+	.end = sink_end,
+};
+
 EFI_STATUS flash(VOID *data, UINTN size, CHAR16 *label)
 {
 	EFI_STATUS ret;
 
-	ret = gpt_get_partition_by_label(label, &gparti);
-	if (EFI_ERROR(ret)) {
-		error(L"Failed to get partition %s, error %r\n", label, ret);
-		return ret;
+	/* Compressed images are decompressed on the fly through the
+	 * stream path */
+	if (is_lz4_frame(data, size)) {
+		ret = flash_stream_start(label);
+		if (EFI_ERROR(ret))
+			return ret;
+		ret = flash_stream_write(data, size);
+		if (EFI_ERROR(ret)) {
+			lz4_stream_free(&stream.lz);
+			return flash_complete(ret);
+		}
+		return flash_stream_end();
 	}
 
-	cur_offset = gparti.part.starting_lba * gparti.bio->Media->BlockSize;
+	ret = flash_open(label);
+	if (EFI_ERROR(ret))
+		return ret;
 
 	debug(L"Write %d bytes at offset 0x%x\n", size, cur_offset);
 	if (is_sparse_image(data, size))
-		return flash_sparse(data, size);
+		return flash_complete(sparse_parse(&flash_sink, NULL, data, size));
+
+	session_close();
+	return flash_complete(flash_write(data, size));
+}
+
+/* Streamed flashing: the image is handed over in pieces as it is
+ * received, so it never has to be held in memory as a whole.
+ */
+EFI_STATUS flash_stream_start(CHAR16 *label)
+{
+	EFI_STATUS ret;
+
+	ret = flash_open(label);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	lz4_stream_free(&stream.lz);
+	stream.started = FALSE;
+	stream.sparse = FALSE;
+	stream.lz4 = FALSE;
+	stream.received = 0;
+
+	debug(L"Stream to partition %s at offset 0x%lx\n", label, cur_offset);
+	return EFI_SUCCESS;
+}
+
+/* Uncompressed image data, either received or decompressed */
+static EFI_STATUS stream_output(VOID *ctx, VOID *data, UINTN size)
+{
+	if (!stream.started) {
+		stream.started = TRUE;
+		stream.sparse = is_sparse_image(data, size);
+		if (stream.sparse)
+			sparse_parser_init(&stream.sp, &flash_sink, NULL);
+		else
+			session_close();
+	}
+
+	if (stream.sparse)
+		return sparse_parser_write(&stream.sp, data, size);
 
 	return flash_write(data, size);
 }
 
+EFI_STATUS flash_stream_write(VOID *data, UINTN size)
+{
+	EFI_STATUS ret;
+
+	if (!stream.received && is_lz4_frame(data, size)) {
+		debug(L"LZ4 compressed image\n");
+		stream.lz4 = TRUE;
+		lz4_stream_init(&stream.lz, stream_output, NULL);
+	}
+	stream.received += size;
+
+	if (stream.lz4) {
+		ret = lz4_stream_write(&stream.lz, data, size);
+		if (EFI_ERROR(ret))
+			error(L"Failed to write LZ4 compressed image: %r\n", ret);
+		return ret;
+	}
+
+	return stream_output(NULL, data, size);
+}
+
+EFI_STATUS flash_stream_end(void)
+{
+	EFI_STATUS ret = EFI_SUCCESS;
+
+	debug(L"Stream done, %ld bytes received\n", stream.received);
+	if (stream.lz4) {
+		ret = lz4_stream_end(&stream.lz);
+		lz4_stream_free(&stream.lz);
+		if (EFI_ERROR(ret)) {
+			error(L"LZ4 image truncated\n");
+			return flash_complete(ret);
+		}
+	}
+
+	if (stream.sparse)
+		ret = sparse_parser_end(&stream.sp);
+
+	return flash_complete(ret);
+}
+
+/* Drop a stream which will not complete */
+void flash_stream_abort(void)
+{
+	debug(L"Stream aborted, %ld bytes received\n", stream.received);
+	lz4_stream_free(&stream.lz);
+	flash_complete(EFI_ABORTED);
+}
+
+/* The file is read and flashed piece by piece through the stream
+ * path, so neither the file nor the expanded image is ever held in
+ * memory.
+ */
+#define FILE_CHUNK_SIZE (1024 * 1024)
+
 EFI_STATUS flash_file(EFI_HANDLE image, CHAR16 *filename, CHAR16 *label)
 {
 	EFI_STATUS ret;
 	EFI_FILE_IO_INTERFACE *io = NULL;
-	VOID *buffer = NULL;
-	UINTN size = 0;
+	EFI_FILE *root, *file;
+	VOID *buffer;
+	UINTN size;
+	struct arena_mark mark = arena_save(&scratch_arena);
 
 	ret = uefi_call_wrapper(BS->HandleProtocol, 3, image, &FileSystemProtocol, (void *)&io);
 	if (EFI_ERROR(ret)) {
@@ -127,32 +783,188 @@ EFI_STATUS flash_file(EFI_HANDLE image, CHAR16 *filename, CHAR16 *label)
 		goto out;
 	}
 
-	ret = uefi_read_file(io, filename, &buffer, &size);
-	if (EFI_ERROR(ret)) {
-		error(L"Failed to read file %s: %r\n", filename, ret);
+	ret = uefi_call_wrapper(io->OpenVolume, 2, io, &root);
+	if (EFI_ERROR(ret))
 		goto out;
-	}
 
-	ret = flash(buffer, size, label);
+	ret = uefi_call_wrapper(root->Open, 5, root, &file, filename, EFI_FILE_MODE_READ, 0);
 	if (EFI_ERROR(ret)) {
-		error(L"Failed to flash file %s on partition %s: %r\n", filename, label, ret);
+		error(L"Failed to open file %s: %r\n", filename, ret);
+		goto close_root;
+	}
+
+	buffer = arena_alloc(&scratch_arena, FILE_CHUNK_SIZE);
+	if (!buffer) {
+		ret = EFI_OUT_OF_RESOURCES;
+		goto close_file;
+	}
+
+	ret = flash_stream_start(label);
+	if (EFI_ERROR(ret))
 		goto free_buffer;
+
+	for (;;) {
+		size = FILE_CHUNK_SIZE;
+		ret = uefi_call_wrapper(file->Read, 3, file, &size, buffer);
+		if (EFI_ERROR(ret)) {
+			error(L"Failed to read file %s: %r\n", filename, ret);
+			break;
+		}
+		if (!size)
+			break;
+		ret = flash_stream_write(buffer, size);
+		if (EFI_ERROR(ret))
+			break;
 	}
 
+	if (EFI_ERROR(ret))
+		flash_complete(ret);
+	else
+		ret = flash_stream_end();
+	if (EFI_ERROR(ret))
+		error(L"Failed to flash file %s on partition %s: %r\n", filename, label, ret);
+
 free_buffer:
-	FreePool(buffer);
+	arena_restore(&scratch_arena, mark);
+close_file:
+	uefi_call_wrapper(file->Close, 1, file);
+close_root:
+	uefi_call_wrapper(root->Close, 1, root);
 out:
 	return ret;
+}
+
+/* Per-extent digests of a partition, computed one extent at a time so
+ * the caller can report them as they come. The last extent is shorter
+ * when the partition size is not a multiple of the extent size. The
+ * read buffer is scratch memory of the digests command.
+ */
+#define DIGEST_READ_SIZE (1024 * 1024)
+
+static struct {
+	VOID *buf;
+	UINT64 extent_size;
+	UINT64 offset;
+} digest;
+
+void flash_digest_end(void)
+{
+	digest.buf = NULL;
+}
+
+EFI_STATUS flash_digest_start(CHAR16 *label, UINT64 extent_size, UINT64 *count)
+{
+	EFI_STATUS ret;
+
+	flash_digest_end();
+	ret = flash_open(label);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	if (!extent_size || extent_size % gparti->bio->Media->BlockSize) {
+		error(L"Invalid extent size 0x%lx\n", extent_size);
+		return EFI_INVALID_PARAMETER;
+	}
+
+	digest.buf = arena_alloc(&scratch_arena, DIGEST_READ_SIZE);
+	if (!digest.buf)
+		return EFI_OUT_OF_RESOURCES;
 
+	digest.extent_size = extent_size;
+	digest.offset = part_start;
+	*count = (part_end - part_start + extent_size - 1) / extent_size;
+	debug(L"Digests of %ld extents of 0x%lx bytes on %s\n", *count, extent_size, label);
+	return EFI_SUCCESS;
+}
+
+EFI_STATUS flash_digest_next(UINT32 *crc)
+{
+	UINT64 left;
+	UINTN len;
+	EFI_STATUS ret;
+
+	if (!digest.buf || digest.offset >= part_end)
+		return EFI_END_OF_MEDIA;
+
+	left = part_end - digest.offset;
+	if (left > digest.extent_size)
+		left = digest.extent_size;
+
+	*crc = 0;
+	while (left) {
+		len = left < DIGEST_READ_SIZE ? left : DIGEST_READ_SIZE;
+		ret = uefi_call_wrapper(gparti->dio->ReadDisk, 5, gparti->dio,
+					gparti->media_id,
+					digest.offset, len, digest.buf);
+		if (EFI_ERROR(ret)) {
+			error(L"Failed to read bytes at 0x%lx: %r\n", digest.offset, ret);
+			return ret;
+		}
+		*crc = crc32(*crc, digest.buf, len);
+		digest.offset += len;
+		left -= len;
+	}
+	return EFI_SUCCESS;
+}
+
+/* Write the extents of the list in @data, leaving the rest of the
+ * partition untouched. */
+EFI_STATUS flash_extents(VOID *data, UINTN size, CHAR16 *label)
+{
+	struct extent_list_header *hdr = data;
+	struct extent_header *ext;
+	CHAR8 *s = data, *end = s + size;
+	UINT64 pos = 0;
+	UINT32 i;
+	EFI_STATUS ret;
+
+	if (size < sizeof(*hdr) || hdr->magic != EXTENT_LIST_MAGIC) {
+		error(L"Invalid extent list\n");
+		return EFI_INVALID_PARAMETER;
+	}
+
+	ret = flash_open(label);
+	if (EFI_ERROR(ret))
+		return ret;
+	session_close();
+
+	s += sizeof(*hdr);
+	for (i = 0; i < hdr->count; i++) {
+		if ((UINTN)(end - s) < sizeof(*ext)) {
+			ret = EFI_INVALID_PARAMETER;
+			break;
+		}
+		ext = (struct extent_header *)s;
+		s += sizeof(*ext);
+		if (ext->offset < pos || ext->size > (UINT64)(end - s)) {
+			error(L"Extent %d at 0x%lx is unsorted or truncated\n", i, ext->offset);
+			ret = EFI_INVALID_PARAMETER;
+			break;
+		}
+		ret = flash_skip(ext->offset - pos);
+		if (EFI_ERROR(ret))
+			break;
+		ret = flash_write(s, ext->size);
+		if (EFI_ERROR(ret))
+			break;
+		s += ext->size;
+		pos = ext->offset + ext->size;
+	}
+
+	debug(L"%d extents written on %s\n", i, label);
+	return flash_complete(ret);
 }
 
 #define SDIO_DFLT_TIMEOUT 3000
-EFI_STATUS secure_erase(EFI_SD_HOST_IO_PROTOCOL *sdio, UINT64 start, UINT64 end, UINTN timeout)
+
+static EFI_STATUS mmc_erase(EFI_SD_HOST_IO_PROTOCOL *sdio, UINT64 start, UINT64 end,
+			    UINTN timeout, UINT32 arg)
 {
 	UINT32 status;
 	EFI_STATUS ret;
 
-	debug(L"Secure erase lba from %ld to %ld\n", start, end);
+	debug(L"%a erase lba from %ld to %ld\n", arg == ERASE_ARG_SECURE ? "Secure" : "Plain",
+	      start, end);
 
 	ret = uefi_call_wrapper(sdio->SendCommand, 9, sdio, ERASE_GROUP_START, start, NoData, NULL, 0, ResponseR1, SDIO_DFLT_TIMEOUT, &status);
 	if (EFI_ERROR(ret)) {
@@ -166,12 +978,12 @@ EFI_STATUS secure_erase(EFI_SD_HOST_IO_PROTOCOL *sdio, UINT64 start, UINT64 end,
 		return ret;
 	}
 
-	ret = uefi_call_wrapper(sdio->SendCommand, 9, sdio, ERASE, 0x80000000, NoData, NULL, 0, ResponseR1, timeout * (end - start), &status);
+	ret = uefi_call_wrapper(sdio->SendCommand, 9, sdio, ERASE, arg, NoData, NULL, 0, ResponseR1, timeout * (end - start), &status);
 	if (EFI_ERROR(ret)) {
-		error(L"Secure Erase Failed %r\n", ret);
+		error(L"Erase Failed %r\n", ret);
 		return ret;
 	}
-	debug(L"Secure erase success\n");
+	debug(L"Erase success\n");
 	return ret;
 }
 
@@ -185,9 +997,10 @@ EFI_STATUS fill_zero(EFI_BLOCK_IO *bio, UINT64 start, UINT64 end)
 	UINT64 size;
 	VOID *emptyblock;
 	EFI_STATUS ret;
+	struct arena_mark mark = arena_save(&scratch_arena);
 
 	debug(L"Filling with zeros lba %d->%d\n", start, end);
-	emptyblock = AllocateZeroPool(bio->Media->BlockSize * N_BLOCK);
+	emptyblock = arena_zalloc(&scratch_arena, bio->Media->BlockSize * N_BLOCK);
 	if (!emptyblock)
 		return EFI_OUT_OF_RESOURCES;
 
@@ -207,7 +1020,7 @@ EFI_STATUS fill_zero(EFI_BLOCK_IO *bio, UINT64 start, UINT64 end)
 	ret = EFI_SUCCESS;
 
 free_block:
-	FreePool(emptyblock);
+	arena_restore(&scratch_arena, mark);
 	return ret;
 }
 
@@ -218,11 +1031,19 @@ EFI_STATUS get_mmc_info(EFI_SD_HOST_IO_PROTOCOL *sdio, UINTN *erase_grp_size, UI
 	UINTN offset;
 	UINT32 status;
 	EFI_STATUS ret;
+	struct arena_mark mark;
+
+	if (mmc.valid) {
+		*erase_grp_size = mmc.erase_grp_size;
+		*timeout = mmc.timeout;
+		return EFI_SUCCESS;
+	}
 
 	/* ext_csd pointer must be aligned to a multiple of sdio->HostCapability.BoundarySize
 	 * allocate twice the needed size, and compute the offset to get an aligned buffer
 	 */
-	rawbuffer = AllocateZeroPool(2 * sdio->HostCapability.BoundarySize);
+	mark = arena_save(&scratch_arena);
+	rawbuffer = arena_zalloc(&scratch_arena, 2 * sdio->HostCapability.BoundarySize);
 	if (!rawbuffer)
 		return EFI_OUT_OF_RESOURCES;
 
@@ -242,20 +1063,27 @@ EFI_STATUS get_mmc_info(EFI_SD_HOST_IO_PROTOCOL *sdio, UINTN *erase_grp_size, UI
 	*erase_grp_size = 1024 * ext_csd->HC_ERASE_GRP_SIZE;
 	*timeout = 300 * ext_csd->ERASE_TIMEOUT_MULT;
 
+	mmc.erase_grp_size = *erase_grp_size;
+	mmc.timeout = *timeout;
+	mmc.erased_zero = ext_csd->ERASED_MEM_CONT == 0;
+	mmc.valid = TRUE;
+
 	debug(L"Erase grp size %d sectors, timeout %d ms\n", *erase_grp_size, *timeout);
 
 out:
-	FreePool(rawbuffer);
+	arena_restore(&scratch_arena, mark);
 	return ret;
 }
 
-EFI_STATUS erase_blocks(EFI_BLOCK_IO *bio, UINT64 start, UINT64 end)
+/* Erase the [@start, @end] blocks with the CMD38 @arg, the parts not
+ * covering whole erase groups are filled with zeros. */
+static EFI_STATUS erase_range(EFI_BLOCK_IO *bio, UINT64 start, UINT64 end, UINT32 arg)
 {
 	EFI_SD_HOST_IO_PROTOCOL *sdio;
 	EFI_STATUS ret;
 	UINTN erase_grp_size;
 	UINTN timeout;
-	UINT64 reminder;
+	UINT64 first, last;
 	UINT64 size;
 
 	/* size in MB for debug */
@@ -273,44 +1101,53 @@ EFI_STATUS erase_blocks(EFI_BLOCK_IO *bio, UINT64 start, UINT64 end)
 		debug(L"failed to get mmc parameter, fallback to filling with zeros\n");
 		goto fallback;
 	}
-	if ((end - start + 1) < erase_grp_size)
+	if (!erase_grp_size)
+		goto fallback;
+
+	/* Whole erase groups inside the range, [first, last) */
+	first = group_up(start, erase_grp_size);
+	last = group_down(end + 1, erase_grp_size);
+	if (first >= last)
 		goto fallback;
 
-	reminder = start % erase_grp_size;
-	if (reminder) {
-		ret = fill_zero(bio, start, start + erase_grp_size - reminder - 1);
+	if (start < first) {
+		ret = fill_zero(bio, start, first - 1);
 		if (EFI_ERROR(ret)) {
 			error(L"failed to fill with zeros\n");
 			return ret;
 		}
-		start += erase_grp_size - reminder;
 	}
-
-	reminder = (end + 1) % erase_grp_size;
-	if (reminder) {
-		ret = fill_zero(bio, end + 1 - reminder, end);
+	if (last <= end) {
+		ret = fill_zero(bio, last, end);
 		if (EFI_ERROR(ret)) {
 			error(L"failed to fill with zeros\n");
 			return ret;
 		}
-		end -= reminder;
 	}
-	return secure_erase(sdio, start, end, timeout);
+	start = first;
+	end = last - 1;
+	return mmc_erase(sdio, start, end, timeout, arg);
 
 fallback:
 	return fill_zero(bio, start, end);
 }
 
+EFI_STATUS erase_blocks(EFI_BLOCK_IO *bio, UINT64 start, UINT64 end)
+{
+	return erase_range(bio, start, end, ERASE_ARG_SECURE);
+}
+
 EFI_STATUS erase_by_label(CHAR16 *label)
 {
 	EFI_STATUS ret;
 
-	ret = gpt_get_partition_by_label(label, &gparti);
+	session_free(session_find(label));
+	ret = gpt_find_partition_by_label(label, &gparti);
 	if (EFI_ERROR(ret)) {
 		error(L"Failed to get partition %s, error %r\n", label, ret);
 		return ret;
 	}
-	ret = erase_blocks(gparti.bio, gparti.part.starting_lba, gparti.part.ending_lba);
+	ret = erase_blocks(gparti->bio, gparti->part.starting_lba, gparti->part.ending_lba);
 	if (EFI_ERROR(ret))
 		error(L"Failed to erase partition %s, error %r\n", label, ret);
 
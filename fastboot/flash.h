@@ -32,12 +32,48 @@
 
 #include <efi.h>
 
+/* SdHostIo.h defines the protocol GUID, it is only included by flash.c */
+struct _EFI_SD_HOST_IO_PROTOCOL;
+
+/* Extent list applied by flash_extents(): a header followed by @count
+ * extents, each one immediately followed by its @size bytes of data.
+ * Offsets are relative to the partition start, extents must be sorted
+ * and must not overlap.
+ */
+#define EXTENT_LIST_MAGIC 0x54584546	/* "FEXT" */
+
+struct extent_list_header {
+	UINT32 magic;
+	UINT32 count;
+} __attribute__((packed));
+
+struct extent_header {
+	UINT64 offset;
+	UINT64 size;
+} __attribute__((packed));
+
 EFI_STATUS flash_skip(UINT64 size);
 EFI_STATUS flash_write(VOID *data, UINTN size);
-EFI_STATUS flash_fill(UINT32 pattern, UINTN size);
+EFI_STATUS flash_fill(UINT32 pattern, UINT64 size);
+
+EFI_STATUS flash_session_start(UINT32 blk_sz, UINT32 total_blks);
+void flash_session_end(void);
+BOOLEAN flash_session_progress(UINT32 *accounted, UINT32 *total);
 
 EFI_STATUS flash(VOID *data, UINTN size, CHAR16 *label);
+EFI_STATUS flash_stream_start(CHAR16 *label);
+EFI_STATUS flash_stream_write(VOID *data, UINTN size);
+EFI_STATUS flash_stream_end(void);
+void flash_stream_abort(void);
 EFI_STATUS flash_file(EFI_HANDLE image, CHAR16 *filename, CHAR16 *label);
 EFI_STATUS erase_by_label(CHAR16 *label);
+EFI_STATUS erase_blocks(EFI_BLOCK_IO *bio, UINT64 start, UINT64 end);
+EFI_STATUS get_mmc_info(struct _EFI_SD_HOST_IO_PROTOCOL *sdio, UINTN *erase_grp_size,
+			 UINTN *timeout);
+
+EFI_STATUS flash_digest_start(CHAR16 *label, UINT64 extent_size, UINT64 *count);
+EFI_STATUS flash_digest_next(UINT32 *crc);
+void flash_digest_end(void);
+EFI_STATUS flash_extents(VOID *data, UINTN size, CHAR16 *label);
 
 #endif	/* _FLASH_H_ */
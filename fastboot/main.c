@@ -56,7 +56,7 @@ EFI_HANDLE application_handle;
 
 static EFI_STATUS find_label(UINTN argc, CHAR16 **argv)
 {
-	struct gpt_partition_interface gparti;
+	struct gpt_partition_interface *gparti;
 	EFI_STATUS ret;
 	CHAR16 *label;
 
@@ -66,7 +66,7 @@ static EFI_STATUS find_label(UINTN argc, CHAR16 **argv)
 	}
 
 	label = argv[0];
-	ret = gpt_get_partition_by_label(label, &gparti);
+	ret = gpt_find_partition_by_label(label, &gparti);
 
 	if (EFI_ERROR(ret))
 		error(L"Label %s not found, error %r\n", label, ret);
@@ -29,11 +29,12 @@
 
 #include <efi.h>
 #include <efilib.h>
+#include <string.h>
 #include <uefi_utils.h>
 #include <log.h>
+#include <crc32.h>
 
-#include "flash.h"
-#include "sparse_format.h"
+#include "sparse.h"
 
 BOOLEAN is_sparse_image(void *data, UINT64 size)
 {
@@ -62,21 +63,97 @@ BOOLEAN is_sparse_image(void *data, UINT64 size)
 	return TRUE;
 }
 
-static EFI_STATUS flash_chunk(struct sparse_header *sph, struct chunk_header *ckh, char *data, unsigned int size)
+/* Incremental sparse parser. The image can be handed over in slices
+ * of any size (USB transfers, file reads), headers and fill values
+ * split across two slices are gathered in the parser structure before
+ * being interpreted. The expanded image is described to the sink as a
+ * sequence of write, skip and fill operations.
+ */
+void sparse_parser_init(struct sparse_parser *sp, const struct sparse_sink *sink, VOID *ctx)
+{
+	ZeroMem(sp, sizeof(*sp));
+	sp->sink = sink;
+	sp->ctx = ctx;
+	sp->state = SPARSE_PARSER_FILE_HEADER;
+	sp->need = sizeof(struct sparse_header);
+}
+
+static void sparse_parser_next_chunk(struct sparse_parser *sp)
+{
+	if (sp->chunks_left == 0) {
+		sp->state = SPARSE_PARSER_DONE;
+		return;
+	}
+	sp->chunks_left--;
+	sp->state = SPARSE_PARSER_CHUNK_HEADER;
+	sp->need = sizeof(struct chunk_header);
+}
+
+static EFI_STATUS sparse_parser_file_header(struct sparse_parser *sp)
 {
+	EFI_STATUS ret;
+
+	CopyMem(&sp->sph, sp->buf, sizeof(sp->sph));
+	if (!is_sparse_image(&sp->sph, sizeof(sp->sph))) {
+		error(L"invalid sparse header\n");
+		return EFI_INVALID_PARAMETER;
+	}
+	sp->chunks_left = sp->sph.total_chunks;
+	sp->skip = sp->sph.file_hdr_sz - sizeof(struct sparse_header);
+	if (sp->sink->start) {
+		ret = sp->sink->start(sp->ctx, &sp->sph);
+		if (EFI_ERROR(ret))
+			return ret;
+	}
+	sparse_parser_next_chunk(sp);
+	return EFI_SUCCESS;
+}
+
+static EFI_STATUS sparse_parser_chunk_header(struct sparse_parser *sp)
+{
+	struct chunk_header *ckh = &sp->ckh;
+	UINT64 payload, len;
+	EFI_STATUS ret;
+
+	CopyMem(ckh, sp->buf, sizeof(*ckh));
+	if (ckh->total_sz < sp->sph.chunk_hdr_sz) {
+		error(L"sparse chunk malformated, %d, %d\n", ckh->total_sz, sp->sph.chunk_hdr_sz);
+		return EFI_INVALID_PARAMETER;
+	}
+	sp->skip = sp->sph.chunk_hdr_sz - sizeof(struct chunk_header);
+	payload = ckh->total_sz - sp->sph.chunk_hdr_sz;
+	len = (UINT64)ckh->chunk_sz * sp->sph.blk_sz;
+
 	switch (ckh->chunk_type) {
 	case CHUNK_TYPE_RAW:
-		if (size % sph->blk_sz || size != ckh->chunk_sz * sph->blk_sz) {
+		if (payload != len) {
 			error(L"inconsistent raw chunk\n");
 			return EFI_INVALID_PARAMETER;
 		}
-		return flash_write(data, size);
-	case CHUNK_TYPE_DONT_CARE:
-		return flash_skip(ckh->chunk_sz * sph->blk_sz);
+		if (!payload) {
+			sparse_parser_next_chunk(sp);
+			break;
+		}
+		sp->state = SPARSE_PARSER_RAW;
+		sp->data_left = payload;
+		break;
 	case CHUNK_TYPE_FILL:
-		return flash_fill(*((UINT32 *) data), ckh->chunk_sz * sph->blk_sz);
 	case CHUNK_TYPE_CRC32:
-		warning(L"crc chunk not implemented yet %d\n", size);
+		if (payload != sizeof(UINT32)) {
+			error(L"inconsistent chunk %04x payload size %ld\n", ckh->chunk_type, payload);
+			return EFI_INVALID_PARAMETER;
+		}
+		sp->state = SPARSE_PARSER_VALUE;
+		sp->need = sizeof(UINT32);
+		break;
+	case CHUNK_TYPE_DONT_CARE:
+		if (sp->sink->crc)
+			sp->crc = crc32_zeros(sp->crc, len);
+		ret = sp->sink->skip(sp->ctx, len);
+		if (EFI_ERROR(ret))
+			return ret;
+		sparse_parser_next_chunk(sp);
+		sp->skip += payload;
 		break;
 	default:
 		error(L"Unknow chunk type %04x\n", ckh->chunk_type);
@@ -85,37 +162,116 @@ static EFI_STATUS flash_chunk(struct sparse_header *sph, struct chunk_header *ck
 	return EFI_SUCCESS;
 }
 
-EFI_STATUS flash_sparse(void *data, UINT64 size)
+/* CRC32 chunks hold the CRC of the expanded image up to that point,
+ * DONT_CARE areas counting as zeros.
+ */
+static EFI_STATUS sparse_parser_value(struct sparse_parser *sp)
 {
-	struct sparse_header *sph;
-	char *s;
-	UINT64 rlen;
-	unsigned int i;
-	EFI_STATUS ret;
+	UINT32 value = *(UINT32 *)sp->buf;
+	UINT64 len = (UINT64)sp->ckh.chunk_sz * sp->sph.blk_sz;
+	EFI_STATUS ret = EFI_SUCCESS;
 
-	rlen = size;
-	s = data;
-	sph = data;
-	s += sph->file_hdr_sz;
+	if (sp->ckh.chunk_type == CHUNK_TYPE_FILL) {
+		if (sp->sink->crc)
+			sp->crc = crc32_fill(sp->crc, value, len);
+		ret = sp->sink->fill(sp->ctx, value, len);
+	} else if (sp->sink->crc)
+		ret = sp->sink->crc(sp->ctx, value, sp->crc);
+	if (EFI_ERROR(ret))
+		return ret;
+
+	sparse_parser_next_chunk(sp);
+	return EFI_SUCCESS;
+}
 
-	for (i = 0; i < sph->total_chunks; i++) {
-		struct chunk_header *ckh;
-		ckh = (struct chunk_header *) s;
+static EFI_STATUS sparse_parser_header_done(struct sparse_parser *sp)
+{
+	switch (sp->state) {
+	case SPARSE_PARSER_FILE_HEADER:
+		return sparse_parser_file_header(sp);
+	case SPARSE_PARSER_CHUNK_HEADER:
+		return sparse_parser_chunk_header(sp);
+	case SPARSE_PARSER_VALUE:
+		return sparse_parser_value(sp);
+	default:
+		return EFI_INVALID_PARAMETER;
+	}
+}
 
-		if (rlen < sph->chunk_hdr_sz || rlen < ckh->total_sz) {
-			error(L"sparse chunk truncated, %ld, %ld\n", rlen, size);
-			return EFI_INVALID_PARAMETER;
+EFI_STATUS sparse_parser_write(struct sparse_parser *sp, void *data, UINTN size)
+{
+	CHAR8 *s = data;
+	UINTN len;
+	EFI_STATUS ret;
+
+	while (size) {
+		if (sp->skip) {
+			len = sp->skip < size ? sp->skip : size;
+			sp->skip -= len;
+			s += len;
+			size -= len;
+			continue;
 		}
-		if (ckh->total_sz < sph->chunk_hdr_sz) {
-			error(L"sparse chunk malformated, %d, %d\n", ckh->total_sz, sph->chunk_hdr_sz);
+
+		switch (sp->state) {
+		case SPARSE_PARSER_FILE_HEADER:
+		case SPARSE_PARSER_CHUNK_HEADER:
+		case SPARSE_PARSER_VALUE:
+			len = sp->need - sp->have;
+			if (len > size)
+				len = size;
+			memcpy(sp->buf + sp->have, s, len);
+			sp->have += len;
+			s += len;
+			size -= len;
+			if (sp->have < sp->need)
+				break;
+			sp->have = 0;
+			ret = sparse_parser_header_done(sp);
+			if (EFI_ERROR(ret))
+				return ret;
+			break;
+		case SPARSE_PARSER_RAW:
+			len = sp->data_left < size ? sp->data_left : size;
+			if (sp->sink->crc)
+				sp->crc = crc32(sp->crc, s, len);
+			ret = sp->sink->write(sp->ctx, s, len);
+			if (EFI_ERROR(ret))
+				return ret;
+			sp->data_left -= len;
+			s += len;
+			size -= len;
+			if (!sp->data_left)
+				sparse_parser_next_chunk(sp);
+			break;
+		case SPARSE_PARSER_DONE:
+			error(L"%d trailing bytes after last sparse chunk\n", size);
 			return EFI_INVALID_PARAMETER;
 		}
-		ret = flash_chunk(sph, ckh, s + sph->chunk_hdr_sz, ckh->total_sz - sph->chunk_hdr_sz);
-		if (EFI_ERROR(ret))
-			return ret;
+	}
+	return EFI_SUCCESS;
+}
 
-		s += ckh->total_sz;
-		rlen -= ckh->total_sz;
+EFI_STATUS sparse_parser_end(struct sparse_parser *sp)
+{
+	if (sp->state != SPARSE_PARSER_DONE || sp->skip) {
+		error(L"sparse image truncated, %d chunks left\n", sp->chunks_left);
+		return EFI_INVALID_PARAMETER;
 	}
+	if (sp->sink->end)
+		return sp->sink->end(sp->ctx);
 	return EFI_SUCCESS;
 }
+
+/* Parse a sparse image held in a single buffer */
+EFI_STATUS sparse_parse(const struct sparse_sink *sink, VOID *ctx, void *data, UINTN size)
+{
+	struct sparse_parser sp;
+	EFI_STATUS ret;
+
+	sparse_parser_init(&sp, sink, ctx);
+	ret = sparse_parser_write(&sp, data, size);
+	if (EFI_ERROR(ret))
+		return ret;
+	return sparse_parser_end(&sp);
+}
@@ -31,8 +31,49 @@
 #define _SPARSE_H_
 
 #include <efi.h>
+#include "sparse_format.h"
 
-int is_sparse_image(void *data, UINT64 size);
-EFI_STATUS flash_sparse(void *data, UINT64 size);
+/* Operations emitted by the sparse parser, in image order. @start and
+ * @end are optional. When @crc is NULL the parser does not compute
+ * the image CRC at all and CRC32 chunks are ignored.
+ */
+struct sparse_sink {
+	EFI_STATUS (*start)(VOID *ctx, struct sparse_header *sph);
+	EFI_STATUS (*write)(VOID *ctx, VOID *data, UINTN size);
+	EFI_STATUS (*skip)(VOID *ctx, UINT64 size);
+	EFI_STATUS (*fill)(VOID *ctx, UINT32 pattern, UINT64 size);
+	EFI_STATUS (*crc)(VOID *ctx, UINT32 expected, UINT32 crc);
+	EFI_STATUS (*end)(VOID *ctx);
+};
+
+enum sparse_parser_state {
+	SPARSE_PARSER_FILE_HEADER,
+	SPARSE_PARSER_CHUNK_HEADER,
+	SPARSE_PARSER_VALUE,
+	SPARSE_PARSER_RAW,
+	SPARSE_PARSER_DONE,
+};
+
+struct sparse_parser {
+	const struct sparse_sink *sink;
+	VOID *ctx;
+	enum sparse_parser_state state;
+	struct sparse_header sph;
+	struct chunk_header ckh;
+	UINT8 buf[sizeof(struct sparse_header)];
+	UINTN need;		/* bytes to gather in buf */
+	UINTN have;		/* bytes already in buf */
+	UINT64 skip;		/* header padding or payload to ignore */
+	UINT64 data_left;	/* raw payload bytes still to write */
+	UINT32 chunks_left;
+	UINT32 crc;		/* of the expanded image so far */
+};
+
+BOOLEAN is_sparse_image(void *data, UINT64 size);
+
+void sparse_parser_init(struct sparse_parser *sp, const struct sparse_sink *sink, VOID *ctx);
+EFI_STATUS sparse_parser_write(struct sparse_parser *sp, void *data, UINTN size);
+EFI_STATUS sparse_parser_end(struct sparse_parser *sp);
+EFI_STATUS sparse_parse(const struct sparse_sink *sink, VOID *ctx, void *data, UINTN size);
 
 #endif	/* _SPARSE_H_ */